@@ -0,0 +1,452 @@
+/**
+ * @file : Archive.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_th.h>
+#include <rz_types.h>
+#include <rz_util.h>
+#include <rz_util/rz_file.h>
+#include <rz_util/rz_str.h>
+#include <rz_util/rz_time.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Archive.h>
+#include <Cache.h>
+#include <Util.h>
+
+// Bump this whenever layout of archive changes, or `CACHE_FORMAT_VERSION` is bumped,
+// because entries hold data in cache entry layout.
+#define ARCHIVE_FORMAT_VERSION 1
+
+#define ARCHIVE_MAGIC 0x4843524149414552ULL
+
+#define ARCHIVE_HEADER_SIZE      (6 * sizeof (u64))
+#define ARCHIVE_INDEX_ENTRY_SIZE (6 * sizeof (u64))
+
+typedef struct ArchiveIndexEntry {
+    u64 key;
+    u64 kind;
+    u64 id;
+    u64 offset;
+    u64 packed_length; ///< Equal to `length` if entry is stored uncompressed.
+    u64 length;
+} ArchiveIndexEntry;
+
+struct ArchiveWriter {
+    FILE              *file;
+    char              *path;
+    char              *tmp_path;
+    BinaryId           binary_id;
+    u64                offset;
+    ArchiveIndexEntry *index;
+    u64                count;
+    u64                capacity;
+    bool               failed;
+};
+
+static struct {
+    RzThreadLock *lock;
+    RzMmap       *map;
+    BinaryId      binary_id;
+    u64           count;
+    u64           index_offset;
+} archive;
+
+// Same key as response cache, but independent of API host
+static u64 archiveKey (CacheKind kind, u64 id, const char *params) {
+    u64 k = kind;
+    u64 h = HashFnv1a (HASH_FNV1A_SEED, &k, sizeof (k));
+    h     = HashFnv1a (h, &id, sizeof (id));
+    if (params) {
+        h = HashFnv1a (h, params, strlen (params));
+    }
+    return h;
+}
+
+/**************************************************************************************************/
+/***************************************** WRITER *************************************************/
+/**************************************************************************************************/
+
+static bool archiveWrite (ArchiveWriter *w, const void *data, u64 length) {
+    if (w->failed) {
+        return false;
+    }
+
+    if (length && fwrite (data, 1, length, w->file) != length) {
+        LOG_ERROR ("Failed to write to archive '%s'", w->tmp_path);
+        w->failed = true;
+        return false;
+    }
+
+    w->offset += length;
+    return true;
+}
+
+ArchiveWriter *ArchiveWriterOpen (const char *path, BinaryId binary_id) {
+    if (!path || !binary_id) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    ArchiveWriter *w = calloc (1, sizeof (ArchiveWriter));
+    if (!w) {
+        LOG_ERROR ("Failed to allocate memory for archive writer");
+        return NULL;
+    }
+
+    w->binary_id = binary_id;
+    w->path      = rz_str_dup (path);
+    w->tmp_path  = rz_str_newf ("%s.tmp", path);
+    w->file      = w->tmp_path ? fopen (w->tmp_path, "wb") : NULL;
+    if (!w->file) {
+        LOG_ERROR ("Failed to create archive '%s'", path);
+        free (w->path);
+        free (w->tmp_path);
+        free (w);
+        return NULL;
+    }
+
+    // Real header is written once index is in place
+    u64 header[6] = {0};
+    archiveWrite (w, header, sizeof (header));
+    return w;
+}
+
+bool ArchiveWriterAdd (ArchiveWriter *w, CacheKind kind, u64 id, const char *params, const CacheBuffer *data) {
+    if (!w || !data || kind <= 0 || kind >= CACHE_KIND_MAX) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (w->failed || data->failed || data->cursor > data->length) {
+        w->failed = true;
+        return false;
+    }
+
+    if (w->count == w->capacity) {
+        u64                capacity = w->capacity ? w->capacity * 2 : 1024;
+        ArchiveIndexEntry *index    = realloc (w->index, capacity * sizeof (ArchiveIndexEntry));
+        if (!index) {
+            LOG_ERROR ("Failed to allocate memory for archive index");
+            w->failed = true;
+            return false;
+        }
+        w->index    = index;
+        w->capacity = capacity;
+    }
+
+    // Params are kept with data, to tell apart entries with colliding keys
+    Str         param = StrInitFromZstr (params ? params : "");
+    CacheBuffer blob  = {0};
+    CacheBufferWriteStr (&blob, &param);
+    CacheBufferWriteBytes (&blob, data->data + data->cursor, data->length - data->cursor);
+    StrDeinit (&param);
+
+    if (blob.failed || blob.length > INT32_MAX) {
+        LOG_ERROR ("Failed to prepare archive entry for ID %llu", id);
+        CacheBufferDeinit (&blob);
+        w->failed = true;
+        return false;
+    }
+
+    int consumed      = 0;
+    int packed_length = 0;
+    u8 *packed        = rz_deflate (blob.data, (int)blob.length, &consumed, &packed_length);
+
+    // Small entries don't always shrink, those are stored as is
+    bool is_packed = packed && consumed == (int)blob.length && packed_length > 0 && (u64)packed_length < blob.length;
+
+    ArchiveIndexEntry *e = &w->index[w->count];
+    e->key               = archiveKey (kind, id, params);
+    e->kind              = kind;
+    e->id                = id;
+    e->offset            = w->offset;
+    e->length            = blob.length;
+    e->packed_length     = is_packed ? (u64)packed_length : blob.length;
+
+    bool ok = is_packed ? archiveWrite (w, packed, packed_length) : archiveWrite (w, blob.data, blob.length);
+    free (packed);
+    CacheBufferDeinit (&blob);
+
+    if (ok) {
+        w->count++;
+    }
+    return ok;
+}
+
+u64 ArchiveWriterCount (ArchiveWriter *w) {
+    if (!w) {
+        LOG_FATAL ("Invalid arguments");
+    }
+    return w->count;
+}
+
+static int archiveIndexCompare (const void *a, const void *b) {
+    const ArchiveIndexEntry *x = a;
+    const ArchiveIndexEntry *y = b;
+    return x->key < y->key ? -1 : x->key > y->key;
+}
+
+static bool archiveWriterFinish (ArchiveWriter *w) {
+    qsort (w->index, w->count, sizeof (ArchiveIndexEntry), archiveIndexCompare);
+    for (u64 i = 1; i < w->count; i++) {
+        if (w->index[i - 1].key == w->index[i].key) {
+            LOG_ERROR ("Archive has two entries with same key for ID %llu", w->index[i].id);
+            return false;
+        }
+    }
+
+    // Keep index aligned, so it can be read in place from mapped memory
+    u8 padding[sizeof (u64)] = {0};
+    archiveWrite (w, padding, (sizeof (u64) - w->offset % sizeof (u64)) % sizeof (u64));
+
+    u64 index_offset = w->offset;
+    for (u64 i = 0; i < w->count; i++) {
+        ArchiveIndexEntry *e        = &w->index[i];
+        u64                entry[6] = {e->key, e->kind, e->id, e->offset, e->packed_length, e->length};
+        archiveWrite (w, entry, sizeof (entry));
+    }
+
+    u64 header[6] = {ARCHIVE_MAGIC, ARCHIVE_FORMAT_VERSION, w->binary_id, w->count, index_offset, rz_time_now()};
+    if (w->failed || fseek (w->file, 0, SEEK_SET) || fwrite (header, 1, sizeof (header), w->file) != sizeof (header)) {
+        LOG_ERROR ("Failed to write archive '%s'", w->tmp_path);
+        return false;
+    }
+
+    return true;
+}
+
+bool ArchiveWriterClose (ArchiveWriter *w, bool commit) {
+    if (!w) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    bool ok = commit && !w->failed && archiveWriterFinish (w);
+    ok      = !fclose (w->file) && ok;
+
+    if (ok) {
+        // rename() does not replace existing files on Windows
+        if (rz_file_exists (w->path)) {
+            rz_file_rm (w->path);
+        }
+        ok = !rename (w->tmp_path, w->path);
+        if (!ok) {
+            LOG_ERROR ("Failed to move archive to '%s'", w->path);
+        }
+    }
+    if (!ok) {
+        rz_file_rm (w->tmp_path);
+    }
+
+    free (w->index);
+    free (w->path);
+    free (w->tmp_path);
+    free (w);
+    return ok;
+}
+
+/**************************************************************************************************/
+/***************************************** READER *************************************************/
+/**************************************************************************************************/
+
+static u64 archiveReadU64 (const RzMmap *map, u64 offset) {
+    u64 value = 0;
+    memcpy (&value, map->buf + offset, sizeof (value));
+    return value;
+}
+
+static ArchiveIndexEntry archiveIndexAt (u64 i) {
+    u64               at = archive.index_offset + i * ARCHIVE_INDEX_ENTRY_SIZE;
+    ArchiveIndexEntry e  = {
+         .key           = archiveReadU64 (archive.map, at),
+         .kind          = archiveReadU64 (archive.map, at + 8),
+         .id            = archiveReadU64 (archive.map, at + 16),
+         .offset        = archiveReadU64 (archive.map, at + 24),
+         .packed_length = archiveReadU64 (archive.map, at + 32),
+         .length        = archiveReadU64 (archive.map, at + 40),
+    };
+    return e;
+}
+
+void ArchiveInit() {
+    if (!archive.lock) {
+        archive.lock = rz_th_lock_new (false);
+    }
+}
+
+bool ArchiveMount (const char *path) {
+    if (!path) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!archive.lock) {
+        LOG_ERROR ("Archive state is not initialized");
+        return false;
+    }
+
+    RzMmap *map = rz_file_mmap (path, RZ_PERM_R, 0, 0);
+    if (!map || !map->buf) {
+        LOG_ERROR ("Failed to map archive '%s'", path);
+        rz_file_mmap_free (map);
+        return false;
+    }
+
+    u64 magic        = map->len >= ARCHIVE_HEADER_SIZE ? archiveReadU64 (map, 0) : 0;
+    u64 version      = magic ? archiveReadU64 (map, 8) : 0;
+    u64 binary_id    = magic ? archiveReadU64 (map, 16) : 0;
+    u64 count        = magic ? archiveReadU64 (map, 24) : 0;
+    u64 index_offset = magic ? archiveReadU64 (map, 32) : 0;
+
+    // Index must lie within file, and must not be so large that it's size overflows
+    bool is_valid = magic == ARCHIVE_MAGIC && version == ARCHIVE_FORMAT_VERSION && binary_id &&
+                    index_offset >= ARCHIVE_HEADER_SIZE && index_offset <= map->len &&
+                    count <= (map->len - index_offset) / ARCHIVE_INDEX_ENTRY_SIZE;
+    if (!is_valid) {
+        LOG_ERROR (
+            "'%s' is not an archive, or was created by an incompatible plugin version (%llu)",
+            path,
+            version
+        );
+        rz_file_mmap_free (map);
+        return false;
+    }
+
+    rz_th_lock_enter (archive.lock);
+    RzMmap *old          = archive.map;
+    archive.map          = map;
+    archive.binary_id    = binary_id;
+    archive.count        = count;
+    archive.index_offset = index_offset;
+    rz_th_lock_leave (archive.lock);
+
+    rz_file_mmap_free (old);
+
+    LOG_INFO ("Mounted archive '%s' for binary ID %llu with %llu entries", path, binary_id, count);
+    return true;
+}
+
+void ArchiveUnmount() {
+    if (!archive.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (archive.lock);
+    RzMmap *old       = archive.map;
+    archive.map       = NULL;
+    archive.binary_id = 0;
+    archive.count     = 0;
+    rz_th_lock_leave (archive.lock);
+
+    rz_file_mmap_free (old);
+}
+
+BinaryId ArchiveGetBinaryId (u64 *entry_count) {
+    if (!archive.lock) {
+        return 0;
+    }
+
+    rz_th_lock_enter (archive.lock);
+    BinaryId binary_id = archive.binary_id;
+    if (entry_count) {
+        *entry_count = archive.count;
+    }
+    rz_th_lock_leave (archive.lock);
+
+    return binary_id;
+}
+
+// Must be called with archive lock held.
+static bool archiveFind (u64 key, ArchiveIndexEntry *out) {
+    u64 lo = 0;
+    u64 hi = archive.count;
+    while (lo < hi) {
+        u64               mid = lo + (hi - lo) / 2;
+        ArchiveIndexEntry e   = archiveIndexAt (mid);
+        if (e.key == key) {
+            *out = e;
+            return true;
+        }
+        if (e.key < key) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return false;
+}
+
+// Must be called with archive lock held.
+static u8 *archiveUnpack (const ArchiveIndexEntry *e) {
+    if (e->offset > archive.index_offset || e->packed_length > archive.index_offset - e->offset ||
+        e->length > INT32_MAX || e->packed_length > INT32_MAX) {
+        return NULL;
+    }
+
+    const u8 *src = archive.map->buf + e->offset;
+    if (e->packed_length == e->length) {
+        u8 *data = malloc (e->length ? e->length : 1);
+        if (data) {
+            memcpy (data, src, e->length);
+        }
+        return data;
+    }
+
+    int consumed = 0;
+    int length   = 0;
+    u8 *data     = rz_inflate (src, (int)e->packed_length, &consumed, &length);
+    if (data && (u64)length != e->length) {
+        free (data);
+        return NULL;
+    }
+    return data;
+}
+
+bool ArchiveGet (CacheKind kind, u64 id, const char *params, CacheBuffer *out) {
+    if (!out || kind <= 0 || kind >= CACHE_KIND_MAX) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    memset (out, 0, sizeof (CacheBuffer));
+    if (!archive.lock) {
+        return false;
+    }
+
+    // Entries are decompressed under the lock, so mapping can't go away meanwhile
+    rz_th_lock_enter (archive.lock);
+    ArchiveIndexEntry e    = {0};
+    bool              hit  = archive.map && archiveFind (archiveKey (kind, id, params), &e) &&
+                             e.kind == (u64)kind && e.id == id;
+    u8               *data = hit ? archiveUnpack (&e) : NULL;
+    rz_th_lock_leave (archive.lock);
+
+    if (!data) {
+        if (hit) {
+            LOG_ERROR ("Archive entry for ID %llu is corrupted", id);
+        }
+        return false;
+    }
+
+    CacheBuffer buf     = {.data = data, .length = e.length, .capacity = e.length};
+    Str         e_param = CacheBufferReadStr (&buf);
+    bool is_valid       = !buf.failed && !strcmp (e_param.data ? e_param.data : "", params ? params : "");
+    StrDeinit (&e_param);
+
+    if (!is_valid) {
+        CacheBufferDeinit (&buf);
+        return false;
+    }
+
+    *out = buf;
+    return true;
+}
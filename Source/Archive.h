@@ -0,0 +1,117 @@
+/**
+ * @file : Archive.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Packed archive of cached RevEngAI responses for one binary, for use without network.
+ * Archive holds same (kind, id, params) keyed entries as response cache, each compressed on
+ * it's own, followed by a fixed width index sorted by key. A mounted archive is memory
+ * mapped, and a lookup binary searches the index and decompresses only the entry it needs.
+ *
+ * Layout, all integers are u64 in host byte order, like in cache entries :
+ *   header  : magic, version, binary ID, entry count, index offset, creation time
+ *   entries : deflate compressed (params, data), or stored as is if that's not smaller
+ *   index   : (key, kind, id, offset, packed length, length) of each entry, sorted by key
+ * */
+
+#ifndef REAI_PLUGIN_ARCHIVE
+#define REAI_PLUGIN_ARCHIVE
+
+/* revenai */
+#include <Reai/Api.h>
+
+/* local includes */
+#include <Cache.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct ArchiveWriter ArchiveWriter;
+
+    ///
+    /// Start writing a new archive. Archive is written to a temporary file next to `path`,
+    /// and replaces `path` only when `ArchiveWriterClose` commits it.
+    ///
+    /// path[in]      : Where to create archive.
+    /// binary_id[in] : Binary all entries of archive belong to.
+    ///
+    /// SUCCESS : Archive writer, to be closed with `ArchiveWriterClose`.
+    /// FAILURE : `NULL` with log messages.
+    ///
+    ArchiveWriter* ArchiveWriterOpen (const char* path, BinaryId binary_id);
+
+    ///
+    /// Add an entry to archive. Adding the same (kind, id, params) twice is not allowed.
+    ///
+    /// kind[in]   : Type of data, same as in response cache.
+    /// id[in]     : Binary or function ID entry belongs to.
+    /// params[in] : Extra key of entry. Can be `NULL`.
+    /// data[in]   : Entry data, from it's read cursor up to it's length.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages. Writer can't be committed after this.
+    ///
+    bool ArchiveWriterAdd (ArchiveWriter* writer, CacheKind kind, u64 id, const char* params, const CacheBuffer* data);
+
+    ///
+    /// Number of entries added to archive so far.
+    ///
+    u64 ArchiveWriterCount (ArchiveWriter* writer);
+
+    ///
+    /// Finish archive and free writer.
+    ///
+    /// writer[in] : Writer to close.
+    /// commit[in] : Write index and move archive to it's path, or just discard it.
+    ///
+    /// SUCCESS : `true` if archive was committed.
+    /// FAILURE : `false` with log messages if archive was discarded.
+    ///
+    bool ArchiveWriterClose (ArchiveWriter* writer, bool commit);
+
+    ///
+    /// Create archive state. Must be called on main thread before any other archive function.
+    ///
+    void ArchiveInit();
+
+    ///
+    /// Mount an archive for offline use, replacing any mounted archive. Cache lookups that miss
+    /// are served from it from now on.
+    ///
+    /// path[in] : Archive created by `ArchiveWriterClose`.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages. Previously mounted archive stays mounted.
+    ///
+    bool ArchiveMount (const char* path);
+
+    ///
+    /// Unmount archive, if any.
+    ///
+    void ArchiveUnmount();
+
+    ///
+    /// Binary ID of mounted archive, and number of entries in it.
+    ///
+    /// entry_count[out] : Number of entries. Can be `NULL`.
+    ///
+    /// SUCCESS : Binary ID of mounted archive.
+    /// FAILURE : Zero if no archive is mounted.
+    ///
+    BinaryId ArchiveGetBinaryId (u64* entry_count);
+
+    ///
+    /// Get data of an entry from mounted archive. Behaves like `CacheGet`.
+    ///
+    /// SUCCESS : `true` on hit, `out` must be deinited by caller.
+    /// FAILURE : `false` if no archive is mounted or it has no such entry.
+    ///
+    bool ArchiveGet (CacheKind kind, u64 id, const char* params, CacheBuffer* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_ARCHIVE
@@ -0,0 +1,435 @@
+/**
+ * @file : AsmDiff.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* revengai */
+#include <Reai/Log.h>
+
+/* local includes */
+#include <AsmDiff.h>
+#include <Util.h>
+
+typedef struct AsmLine {
+    const char *text; // original text, not NUL terminated
+    u32         length;
+    u32         id; // interned normalized text
+} AsmLine;
+
+typedef struct AsmLines {
+    AsmLine *lines;
+    u32      count;
+} AsmLines;
+
+typedef struct InternSlot {
+    u64  hash;
+    u64  offset; // normalized text in arena
+    u32  length;
+    u32  id;
+    bool used;
+} InternSlot;
+
+typedef struct InternTable {
+    InternSlot *slots;
+    u64         mask;
+    char       *arena;
+    u64         arena_used;
+    u32         next_id;
+} InternTable;
+
+typedef struct LcsContext {
+    const u32 *a;
+    const u32 *b;
+    bool      *keep_a;
+    bool      *keep_b;
+    i64       *v1;
+    i64       *v2;
+} LcsContext;
+
+static bool splitLines (const Str *s, AsmLines *out) {
+    u32 count = 0;
+    for (u64 i = 0; i < s->length; i++) {
+        count += s->data[i] == '\n';
+    }
+    count++;
+
+    out->lines = calloc (count, sizeof (AsmLine));
+    out->count = 0;
+    if (!out->lines) {
+        LOG_ERROR ("Failed to allocate memory for disassembly lines");
+        return false;
+    }
+
+    u64 start = 0;
+    for (u64 i = 0; i <= s->length; i++) {
+        if (i < s->length && s->data[i] != '\n') {
+            continue;
+        }
+
+        // Text ending with a newline has no extra empty line after it
+        if (i == s->length && start == s->length) {
+            break;
+        }
+
+        u64 end = i;
+        if (end > start && s->data[end - 1] == '\r') {
+            end--;
+        }
+        out->lines[out->count++] = (AsmLine) {.text = s->data + start, .length = (u32)(end - start)};
+        start                    = i + 1;
+    }
+    return true;
+}
+
+static bool isIdentChar (char c) {
+    return isalnum ((unsigned char)c) || c == '_';
+}
+
+// Length of numbered suffix of a label like `loc_401000`, `var_10h` or `Block_3`, zero if there's none
+static u32 labelNumberLength (const char *ident, u32 length) {
+    const char *underscore = NULL;
+    for (u32 i = 0; i < length; i++) {
+        if (ident[i] == '_') {
+            underscore = ident + i;
+        }
+    }
+    if (!underscore || underscore == ident) {
+        return 0;
+    }
+
+    const char *suffix     = underscore + 1;
+    u32         suffix_len = (u32)(ident + length - suffix);
+    u32         hex_len    = suffix_len && suffix[suffix_len - 1] == 'h' ? suffix_len - 1 : suffix_len;
+    bool        has_digit  = false;
+    for (u32 i = 0; i < hex_len; i++) {
+        if (!isxdigit ((unsigned char)suffix[i])) {
+            return 0;
+        }
+        has_digit = has_digit || isdigit ((unsigned char)suffix[i]);
+    }
+    return has_digit ? suffix_len : 0;
+}
+
+// Replace numbers and numbered labels with `#` and collapse whitespace. Output is never longer than input.
+static u32 normalizeLine (const char *text, u32 length, char *out) {
+    while (length && isspace ((unsigned char)text[length - 1])) {
+        length--;
+    }
+    while (length && isspace ((unsigned char)*text)) {
+        text++;
+        length--;
+    }
+
+    // Block headers carry block ID, address range and a comment, all of which differ between binaries
+    static const char *headers[] = {"; Block ", "; Function Overview"};
+    for (size i = 0; i < sizeof (headers) / sizeof (headers[0]); i++) {
+        size header_len = strlen (headers[i]);
+        if (length >= header_len && !memcmp (text, headers[i], header_len)) {
+            memcpy (out, headers[i], header_len);
+            return (u32)header_len;
+        }
+    }
+
+    u32 n = 0;
+    for (u32 i = 0; i < length;) {
+        char c = text[i];
+
+        if (isspace ((unsigned char)c)) {
+            out[n++] = ' ';
+            while (i < length && isspace ((unsigned char)text[i])) {
+                i++;
+            }
+        } else if (isdigit ((unsigned char)c)) {
+            // Addresses, immediates and offsets, in any base
+            while (i < length && isalnum ((unsigned char)text[i])) {
+                i++;
+            }
+            out[n++] = '#';
+        } else if (isIdentChar (c)) {
+            u32 start = i;
+            while (i < length && isIdentChar (text[i])) {
+                i++;
+            }
+
+            u32 ident_len  = i - start;
+            u32 number_len = labelNumberLength (text + start, ident_len);
+            memcpy (out + n, text + start, ident_len - number_len);
+            n += ident_len - number_len;
+            if (number_len) {
+                out[n++] = '#';
+            }
+        } else {
+            out[n++] = c;
+            i++;
+        }
+    }
+    return n;
+}
+
+// Normalize a line into arena and get it's ID, keeping normalized text only when it's new
+static u32 internLine (InternTable *t, const AsmLine *line) {
+    char *normalized = t->arena + t->arena_used;
+    u32   length     = normalizeLine (line->text, line->length, normalized);
+    u64   hash       = HashFnv1a (HASH_FNV1A_SEED, normalized, length);
+
+    for (u64 i = hash & t->mask;; i = (i + 1) & t->mask) {
+        InternSlot *slot = &t->slots[i];
+        if (!slot->used) {
+            *slot = (InternSlot) {
+                .hash   = hash,
+                .offset = t->arena_used,
+                .length = length,
+                .id     = t->next_id++,
+                .used   = true,
+            };
+            t->arena_used += length;
+            return slot->id;
+        }
+        if (slot->hash == hash && slot->length == length && !memcmp (t->arena + slot->offset, normalized, length)) {
+            return slot->id;
+        }
+    }
+}
+
+// Find middle snake of shortest edit script between a[0, n) and b[0, m), Myers' linear space variant
+static bool lcsBisect (LcsContext *ctx, const u32 *a, i64 n, const u32 *b, i64 m, i64 *split_x, i64 *split_y) {
+    i64  max_d    = (n + m + 1) / 2;
+    i64  v_offset = max_d;
+    i64  v_length = 2 * max_d + 2;
+    i64 *v1       = ctx->v1;
+    i64 *v2       = ctx->v2;
+    for (i64 i = 0; i < v_length; i++) {
+        v1[i] = -1;
+        v2[i] = -1;
+    }
+    v1[v_offset + 1] = 0;
+    v2[v_offset + 1] = 0;
+
+    i64  delta   = n - m;
+    bool front   = delta % 2 != 0; // forward path meets reverse one only on odd delta
+    i64  k1start = 0, k1end = 0, k2start = 0, k2end = 0;
+
+    for (i64 d = 0; d < max_d; d++) {
+        // Walk forward path one step
+        for (i64 k1 = -d + k1start; k1 <= d - k1end; k1 += 2) {
+            i64 k1_offset = v_offset + k1;
+            i64 x1        = (k1 == -d || (k1 != d && v1[k1_offset - 1] < v1[k1_offset + 1])) ? v1[k1_offset + 1] :
+                                                                                                v1[k1_offset - 1] + 1;
+            i64 y1        = x1 - k1;
+            while (x1 < n && y1 < m && a[x1] == b[y1]) {
+                x1++;
+                y1++;
+            }
+            v1[k1_offset] = x1;
+
+            if (x1 > n) {
+                k1end += 2; // ran off right of graph
+            } else if (y1 > m) {
+                k1start += 2; // ran off bottom of graph
+            } else if (front) {
+                i64 k2_offset = v_offset + delta - k1;
+                if (k2_offset >= 0 && k2_offset < v_length && v2[k2_offset] != -1 && x1 >= n - v2[k2_offset]) {
+                    *split_x = x1;
+                    *split_y = y1;
+                    return true;
+                }
+            }
+        }
+
+        // Walk reverse path one step
+        for (i64 k2 = -d + k2start; k2 <= d - k2end; k2 += 2) {
+            i64 k2_offset = v_offset + k2;
+            i64 x2        = (k2 == -d || (k2 != d && v2[k2_offset - 1] < v2[k2_offset + 1])) ? v2[k2_offset + 1] :
+                                                                                                v2[k2_offset - 1] + 1;
+            i64 y2        = x2 - k2;
+            while (x2 < n && y2 < m && a[n - x2 - 1] == b[m - y2 - 1]) {
+                x2++;
+                y2++;
+            }
+            v2[k2_offset] = x2;
+
+            if (x2 > n) {
+                k2end += 2;
+            } else if (y2 > m) {
+                k2start += 2;
+            } else if (!front) {
+                i64 k1_offset = v_offset + delta - k2;
+                if (k1_offset >= 0 && k1_offset < v_length && v1[k1_offset] != -1) {
+                    i64 x1 = v1[k1_offset];
+                    i64 y1 = v_offset + x1 - k1_offset;
+                    if (x1 >= n - x2) {
+                        *split_x = x1;
+                        *split_y = y1;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    // Nothing in common
+    return false;
+}
+
+// Mark lines of a[a0, a0 + n) and b[b0, b0 + m) that are in their longest common subsequence
+static void lcsMark (LcsContext *ctx, i64 a0, i64 n, i64 b0, i64 m) {
+    while (n && m && ctx->a[a0] == ctx->b[b0]) {
+        ctx->keep_a[a0++] = true;
+        ctx->keep_b[b0++] = true;
+        n--;
+        m--;
+    }
+    while (n && m && ctx->a[a0 + n - 1] == ctx->b[b0 + m - 1]) {
+        ctx->keep_a[a0 + --n] = true;
+        ctx->keep_b[b0 + --m] = true;
+    }
+    if (!n || !m) {
+        return;
+    }
+
+    i64 x = 0, y = 0;
+    if (!lcsBisect (ctx, ctx->a + a0, n, ctx->b + b0, m, &x, &y)) {
+        return;
+    }
+
+    // Split must make progress, otherwise there's nothing to match
+    if ((x == 0 && y == 0) || (x == n && y == m)) {
+        return;
+    }
+    lcsMark (ctx, a0, x, b0, y);
+    lcsMark (ctx, a0 + x, n - x, b0 + y, m - y);
+}
+
+static Str lineStr (const AsmLine *line) {
+    Str s = StrInit();
+    StrAppendf (&s, "%.*s", (int)line->length, line->text);
+    return s;
+}
+
+static void asmDiffLineDeinit (DiffLine *line) {
+    switch (line->type) {
+        case DIFF_TYPE_SAM :
+            StrDeinit (&line->sam.content);
+            break;
+        case DIFF_TYPE_ADD :
+            StrDeinit (&line->add.content);
+            break;
+        case DIFF_TYPE_REM :
+            StrDeinit (&line->rem.content);
+            break;
+        case DIFF_TYPE_MOD :
+            StrDeinit (&line->mod.old_content);
+            StrDeinit (&line->mod.new_content);
+            break;
+        case DIFF_TYPE_MOV :
+            StrDeinit (&line->mov.old_content);
+            StrDeinit (&line->mov.new_content);
+            break;
+        default :
+            break;
+    }
+}
+
+DiffLines AsmDiffCompute (const Str *source, const Str *target) {
+    if (!source || !target) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    DiffLines diff = VecInitWithDeepCopy_T (&diff, NULL, asmDiffLineDeinit);
+
+    AsmLines    src = {0}, dst = {0};
+    InternTable t   = {0};
+    LcsContext  ctx = {0};
+    u32        *ids = NULL;
+
+    if (!splitLines (source, &src) || !splitLines (target, &dst)) {
+        goto cleanup;
+    }
+
+    u64 slot_count = 64;
+    while (slot_count < 2 * ((u64)src.count + dst.count)) {
+        slot_count *= 2;
+    }
+    i64 v_length = 2 * (((i64)src.count + dst.count + 1) / 2) + 2;
+
+    t.slots    = calloc (slot_count, sizeof (InternSlot));
+    t.mask     = slot_count - 1;
+    t.arena    = malloc (source->length + target->length + 1);
+    ids        = malloc (((size)src.count + dst.count) * sizeof (u32));
+    ctx.keep_a = calloc ((size)src.count + 1, sizeof (bool));
+    ctx.keep_b = calloc ((size)dst.count + 1, sizeof (bool));
+    ctx.v1     = malloc ((size)v_length * sizeof (i64));
+    ctx.v2     = malloc ((size)v_length * sizeof (i64));
+    if (!t.slots || !t.arena || !ids || !ctx.keep_a || !ctx.keep_b || !ctx.v1 || !ctx.v2) {
+        LOG_ERROR ("Failed to allocate memory for assembly diff");
+        goto cleanup;
+    }
+
+    for (u32 i = 0; i < src.count; i++) {
+        ids[i] = internLine (&t, &src.lines[i]);
+    }
+    for (u32 j = 0; j < dst.count; j++) {
+        ids[src.count + j] = internLine (&t, &dst.lines[j]);
+    }
+
+    ctx.a = ids;
+    ctx.b = ids + src.count;
+    lcsMark (&ctx, 0, src.count, 0, dst.count);
+
+    // Matched lines pair up in order, unmatched ones between them are removals and additions
+    u32 i = 0, j = 0;
+    while (i < src.count || j < dst.count) {
+        if (i < src.count && j < dst.count && ctx.keep_a[i] && ctx.keep_b[j]) {
+            const AsmLine *old_line = &src.lines[i];
+            const AsmLine *new_line = &dst.lines[j];
+            DiffLine       line     = {0};
+            if (old_line->length == new_line->length && !memcmp (old_line->text, new_line->text, old_line->length)) {
+                line.type        = DIFF_TYPE_SAM;
+                line.sam.line    = i;
+                line.sam.content = lineStr (old_line);
+            } else {
+                line.type            = DIFF_TYPE_MOD;
+                line.mod.old_line    = i;
+                line.mod.new_line    = j;
+                line.mod.old_content = lineStr (old_line);
+                line.mod.new_content = lineStr (new_line);
+            }
+            VecPushBack (&diff, line);
+            i++;
+            j++;
+            continue;
+        }
+
+        while (i < src.count && !ctx.keep_a[i]) {
+            DiffLine line    = {.type = DIFF_TYPE_REM};
+            line.rem.line    = i;
+            line.rem.content = lineStr (&src.lines[i++]);
+            VecPushBack (&diff, line);
+        }
+        while (j < dst.count && !ctx.keep_b[j]) {
+            DiffLine line    = {.type = DIFF_TYPE_ADD};
+            line.add.line    = j;
+            line.add.content = lineStr (&dst.lines[j++]);
+            VecPushBack (&diff, line);
+        }
+    }
+
+cleanup:
+    free (src.lines);
+    free (dst.lines);
+    free (t.slots);
+    free (t.arena);
+    free (ids);
+    free (ctx.keep_a);
+    free (ctx.keep_b);
+    free (ctx.v1);
+    free (ctx.v2);
+    return diff;
+}
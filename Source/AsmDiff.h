@@ -0,0 +1,43 @@
+/**
+ * @file : AsmDiff.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Diff of linear disassembly that ignores operand noise.
+ * Similar functions from different binaries differ in addresses, immediates, stack offsets
+ * and block IDs almost everywhere, which buries real changes. Here every line is normalized
+ * first, by replacing numbers and numbered labels with a placeholder, and each normalized
+ * line is interned to an integer. Lines are then matched by a longest common subsequence
+ * over those integers, and result is built from original text of lines.
+ * */
+
+#ifndef REAI_PLUGIN_ASM_DIFF
+#define REAI_PLUGIN_ASM_DIFF
+
+/* revengai */
+#include <Reai/Diff.h>
+#include <Reai/Util/Str.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Diff two linear disassemblies, matching lines that are same after normalization.
+    /// Matched lines are `DIFF_TYPE_SAM` if their text is identical, or `DIFF_TYPE_MOD` if
+    /// only operands differ. Unmatched lines are `DIFF_TYPE_REM` and `DIFF_TYPE_ADD`.
+    ///
+    /// source[in] : Source disassembly, one instruction or comment per line.
+    /// target[in] : Target disassembly.
+    ///
+    /// SUCCESS : Diff lines with original text, to be freed with `VecDeinit`.
+    /// FAILURE : Empty diff with log messages.
+    ///
+    DiffLines AsmDiffCompute (const Str* source, const Str* target);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_ASM_DIFF
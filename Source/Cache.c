@@ -0,0 +1,1140 @@
+/**
+ * @file : Cache.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_list.h>
+#include <rz_th.h>
+#include <rz_types.h>
+#include <rz_util/rz_annotated_code.h>
+#include <rz_util/rz_file.h>
+#include <rz_util/rz_str.h>
+#include <rz_util/rz_sys.h>
+#include <rz_util/rz_time.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Archive.h>
+#include <Cache.h>
+#include <Util.h>
+
+// Bump this whenever layout of entry files or of any cached data changes.
+// Entries with a different version are treated as misses and removed.
+#define CACHE_FORMAT_VERSION 2
+
+#define CACHE_ENTRY_MAGIC 0x59524e4549414552ULL
+#define CACHE_INDEX_MAGIC 0x5844494945414552ULL
+
+#define CACHE_INDEX_FILE_NAME "index"
+
+#define CACHE_HOURS_TO_US(h) ((u64)(h) * 60 * 60 * 1000 * 1000)
+
+// Entries of data that can change on RevEngAI side (function names after renames, search
+// results after new uploads) expire after a day. Others are fixed once they exist.
+static const u64 cache_max_age_us[CACHE_KIND_MAX] = {
+    [CACHE_KIND_FUNCTION_INFOS]    = CACHE_HOURS_TO_US (24),
+    [CACHE_KIND_SIMILAR_FUNCTIONS] = CACHE_HOURS_TO_US (24),
+};
+
+typedef struct CacheEntry {
+    u64  key; ///< Hash of (namespace, kind, id, params). Zero means empty slot.
+    u64  size;
+    u64  last_used;
+    bool present; ///< Used only while matching index with files on disk.
+} CacheEntry;
+
+typedef struct Cache {
+    RzThreadLock *lock;
+    char         *dir; ///< `NULL` when cache is disabled.
+    u64           ns_hash;
+    u64           max_size;
+    u64           total_size;
+    u64           clock;      ///< Logical time, incremented on every use of an entry.
+    u64           generation; ///< Incremented on every (re)init, to detect writes racing with it.
+    u64           tmp_counter;
+    CacheEntry   *slots;      ///< Open addressing table with linear probing.
+    u64           capacity;   ///< Number of slots, always a power of two.
+    u64           count;
+    bool          dirty;      ///< Index changed since it was last saved.
+} Cache;
+
+static Cache cache = {0};
+
+/**************************************************************************************************/
+/*************************************** CACHE BUFFER *********************************************/
+/**************************************************************************************************/
+
+void CacheBufferDeinit (CacheBuffer *buf) {
+    if (!buf) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    free (buf->data);
+    memset (buf, 0, sizeof (CacheBuffer));
+}
+
+void CacheBufferWriteBytes (CacheBuffer *buf, const void *data, u64 length) {
+    if (!buf || (!data && length)) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (buf->failed || !length) {
+        return;
+    }
+
+    if (buf->length + length > buf->capacity) {
+        u64 capacity = buf->capacity ? buf->capacity : 256;
+        while (capacity < buf->length + length) {
+            capacity *= 2;
+        }
+
+        u8 *data_new = realloc (buf->data, capacity);
+        if (!data_new) {
+            LOG_ERROR ("Failed to allocate memory for cache entry");
+            buf->failed = true;
+            return;
+        }
+
+        buf->data     = data_new;
+        buf->capacity = capacity;
+    }
+
+    memcpy (buf->data + buf->length, data, length);
+    buf->length += length;
+}
+
+void CacheBufferWriteU64 (CacheBuffer *buf, u64 value) {
+    CacheBufferWriteBytes (buf, &value, sizeof (value));
+}
+
+void CacheBufferWriteF64 (CacheBuffer *buf, f64 value) {
+    CacheBufferWriteBytes (buf, &value, sizeof (value));
+}
+
+void CacheBufferWriteStr (CacheBuffer *buf, const Str *str) {
+    u64 length = str ? str->length : 0;
+    CacheBufferWriteU64 (buf, length);
+    if (length) {
+        CacheBufferWriteBytes (buf, str->data, length);
+    }
+}
+
+static bool cacheBufferRead (CacheBuffer *buf, void *out, u64 length) {
+    if (buf->failed || buf->length - buf->cursor < length) {
+        buf->failed = true;
+        memset (out, 0, length);
+        return false;
+    }
+
+    memcpy (out, buf->data + buf->cursor, length);
+    buf->cursor += length;
+    return true;
+}
+
+u64 CacheBufferReadU64 (CacheBuffer *buf) {
+    if (!buf) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    u64 value;
+    cacheBufferRead (buf, &value, sizeof (value));
+    return value;
+}
+
+f64 CacheBufferReadF64 (CacheBuffer *buf) {
+    if (!buf) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    f64 value;
+    cacheBufferRead (buf, &value, sizeof (value));
+    return value;
+}
+
+Str CacheBufferReadStr (CacheBuffer *buf) {
+    if (!buf) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    Str str    = StrInit();
+    u64 length = CacheBufferReadU64 (buf);
+    if (buf->failed || buf->length - buf->cursor < length) {
+        buf->failed = true;
+        return str;
+    }
+
+    if (length) {
+        StrAppendf (&str, "%.*s", (int)length, (const char *)(buf->data + buf->cursor));
+    }
+    buf->cursor += length;
+    return str;
+}
+
+/**************************************************************************************************/
+/***************************************** INDEX **************************************************/
+/**************************************************************************************************/
+
+static RzThreadLock *cacheLock (void) {
+    // First call always comes from CacheInit on main thread
+    if (!cache.lock) {
+        cache.lock = rz_th_lock_new (false);
+    }
+    return cache.lock;
+}
+
+static u64 cacheKey (CacheKind kind, u64 id, const char *params) {
+    u64 h = cache.ns_hash;
+    u64 k = kind;
+    h     = HashFnv1a (h, &k, sizeof (k));
+    h     = HashFnv1a (h, &id, sizeof (id));
+    if (params) {
+        h = HashFnv1a (h, params, strlen (params));
+    }
+    return h ? h : 1;
+}
+
+static u64 cacheSlotOf (u64 key) {
+    // Keys already are hashes, low bits are good enough
+    return key & (cache.capacity - 1);
+}
+
+static CacheEntry *cacheFind (u64 key) {
+    if (!cache.capacity) {
+        return NULL;
+    }
+
+    for (u64 i = cacheSlotOf (key);; i = (i + 1) & (cache.capacity - 1)) {
+        if (cache.slots[i].key == key) {
+            return &cache.slots[i];
+        }
+        if (!cache.slots[i].key) {
+            return NULL;
+        }
+    }
+}
+
+static bool cacheGrow (void) {
+    u64         capacity = cache.capacity ? cache.capacity * 2 : 1024;
+    CacheEntry *slots    = calloc (capacity, sizeof (CacheEntry));
+    if (!slots) {
+        LOG_ERROR ("Failed to allocate memory for cache index");
+        return false;
+    }
+
+    CacheEntry *old_slots    = cache.slots;
+    u64         old_capacity = cache.capacity;
+    cache.slots              = slots;
+    cache.capacity           = capacity;
+
+    for (u64 i = 0; i < old_capacity; i++) {
+        if (old_slots[i].key) {
+            u64 j = cacheSlotOf (old_slots[i].key);
+            while (slots[j].key) {
+                j = (j + 1) & (capacity - 1);
+            }
+            slots[j] = old_slots[i];
+        }
+    }
+
+    free (old_slots);
+    return true;
+}
+
+static CacheEntry *cacheInsert (u64 key) {
+    CacheEntry *e = cacheFind (key);
+    if (e) {
+        return e;
+    }
+
+    // Keep load factor under 0.7
+    if ((cache.count + 1) * 10 > cache.capacity * 7 && !cacheGrow()) {
+        return NULL;
+    }
+
+    u64 i = cacheSlotOf (key);
+    while (cache.slots[i].key) {
+        i = (i + 1) & (cache.capacity - 1);
+    }
+
+    cache.slots[i] = (CacheEntry) {.key = key};
+    cache.count++;
+    return &cache.slots[i];
+}
+
+static void cacheRemove (u64 key) {
+    CacheEntry *e = cacheFind (key);
+    if (!e) {
+        return;
+    }
+
+    cache.total_size -= MIN2 (cache.total_size, e->size);
+    cache.count--;
+    cache.dirty = true;
+
+    // Backward shift deletion, so that lookups never need tombstones
+    u64 i = e - cache.slots;
+    u64 j = i;
+    while (true) {
+        cache.slots[i].key = 0;
+        while (true) {
+            j = (j + 1) & (cache.capacity - 1);
+            if (!cache.slots[j].key) {
+                return;
+            }
+
+            // Move entry at j back to i only if i lies between it's home slot and j
+            u64 home = cacheSlotOf (cache.slots[j].key);
+            if (i <= j ? (i < home && home <= j) : (i < home || home <= j)) {
+                continue;
+            }
+            break;
+        }
+        cache.slots[i] = cache.slots[j];
+        i              = j;
+    }
+}
+
+static char *cacheEntryPath (u64 key) {
+    return rz_str_newf ("%s" RZ_SYS_DIR "%016llx.%u", cache.dir, key, CACHE_FORMAT_VERSION);
+}
+
+static char *cacheTmpPath (u64 key) {
+    return rz_str_newf ("%s" RZ_SYS_DIR "%016llx.tmp%llu", cache.dir, key, ++cache.tmp_counter);
+}
+
+static bool cacheReplaceFile (const char *from, const char *to) {
+    // rename() does not replace existing files on Windows
+    if (rz_file_exists (to)) {
+        rz_file_rm (to);
+    }
+    return !rename (from, to);
+}
+
+static int cacheEntryCompareLastUsed (const void *a, const void *b) {
+    const CacheEntry *x = a;
+    const CacheEntry *y = b;
+    return x->last_used < y->last_used ? -1 : x->last_used > y->last_used;
+}
+
+// Must be called with cache lock held.
+static void cacheEvict (void) {
+    if (cache.total_size <= cache.max_size) {
+        return;
+    }
+
+    CacheEntry *entries = malloc (cache.count * sizeof (CacheEntry));
+    if (!entries) {
+        LOG_ERROR ("Failed to allocate memory for cache eviction");
+        return;
+    }
+
+    u64 n = 0;
+    for (u64 i = 0; i < cache.capacity; i++) {
+        if (cache.slots[i].key) {
+            entries[n++] = cache.slots[i];
+        }
+    }
+    qsort (entries, n, sizeof (CacheEntry), cacheEntryCompareLastUsed);
+
+    // Evict a little more than required, so that eviction does not run on every put
+    u64 target  = cache.max_size / 10 * 9;
+    u64 evicted = 0;
+    for (u64 i = 0; i < n && cache.total_size > target; i++) {
+        char *path = cacheEntryPath (entries[i].key);
+        if (path) {
+            rz_file_rm (path);
+            free (path);
+        }
+        cacheRemove (entries[i].key);
+        evicted++;
+    }
+    free (entries);
+
+    LOG_INFO ("Evicted %llu least recently used cache entries", evicted);
+}
+
+// Must be called with cache lock held.
+static void cacheSaveIndex (void) {
+    if (!cache.dir || !cache.dirty) {
+        return;
+    }
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteU64 (&buf, CACHE_INDEX_MAGIC);
+    CacheBufferWriteU64 (&buf, CACHE_FORMAT_VERSION);
+    CacheBufferWriteU64 (&buf, cache.count);
+    CacheBufferWriteU64 (&buf, cache.clock);
+    for (u64 i = 0; i < cache.capacity; i++) {
+        CacheEntry *e = &cache.slots[i];
+        if (e->key) {
+            CacheBufferWriteU64 (&buf, e->key);
+            CacheBufferWriteU64 (&buf, e->size);
+            CacheBufferWriteU64 (&buf, e->last_used);
+        }
+    }
+
+    char *tmp_path   = rz_str_newf ("%s" RZ_SYS_DIR CACHE_INDEX_FILE_NAME ".tmp", cache.dir);
+    char *index_path = rz_str_newf ("%s" RZ_SYS_DIR CACHE_INDEX_FILE_NAME, cache.dir);
+    if (!buf.failed && tmp_path && index_path && rz_file_dump (tmp_path, buf.data, buf.length, false) &&
+        cacheReplaceFile (tmp_path, index_path)) {
+        cache.dirty = false;
+    } else {
+        LOG_ERROR ("Failed to save cache index");
+    }
+
+    free (tmp_path);
+    free (index_path);
+    CacheBufferDeinit (&buf);
+}
+
+// Must be called with cache lock held.
+static void cacheLoadIndex (void) {
+    char  *index_path = rz_str_newf ("%s" RZ_SYS_DIR CACHE_INDEX_FILE_NAME, cache.dir);
+    size_t length     = 0;
+    char  *data       = index_path ? rz_file_slurp (index_path, &length) : NULL;
+    free (index_path);
+
+    if (data) {
+        CacheBuffer buf = {.data = (u8 *)data, .length = length, .capacity = length};
+        if (CacheBufferReadU64 (&buf) == CACHE_INDEX_MAGIC && CacheBufferReadU64 (&buf) == CACHE_FORMAT_VERSION) {
+            u64 count   = CacheBufferReadU64 (&buf);
+            cache.clock = CacheBufferReadU64 (&buf);
+            for (u64 i = 0; i < count && !buf.failed; i++) {
+                u64 key       = CacheBufferReadU64 (&buf);
+                u64 size      = CacheBufferReadU64 (&buf);
+                u64 last_used = CacheBufferReadU64 (&buf);
+
+                CacheEntry *e = key && !buf.failed ? cacheInsert (key) : NULL;
+                if (e) {
+                    e->size      = size;
+                    e->last_used = last_used;
+                }
+            }
+        } else {
+            LOG_INFO ("Cache index has different format version, ignoring it");
+        }
+        CacheBufferDeinit (&buf);
+    }
+
+    // Index can be out of date if a previous session crashed or another session shares the
+    // directory, so files on disk are the source of truth for which entries exist.
+    RzList *files = rz_sys_dir (cache.dir);
+    if (files) {
+        RzListIter *it   = NULL;
+        const char *name = NULL;
+        rz_list_foreach (files, it, name) {
+            u64      key     = 0;
+            unsigned version = 0;
+            int      end     = 0;
+            if (strspn (name, "0123456789abcdef") != 16 || name[16] != '.' ||
+                sscanf (name, "%16llx.%n", &key, &end) != 1 || end != 17) {
+                continue;
+            }
+
+            char *path = rz_str_newf ("%s" RZ_SYS_DIR "%s", cache.dir, name);
+            if (!path) {
+                continue;
+            }
+
+            // Leftovers of interrupted writes and entries of other versions
+            if (sscanf (name + end, "%u", &version) != 1 || version != CACHE_FORMAT_VERSION || !key) {
+                rz_file_rm (path);
+                free (path);
+                continue;
+            }
+
+            CacheEntry *e = cacheFind (key);
+            if (!e && (e = cacheInsert (key))) {
+                // Not known to index, treat as least recently used
+                e->size       = rz_file_size (path);
+                e->last_used  = 0;
+                cache.dirty   = true;
+            }
+            if (e) {
+                e->present = true;
+            }
+            free (path);
+        }
+        rz_list_free (files);
+    }
+
+    // Drop index entries for files that don't exist anymore
+    for (u64 i = 0; i < cache.capacity;) {
+        CacheEntry *e = &cache.slots[i];
+        if (e->key && !e->present) {
+            // Removal shifts next entries back into this slot, so check it again
+            cacheRemove (e->key);
+            continue;
+        }
+        i++;
+    }
+
+    cache.total_size = 0;
+    for (u64 i = 0; i < cache.capacity; i++) {
+        cache.slots[i].present  = false;
+        cache.total_size       += cache.slots[i].key ? cache.slots[i].size : 0;
+    }
+}
+
+// Must be called with cache lock held.
+static void cacheClose (void) {
+    cacheSaveIndex();
+    free (cache.slots);
+    free (cache.dir);
+
+    cache.slots      = NULL;
+    cache.dir        = NULL;
+    cache.capacity   = 0;
+    cache.count      = 0;
+    cache.total_size = 0;
+    cache.clock      = 0;
+    cache.dirty      = false;
+}
+
+/**************************************************************************************************/
+/****************************************** CACHE *************************************************/
+/**************************************************************************************************/
+
+bool CacheInit (const char *dir, u64 max_size, const char *name_space) {
+    if (!dir || !name_space) {
+        LOG_ERROR ("Invalid arguments");
+        return false;
+    }
+
+    rz_th_lock_enter (cacheLock());
+
+    cacheClose();
+    cache.generation++;
+
+    if (!max_size) {
+        LOG_INFO ("Response cache is disabled");
+        rz_th_lock_leave (cacheLock());
+        return true;
+    }
+
+    if (!rz_sys_mkdirp (dir) || !rz_file_is_directory (dir)) {
+        LOG_ERROR ("Failed to create cache directory '%s'. Response cache is disabled", dir);
+        rz_th_lock_leave (cacheLock());
+        return false;
+    }
+
+    cache.dir = rz_str_dup (dir);
+    if (!cache.dir) {
+        LOG_ERROR ("Failed to allocate memory. Response cache is disabled");
+        rz_th_lock_leave (cacheLock());
+        return false;
+    }
+
+    cache.ns_hash  = HashFnv1a (HASH_FNV1A_SEED, name_space, strlen (name_space));
+    cache.max_size = max_size;
+    cacheLoadIndex();
+    cacheEvict();
+
+    LOG_INFO (
+        "Response cache at '%s' has %llu entries using %llu of %llu bytes",
+        cache.dir,
+        cache.count,
+        cache.total_size,
+        cache.max_size
+    );
+
+    rz_th_lock_leave (cacheLock());
+    return true;
+}
+
+void CacheDeinit() {
+    if (!cache.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (cache.lock);
+    cacheClose();
+    cache.generation++;
+    rz_th_lock_leave (cache.lock);
+}
+
+// Header of an entry file, read by `cacheReadEntryFile`
+typedef struct CacheEntryHeader {
+    u64 kind;
+    u64 id;
+    u64 created;
+    Str params;
+} CacheEntryHeader;
+
+// Read an entry file and check it's header. On success read cursor of `out` is at entry data,
+// and `header->params` must be deinited by caller.
+static bool cacheReadEntryFile (const char *path, u64 ns_hash, CacheEntryHeader *header, CacheBuffer *out) {
+    size_t length = 0;
+    char  *data   = rz_file_slurp (path, &length);
+    if (!data) {
+        return false;
+    }
+
+    CacheBuffer buf     = {.data = (u8 *)data, .length = length, .capacity = length};
+    u64         magic   = CacheBufferReadU64 (&buf);
+    u64         version = CacheBufferReadU64 (&buf);
+    header->kind        = CacheBufferReadU64 (&buf);
+    header->id          = CacheBufferReadU64 (&buf);
+    u64 e_ns            = CacheBufferReadU64 (&buf);
+    header->created     = CacheBufferReadU64 (&buf);
+    header->params      = CacheBufferReadStr (&buf);
+
+    if (buf.failed || magic != CACHE_ENTRY_MAGIC || version != CACHE_FORMAT_VERSION || e_ns != ns_hash ||
+        header->kind <= 0 || header->kind >= CACHE_KIND_MAX) {
+        StrDeinit (&header->params);
+        CacheBufferDeinit (&buf);
+        return false;
+    }
+
+    *out = buf;
+    return true;
+}
+
+static bool cacheIsExpired (CacheKind kind, u64 created) {
+    u64 now = rz_time_now();
+    return cache_max_age_us[kind] && now > created && now - created > cache_max_age_us[kind];
+}
+
+// Lookup in cache directory only, `CacheGet` falls back to offline archive
+static bool cacheGetFromDisk (CacheKind kind, u64 id, const char *params, CacheBuffer *out) {
+    if (!cache.lock) {
+        return false;
+    }
+
+    rz_th_lock_enter (cache.lock);
+    if (!cache.dir) {
+        rz_th_lock_leave (cache.lock);
+        return false;
+    }
+
+    u64         key     = cacheKey (kind, id, params);
+    u64         ns_hash = cache.ns_hash;
+    CacheEntry *e       = cacheFind (key);
+    char       *path    = e ? cacheEntryPath (key) : NULL;
+    if (e) {
+        e->last_used = ++cache.clock;
+        cache.dirty  = true;
+    }
+    rz_th_lock_leave (cache.lock);
+
+    if (!path) {
+        return false;
+    }
+
+    // File is read outside the lock, so a slow disk does not stall other threads
+    CacheEntryHeader header = {0};
+    CacheBuffer      buf    = {0};
+    bool             is_read = cacheReadEntryFile (path, ns_hash, &header, &buf);
+    free (path);
+
+    bool is_valid = is_read && header.kind == (u64)kind && header.id == id &&
+                    !strcmp (header.params.data ? header.params.data : "", params ? params : "");
+    bool is_expired = is_valid && cacheIsExpired (kind, header.created);
+    StrDeinit (&header.params);
+
+    if (!is_valid || is_expired) {
+        LOG_INFO ("Dropping %s cache entry for ID %llu", is_expired ? "expired" : "invalid", id);
+        CacheBufferDeinit (&buf);
+        CacheInvalidate (kind, id, params);
+        return false;
+    }
+
+    *out = buf;
+    return true;
+}
+
+bool CacheGet (CacheKind kind, u64 id, const char *params, CacheBuffer *out) {
+    if (!out || kind <= 0 || kind >= CACHE_KIND_MAX) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    memset (out, 0, sizeof (CacheBuffer));
+    return cacheGetFromDisk (kind, id, params, out) || ArchiveGet (kind, id, params, out);
+}
+
+void CacheForEach (CacheEntryFn fn, void *user) {
+    if (!fn) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!cache.lock) {
+        return;
+    }
+
+    // Walk a snapshot of keys, so entry files are read without holding the lock
+    rz_th_lock_enter (cache.lock);
+    u64  ns_hash = cache.ns_hash;
+    u64  count   = 0;
+    u64 *keys    = cache.dir && cache.count ? malloc (cache.count * sizeof (u64)) : NULL;
+    if (keys) {
+        for (u64 i = 0; i < cache.capacity; i++) {
+            if (cache.slots[i].key) {
+                keys[count++] = cache.slots[i].key;
+            }
+        }
+    }
+    char *dir = keys ? rz_str_dup (cache.dir) : NULL;
+    rz_th_lock_leave (cache.lock);
+
+    for (u64 i = 0; dir && i < count; i++) {
+        char *path = rz_str_newf ("%s" RZ_SYS_DIR "%016llx.%u", dir, keys[i], CACHE_FORMAT_VERSION);
+        if (!path) {
+            continue;
+        }
+
+        CacheEntryHeader header = {0};
+        CacheBuffer      buf    = {0};
+        bool             is_read = cacheReadEntryFile (path, ns_hash, &header, &buf);
+        free (path);
+        if (!is_read) {
+            continue;
+        }
+
+        bool go_on = true;
+        if (!cacheIsExpired (header.kind, header.created)) {
+            go_on = fn (user, header.kind, header.id, header.params.length ? header.params.data : NULL, &buf);
+        }
+        StrDeinit (&header.params);
+        CacheBufferDeinit (&buf);
+
+        if (!go_on) {
+            break;
+        }
+    }
+
+    free (dir);
+    free (keys);
+}
+
+void CachePut (CacheKind kind, u64 id, const char *params, const CacheBuffer *data) {
+    if (!data || kind <= 0 || kind >= CACHE_KIND_MAX) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!cache.lock || data->failed) {
+        return;
+    }
+
+    rz_th_lock_enter (cache.lock);
+    if (!cache.dir) {
+        rz_th_lock_leave (cache.lock);
+        return;
+    }
+    u64   generation = cache.generation;
+    u64   ns_hash    = cache.ns_hash;
+    u64   key        = cacheKey (kind, id, params);
+    char *tmp_path   = cacheTmpPath (key);
+    rz_th_lock_leave (cache.lock);
+
+    if (!tmp_path) {
+        return;
+    }
+
+    Str param = StrInitFromZstr (params ? params : "");
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteU64 (&buf, CACHE_ENTRY_MAGIC);
+    CacheBufferWriteU64 (&buf, CACHE_FORMAT_VERSION);
+    CacheBufferWriteU64 (&buf, kind);
+    CacheBufferWriteU64 (&buf, id);
+    CacheBufferWriteU64 (&buf, ns_hash);
+    CacheBufferWriteU64 (&buf, rz_time_now());
+    CacheBufferWriteStr (&buf, &param);
+    CacheBufferWriteBytes (&buf, data->data, data->length);
+    StrDeinit (&param);
+
+    // Write to a temporary file first, so readers never see a partially written entry
+    bool is_written = !buf.failed && rz_file_dump (tmp_path, buf.data, buf.length, false);
+    u64  size       = buf.length;
+    CacheBufferDeinit (&buf);
+
+    if (!is_written) {
+        LOG_ERROR ("Failed to write cache entry for ID %llu", id);
+        rz_file_rm (tmp_path);
+        free (tmp_path);
+        return;
+    }
+
+    rz_th_lock_enter (cache.lock);
+
+    // Cache was closed or reopened while we were writing
+    if (!cache.dir || cache.generation != generation) {
+        rz_th_lock_leave (cache.lock);
+        rz_file_rm (tmp_path);
+        free (tmp_path);
+        return;
+    }
+
+    char       *path = cacheEntryPath (key);
+    CacheEntry *e    = path && cacheReplaceFile (tmp_path, path) ? cacheInsert (key) : NULL;
+    if (e) {
+        cache.total_size -= MIN2 (cache.total_size, e->size);
+        cache.total_size += size;
+        e->size           = size;
+        e->last_used      = ++cache.clock;
+        cache.dirty       = true;
+        cacheEvict();
+    } else {
+        LOG_ERROR ("Failed to add cache entry for ID %llu", id);
+        rz_file_rm (tmp_path);
+    }
+
+    rz_th_lock_leave (cache.lock);
+
+    free (path);
+    free (tmp_path);
+}
+
+void CacheInvalidate (CacheKind kind, u64 id, const char *params) {
+    if (kind <= 0 || kind >= CACHE_KIND_MAX) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!cache.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (cache.lock);
+    if (cache.dir) {
+        u64 key = cacheKey (kind, id, params);
+        if (cacheFind (key)) {
+            char *path = cacheEntryPath (key);
+            if (path) {
+                rz_file_rm (path);
+                free (path);
+            }
+            cacheRemove (key);
+        }
+    }
+    rz_th_lock_leave (cache.lock);
+}
+
+void CacheClear() {
+    if (!cache.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (cache.lock);
+    if (cache.dir) {
+        for (u64 i = 0; i < cache.capacity; i++) {
+            if (cache.slots[i].key) {
+                char *path = cacheEntryPath (cache.slots[i].key);
+                if (path) {
+                    rz_file_rm (path);
+                    free (path);
+                }
+            }
+        }
+        memset (cache.slots, 0, cache.capacity * sizeof (CacheEntry));
+        cache.count      = 0;
+        cache.total_size = 0;
+        cache.dirty      = true;
+        cacheSaveIndex();
+    }
+    rz_th_lock_leave (cache.lock);
+}
+
+/**************************************************************************************************/
+/************************************** TYPED HELPERS *********************************************/
+/**************************************************************************************************/
+
+bool CacheGetStr (CacheKind kind, u64 id, const char *params, Str *out) {
+    if (!out) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    if (!CacheGet (kind, id, params, &buf)) {
+        return false;
+    }
+
+    Str str = CacheBufferReadStr (&buf);
+    if (buf.failed) {
+        StrDeinit (&str);
+        CacheBufferDeinit (&buf);
+        return false;
+    }
+
+    CacheBufferDeinit (&buf);
+    StrDeinit (out);
+    *out = str;
+    return true;
+}
+
+void CachePutStr (CacheKind kind, u64 id, const char *params, const Str *str) {
+    if (!str) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteStr (&buf, str);
+    CachePut (kind, id, params, &buf);
+    CacheBufferDeinit (&buf);
+}
+
+bool CacheGetFunctionInfos (BinaryId binary_id, FunctionInfos *out) {
+    if (!out) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    if (!CacheGet (CACHE_KIND_FUNCTION_INFOS, binary_id, NULL, &buf)) {
+        return false;
+    }
+
+    FunctionInfos functions = VecInitWithDeepCopy_T (&functions, NULL, FunctionInfoDeinit);
+
+    u64 count = CacheBufferReadU64 (&buf);
+    for (u64 i = 0; i < count && !buf.failed; i++) {
+        FunctionInfo fi       = {0};
+        fi.id                 = CacheBufferReadU64 (&buf);
+        fi.size               = CacheBufferReadU64 (&buf);
+        fi.symbol.is_addr     = true;
+        fi.symbol.is_external = false;
+        fi.symbol.value.addr  = CacheBufferReadU64 (&buf);
+        fi.symbol.name        = CacheBufferReadStr (&buf);
+        VecPushBack (&functions, fi);
+    }
+
+    bool ok = !buf.failed && functions.length;
+    CacheBufferDeinit (&buf);
+
+    if (!ok) {
+        VecDeinit (&functions);
+        return false;
+    }
+
+    *out = functions;
+    return true;
+}
+
+void CacheBufferWriteFunctionInfos (CacheBuffer *buf, const FunctionInfos *functions) {
+    if (!buf || !functions) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    u64 count = 0;
+    VecForeachPtr (functions, fi, { count += fi->symbol.is_addr ? 1 : 0; });
+
+    CacheBufferWriteU64 (buf, count);
+    VecForeachPtr (functions, fi, {
+        if (fi->symbol.is_addr) {
+            CacheBufferWriteU64 (buf, fi->id);
+            CacheBufferWriteU64 (buf, fi->size);
+            CacheBufferWriteU64 (buf, fi->symbol.value.addr);
+            CacheBufferWriteStr (buf, &fi->symbol.name);
+        }
+    });
+}
+
+void CachePutFunctionInfos (BinaryId binary_id, const FunctionInfos *functions) {
+    if (!functions) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteFunctionInfos (&buf, functions);
+    CachePut (CACHE_KIND_FUNCTION_INFOS, binary_id, NULL, &buf);
+    CacheBufferDeinit (&buf);
+}
+
+static Str similarFunctionsCacheParams (const SimilarFunctionsRequest *search) {
+    Str params = StrInit();
+    StrPrintf (
+        &params,
+        "limit=%u;distance=%.6f;debug=%d%d%d;collections=",
+        (u32)search->limit,
+        search->distance,
+        (int)search->debug_include.user_symbols,
+        (int)search->debug_include.system_symbols,
+        (int)search->debug_include.external_symbols
+    );
+    VecForeach (&search->collection_ids, cid, { StrAppendf (&params, "%llu,", cid); });
+    StrAppendf (&params, ";binaries=");
+    VecForeach (&search->binary_ids, bid, { StrAppendf (&params, "%llu,", bid); });
+    return params;
+}
+
+bool CacheGetSimilarFunctions (const SimilarFunctionsRequest *search, SimilarFunctions *out) {
+    if (!search || !out) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    Str         params = similarFunctionsCacheParams (search);
+    CacheBuffer buf    = {0};
+    bool        is_hit = CacheGet (CACHE_KIND_SIMILAR_FUNCTIONS, search->function_id, params.data, &buf);
+    StrDeinit (&params);
+    if (!is_hit) {
+        return false;
+    }
+
+    SimilarFunctions functions = VecInitWithDeepCopy_T (&functions, NULL, SimilarFunctionDeinit);
+
+    u64 count = CacheBufferReadU64 (&buf);
+    for (u64 i = 0; i < count && !buf.failed; i++) {
+        SimilarFunction sf = {0};
+        sf.id              = CacheBufferReadU64 (&buf);
+        sf.binary_id       = CacheBufferReadU64 (&buf);
+        sf.distance        = CacheBufferReadF64 (&buf);
+        sf.name            = CacheBufferReadStr (&buf);
+        sf.binary_name     = CacheBufferReadStr (&buf);
+        VecPushBack (&functions, sf);
+    }
+
+    bool ok = !buf.failed;
+    CacheBufferDeinit (&buf);
+
+    if (!ok) {
+        VecDeinit (&functions);
+        return false;
+    }
+
+    *out = functions;
+    return true;
+}
+
+void CachePutSimilarFunctions (const SimilarFunctionsRequest *search, const SimilarFunctions *functions) {
+    if (!search || !functions) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteU64 (&buf, functions->length);
+    VecForeachPtr (functions, sf, {
+        CacheBufferWriteU64 (&buf, sf->id);
+        CacheBufferWriteU64 (&buf, sf->binary_id);
+        CacheBufferWriteF64 (&buf, sf->distance);
+        CacheBufferWriteStr (&buf, &sf->name);
+        CacheBufferWriteStr (&buf, &sf->binary_name);
+    });
+
+    Str params = similarFunctionsCacheParams (search);
+    CachePut (CACHE_KIND_SIMILAR_FUNCTIONS, search->function_id, params.data, &buf);
+    StrDeinit (&params);
+    CacheBufferDeinit (&buf);
+}
+
+// Entry is the code, followed by (type, start, end) of each annotation and it's type specific
+// data : (name, offset) for references, name for variables, highlight type for highlights.
+void CacheBufferWriteAnnotatedCode (CacheBuffer *buf, const RzAnnotatedCode *code) {
+    if (!buf || !code || !code->code) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    Str text = StrInitFromZstr (code->code);
+    CacheBufferWriteStr (buf, &text);
+    CacheBufferWriteU64 (buf, rz_vector_len (&code->annotations));
+    StrDeinit (&text);
+
+    RzCodeAnnotation *a;
+    rz_vector_foreach (&code->annotations, a) {
+        CacheBufferWriteU64 (buf, a->type);
+        CacheBufferWriteU64 (buf, a->start);
+        CacheBufferWriteU64 (buf, a->end);
+
+        switch (a->type) {
+            case RZ_CODE_ANNOTATION_TYPE_FUNCTION_NAME :
+            case RZ_CODE_ANNOTATION_TYPE_GLOBAL_VARIABLE :
+            case RZ_CODE_ANNOTATION_TYPE_CONSTANT_VARIABLE : {
+                Str name = StrInitFromZstr (a->reference.name ? a->reference.name : "");
+                CacheBufferWriteStr (buf, &name);
+                CacheBufferWriteU64 (buf, a->reference.offset);
+                StrDeinit (&name);
+                break;
+            }
+            case RZ_CODE_ANNOTATION_TYPE_LOCAL_VARIABLE :
+            case RZ_CODE_ANNOTATION_TYPE_FUNCTION_PARAMETER : {
+                Str name = StrInitFromZstr (a->variable.name ? a->variable.name : "");
+                CacheBufferWriteStr (buf, &name);
+                StrDeinit (&name);
+                break;
+            }
+            case RZ_CODE_ANNOTATION_TYPE_SYNTAX_HIGHLIGHT :
+                CacheBufferWriteU64 (buf, a->syntax_highlight.type);
+                break;
+            default :
+                CacheBufferWriteU64 (buf, a->offset.offset);
+                break;
+        }
+    }
+}
+
+void CachePutAnnotatedCode (FunctionId fn_id, const RzAnnotatedCode *code) {
+    if (!code || !code->code) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    CacheBuffer buf = {0};
+    CacheBufferWriteAnnotatedCode (&buf, code);
+    CachePut (CACHE_KIND_ANNOTATED_DECOMPILATION, fn_id, NULL, &buf);
+    CacheBufferDeinit (&buf);
+}
+
+RzAnnotatedCode *CacheGetAnnotatedCode (FunctionId fn_id) {
+    CacheBuffer buf = {0};
+    if (!CacheGet (CACHE_KIND_ANNOTATED_DECOMPILATION, fn_id, NULL, &buf)) {
+        return NULL;
+    }
+
+    Str              text  = CacheBufferReadStr (&buf);
+    u64              count = CacheBufferReadU64 (&buf);
+    RzAnnotatedCode *code  = buf.failed ? NULL : rz_annotated_code_new (strdup (text.data ? text.data : ""));
+
+    for (u64 i = 0; code && i < count && !buf.failed; i++) {
+        RzCodeAnnotation a = {0};
+        a.type             = (RzCodeAnnotationType)CacheBufferReadU64 (&buf);
+        a.start            = CacheBufferReadU64 (&buf);
+        a.end              = CacheBufferReadU64 (&buf);
+
+        switch (a.type) {
+            case RZ_CODE_ANNOTATION_TYPE_FUNCTION_NAME :
+            case RZ_CODE_ANNOTATION_TYPE_GLOBAL_VARIABLE :
+            case RZ_CODE_ANNOTATION_TYPE_CONSTANT_VARIABLE : {
+                Str name           = CacheBufferReadStr (&buf);
+                a.reference.name   = strdup (name.data ? name.data : "");
+                a.reference.offset = CacheBufferReadU64 (&buf);
+                StrDeinit (&name);
+                break;
+            }
+            case RZ_CODE_ANNOTATION_TYPE_LOCAL_VARIABLE :
+            case RZ_CODE_ANNOTATION_TYPE_FUNCTION_PARAMETER : {
+                Str name        = CacheBufferReadStr (&buf);
+                a.variable.name = strdup (name.data ? name.data : "");
+                StrDeinit (&name);
+                break;
+            }
+            case RZ_CODE_ANNOTATION_TYPE_SYNTAX_HIGHLIGHT :
+                a.syntax_highlight.type = (RzSyntaxHighlightType)CacheBufferReadU64 (&buf);
+                break;
+            default :
+                a.offset.offset = CacheBufferReadU64 (&buf);
+                break;
+        }
+
+        if (!buf.failed && a.start <= a.end && a.end <= text.length) {
+            rz_annotated_code_add_annotation (code, &a);
+        } else {
+            rz_annotation_free (&a, NULL);
+        }
+    }
+
+    if (code && buf.failed) {
+        rz_annotated_code_free (code);
+        code = NULL;
+    }
+
+    StrDeinit (&text);
+    CacheBufferDeinit (&buf);
+    return code;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file : Cache.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Persistent on-disk cache for responses received from RevEngAI.
+ * Each entry is stored in it's own file inside cache directory, and is keyed by
+ * (host, kind, id, params). An index of all entries with their sizes and last use
+ * is kept in memory and saved to disk, so least recently used entries can be
+ * evicted when cache grows over it's size limit.
+ *
+ * Entries written by a different cache format version are ignored and removed.
+ *
+ * Lookups that miss are served from offline archive, if one is mounted (see `Archive.h`).
+ * */
+
+#ifndef REAI_PLUGIN_CACHE
+#define REAI_PLUGIN_CACHE
+
+/* revenai */
+#include <Reai/Api.h>
+
+/* rizin */
+#include <rz_util/rz_annotated_code.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Type of data stored in a cache entry. Decides how long an entry stays valid.
+    ///
+    typedef enum CacheKind {
+        CACHE_KIND_FUNCTION_INFOS = 1,       ///< `FunctionInfos` of a binary, keyed by binary ID.
+        CACHE_KIND_LINEAR_DISASM,            ///< Linear disassembly made from `ControlFlowGraph`.
+        CACHE_KIND_DECOMPILATION,            ///< `AiDecompilation::decompilation` of a function.
+        CACHE_KIND_ANNOTATED_DECOMPILATION,  ///< Decompiler view output, code with annotations.
+        CACHE_KIND_SIMILAR_FUNCTIONS,        ///< `SimilarFunctions`, keyed by function ID and request.
+        CACHE_KIND_AI_MODELS,                ///< `ModelInfos` with their fetch time, keyed by zero.
+        CACHE_KIND_MAX
+    } CacheKind;
+
+    ///
+    /// Growable byte buffer used to serialize cache entries.
+    /// Reads past the end set `failed` and return zeroed values.
+    ///
+    typedef struct CacheBuffer {
+        u8*  data;
+        u64  length;
+        u64  capacity;
+        u64  cursor; ///< Read position.
+        bool failed;
+    } CacheBuffer;
+
+    void CacheBufferDeinit (CacheBuffer* buf);
+    void CacheBufferWriteU64 (CacheBuffer* buf, u64 value);
+    void CacheBufferWriteF64 (CacheBuffer* buf, f64 value);
+    void CacheBufferWriteBytes (CacheBuffer* buf, const void* data, u64 length);
+    void CacheBufferWriteStr (CacheBuffer* buf, const Str* str);
+    u64  CacheBufferReadU64 (CacheBuffer* buf);
+    f64  CacheBufferReadF64 (CacheBuffer* buf);
+    Str  CacheBufferReadStr (CacheBuffer* buf);
+
+    ///
+    /// Open cache directory and load it's index. Calling again reopens cache with new settings.
+    ///
+    /// dir[in]        : Cache directory, created if it does not exist.
+    /// max_size[in]   : Size limit of cache in bytes. Zero disables cache.
+    /// name_space[in] : Entries are separated by this name, usually the API host.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages. Cache stays disabled and all lookups miss.
+    ///
+    bool CacheInit (const char* dir, u64 max_size, const char* name_space);
+
+    ///
+    /// Save cache index to disk and close cache.
+    ///
+    void CacheDeinit();
+
+    ///
+    /// Get data of a cache entry. Falls back to mounted offline archive on cache miss.
+    ///
+    /// kind[in]   : Type of cached data.
+    /// id[in]     : Binary or function ID entry belongs to.
+    /// params[in] : Extra key, for data that depends on request parameters. Can be `NULL`.
+    /// out[out]   : Entry data on hit, with read cursor at start. Must be deinited by caller.
+    ///
+    /// SUCCESS : `true` on cache hit.
+    /// FAILURE : `false` if entry does not exist, has expired or is unreadable.
+    ///
+    bool CacheGet (CacheKind kind, u64 id, const char* params, CacheBuffer* out);
+
+    ///
+    /// Create or replace a cache entry, evicting least recently used entries if required.
+    ///
+    void CachePut (CacheKind kind, u64 id, const char* params, const CacheBuffer* data);
+
+    ///
+    /// Remove a cache entry if it exists.
+    ///
+    void CacheInvalidate (CacheKind kind, u64 id, const char* params);
+
+    ///
+    /// Remove all cache entries.
+    ///
+    void CacheClear();
+
+    ///
+    /// Called for each cache entry by `CacheForEach`.
+    ///
+    /// kind[in]   : Type of cached data.
+    /// id[in]     : Binary or function ID entry belongs to.
+    /// params[in] : Extra key of entry. `NULL` if entry has none.
+    /// data[in]   : Entry data, with read cursor at start. Owned by `CacheForEach`.
+    ///
+    /// SUCCESS : `true` to continue with next entry.
+    /// FAILURE : `false` to stop.
+    ///
+    typedef bool (*CacheEntryFn) (void* user, CacheKind kind, u64 id, const char* params, CacheBuffer* data);
+
+    ///
+    /// Call `fn` for every valid, unexpired entry in cache directory, in no particular order.
+    /// Reads every entry file, so this is slow for large caches. Offline archive is not included.
+    ///
+    void CacheForEach (CacheEntryFn fn, void* user);
+
+    ///
+    /// Helpers for entries that hold a single string.
+    /// On hit, previous contents of `out` are deinited and replaced.
+    ///
+    bool CacheGetStr (CacheKind kind, u64 id, const char* params, Str* out);
+    void CachePutStr (CacheKind kind, u64 id, const char* params, const Str* str);
+
+    ///
+    /// Cached basic function information of a binary.
+    /// `CacheBufferWriteFunctionInfos` appends same entry data to a buffer, without caching it.
+    ///
+    bool CacheGetFunctionInfos (BinaryId binary_id, FunctionInfos* out);
+    void CachePutFunctionInfos (BinaryId binary_id, const FunctionInfos* functions);
+    void CacheBufferWriteFunctionInfos (CacheBuffer* buf, const FunctionInfos* functions);
+
+    ///
+    /// Cached similar function search results, keyed by all request parameters.
+    ///
+    bool CacheGetSimilarFunctions (const SimilarFunctionsRequest* search, SimilarFunctions* out);
+    void CachePutSimilarFunctions (const SimilarFunctionsRequest* search, const SimilarFunctions* functions);
+
+    ///
+    /// Cached decompiler output of a function, code with all it's annotations.
+    /// Only completed decompilations are cached, because those never change.
+    /// `CacheBufferWriteAnnotatedCode` appends same entry data to a buffer, without caching it.
+    ///
+    /// SUCCESS : `CacheGetAnnotatedCode` returns code owned by caller.
+    /// FAILURE : `NULL` on cache miss.
+    ///
+    RzAnnotatedCode* CacheGetAnnotatedCode (FunctionId fn_id);
+    void             CachePutAnnotatedCode (FunctionId fn_id, const RzAnnotatedCode* code);
+    void             CacheBufferWriteAnnotatedCode (CacheBuffer* buf, const RzAnnotatedCode* code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_CACHE
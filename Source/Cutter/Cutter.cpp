@@ -523,6 +523,8 @@ ReaiCutterPlugin::~ReaiCutterPlugin() {
         s_instance = nullptr;
     }
 
+    PluginShutdown();
+
     if (!isInitialized) {
         return;
     }
@@ -936,7 +938,7 @@ void AnalysisStatusPoller::checkAnalysisStatus() {
     }
 
     try {
-        Status status = GetAnalysisStatus (GetConnection(), currentBinaryId);
+        Status status = GetAnalysisStatusCached (currentBinaryId, false);
 
         QString statusString;
         bool    isComplete = false;
@@ -7,273 +7,361 @@
 
 #include <Cutter/Decompiler.hpp>
 #include <Plugin.h>
+#include <Cache.h>
+#include <DecompilationRender.h>
+#include <JobWaiter.h>
+#include <Prefetch.h>
 #include <Reai/Api/Types/AiDecompilation.h>
 
 // rizin
 #include <rz_util/rz_annotated_code.h>
 #include <rz_util/rz_str.h>
+#include <rz_util/rz_time.h>
 
 // libc
+#include <stdlib.h>
 #include <string.h>
 
+// Cached code of a function is compared with RevEngAI's at most this often
+#define REVALIDATE_INTERVAL_US (10ULL * 60 * 1000 * 1000)
+
+// Revalidation times kept before old ones are dropped
+#define REVALIDATE_HISTORY_MAX 1024
+
 ReaiDec::ReaiDec (QObject *parent) : Decompiler ("reaidec", "ReaiDec", parent) {}
 
-bool ReaiDec::isRunning() {
-    return !this->is_finished;
+ReaiDec::~ReaiDec() {
+    {
+        QMutexLocker locker (&lock);
+        stop_requested = true;
+        wake.wakeOne();
+        revalidate_wake.wakeOne();
+    }
+
+    if (worker) {
+        worker->wait();
+        delete worker;
+    }
+    if (revalidator) {
+        revalidator->wait();
+        delete revalidator;
+    }
 }
 
-void ReaiDec::pollAndSignalFinished (RVA rva_addr) {
-    // wait for other thread to finish running
-    // XXX: Will this work???
-    // while (!is_finished) {}
+// Build final code with summary comments, and annotate all symbol references in it.
+// Result is also cached, completed decompilations don't change.
+static RzAnnotatedCode *annotatedCodeFromAiDecompilation (FunctionId fn_id, AiDecompilation *aidec) {
+    RzAnnotatedCode *code = AnnotatedCodeFromAiDecompilation (aidec);
+    if (code) {
+        CachePutAnnotatedCode (fn_id, code);
+    } else {
+        code = rz_annotated_code_new (strdup ("/* empty */"));
+    }
+    return code;
+}
 
-    // again decompilation started
-    is_finished = false;
+// Put a note before cached code, keeping all annotations on same text
+static void markAsCached (RzAnnotatedCode *code) {
+    static const char note[]   = "// Loaded from local cache, updated here if RevEngAI has a newer version\n";
+    size_t            note_len = sizeof (note) - 1;
+    size_t            code_len = strlen (code->code);
 
+    char *marked = (char *)malloc (note_len + code_len + 1);
+    if (!marked) {
+        return;
+    }
+    memcpy (marked, note, note_len);
+    memcpy (marked + note_len, code->code, code_len + 1);
+    free (code->code);
+    code->code = marked;
+
+    RzCodeAnnotation *a;
+    rz_vector_foreach (&code->annotations, a) {
+        a->start += note_len;
+        a->end   += note_len;
+    }
+
+    RzCodeAnnotation comment      = {};
+    comment.type                  = RZ_CODE_ANNOTATION_TYPE_SYNTAX_HIGHLIGHT;
+    comment.start                 = 0;
+    comment.end                   = note_len - 1;
+    comment.syntax_highlight.type = RZ_SYNTAX_HIGHLIGHT_TYPE_COMMENT;
+    rz_annotated_code_add_annotation (code, &comment);
+}
+
+// Wait for AI decompilation of given function to complete and fetch it.
+// Only talks to RevEngAI, must not touch Rizin state, because RzCore is not locked here.
+static RzAnnotatedCode *fetchAiDecompilation (FunctionId fn_id, RVA rva_addr, const JobWaiter *waiter) {
+    switch (WaitForAiDecompilation (waiter, fn_id)) {
+        case JOB_WAIT_SUCCESS :
+            break;
+        case JOB_WAIT_TIMEOUT :
+        case JOB_WAIT_CANCELLED :
+            return rz_annotated_code_new (strdup ("Stopped waiting for AI decompilation."));
+        default :
+            return rz_annotated_code_new (
+                strdup ("AI decompilation process errored out. Failed to get AI decompilation")
+            );
+    }
+
+    LOG_INFO ("Decompilation complete @ 0x%llx", rva_addr);
+
+    // finally get ai-decompilation after finish
+    AiDecompilation  aidec = GetAiDecompilation (GetConnection(), fn_id, true);
+    RzAnnotatedCode *code  = annotatedCodeFromAiDecompilation (fn_id, &aidec);
+    AiDecompilationDeinit (&aidec);
+    return code;
+}
+
+// Everything decompilation needs from Rizin, copied while RzCore is locked
+struct DecompilationTarget {
+    BinaryId binary_id = 0;
+    u64      offset    = 0; ///< Function address without binary base address.
+    QString  name;
+};
+
+static bool snapshotDecompilationTarget (RVA rva_addr, DecompilationTarget *target) {
     RzCoreLocked core (Core());
 
-    // get RevEngAI function Id for function to be decompiled
-    FunctionId fn_id = rzLookupFunctionIdForFunctionAtAddr (core, rva_addr);
-    if (!fn_id) {
-        LOG_ERROR ("Decompilation failed @ 0x%llx => Reason : Function ID not found", rva_addr);
-        RzAnnotatedCode *code = rz_annotated_code_new (strdup ("Failed to decompile. Failed to find function ID."));
-        is_finished           = true;
-        finished (code);
-        return;
+    RzAnalysisFunction *fn = rz_analysis_get_function_at (core->analysis, rva_addr);
+    if (!fn) {
+        LOG_ERROR ("A function at given address '%llx' does not exist in Rizin.", rva_addr);
+        return false;
+    }
+
+    target->binary_id = GetBinaryIdFromCore (core);
+    target->offset    = fn->addr - rzGetCurrentBinaryBaseAddr (core);
+    target->name      = QString::fromUtf8 (fn->name);
+
+    // Callees are likely to be visited next, get them ready in background
+    PrefetchCallees (core, fn->addr);
+    return true;
+}
+
+RzAnnotatedCode *ReaiDec::decompile (RVA rva_addr, FunctionId *out_fn_id, QByteArray *cached_text) {
+    // Short locked phase, rest of the pipeline runs without holding RzCore
+    DecompilationTarget target;
+    FunctionId          fn_id = 0;
+    RzAnnotatedCode    *code  = NULL;
+
+    if (!snapshotDecompilationTarget (rva_addr, &target)) {
+        code = rz_annotated_code_new (strdup ("Failed to decompile. No function exists at given address."));
+    } else if (!target.binary_id) {
+        code = rz_annotated_code_new (
+            strdup ("Failed to decompile. Please create a new analysis or apply an existing analysis first.")
+        );
+    } else if (!(fn_id = GetFunctionIdForOffset (target.binary_id, target.offset))) {
+        LOG_ERROR (
+            "Decompilation failed @ 0x%llx ('%s') => Reason : Function ID not found",
+            rva_addr,
+            target.name.toUtf8().constData()
+        );
+        code = rz_annotated_code_new (strdup ("Failed to decompile. Failed to find function ID."));
+    } else if ((code = CacheGetAnnotatedCode (fn_id))) {
+        // Show cached output without asking RevEngAI, it's revalidated after delivery
+        LOG_INFO ("Using cached decompilation @ 0x%llx", rva_addr);
+        *cached_text = QByteArray (code->code);
+        markAsCached (code);
+    } else {
+        // Stop waiting as soon as user moves to another function
+        JobWaiter waiter    = JobWaiterInit (0);
+        waiter.is_cancelled = isRequestCancelled;
+        waiter.user         = this;
+        code                = fetchAiDecompilation (fn_id, rva_addr, &waiter);
+    }
+
+    *out_fn_id = fn_id;
+    return code;
+}
+
+RzAnnotatedCode *ReaiDec::revalidate (FunctionId fn_id, const QByteArray &cached_text, u64 request) {
+    u64  now  = rz_time_now_mono();
+    auto last = revalidated_at.constFind (fn_id);
+    if (last != revalidated_at.constEnd() && now - last.value() < REVALIDATE_INTERVAL_US) {
+        return nullptr;
     }
 
-    // Ignore first status value (suggested by revengai team)
-    Status status = GetAiDecompilationStatus (GetConnection(), fn_id);
-    if ((status & STATUS_MASK) == STATUS_ERROR) {
-        if (!BeginAiDecompilation (GetConnection(), fn_id)) {
-            RzAnnotatedCode *code = rz_annotated_code_new (strdup ("Failed to start AI decompilation process."));
-            is_finished           = true;
-            finished (code);
-            return;
+    // Entries past the interval don't skip anything anymore
+    if (revalidated_at.size() >= REVALIDATE_HISTORY_MAX) {
+        for (auto it = revalidated_at.begin(); it != revalidated_at.end();) {
+            if (now - it.value() >= REVALIDATE_INTERVAL_US) {
+                it = revalidated_at.erase (it);
+            } else {
+                ++it;
+            }
+        }
+        if (revalidated_at.size() >= REVALIDATE_HISTORY_MAX) {
+            revalidated_at.clear();
         }
-        LOG_INFO ("Initial status was STATUS_ERROR and I started decompilation again");
     }
 
-    // keep polling for AI decompilation status completion
-    Str final_code = StrInit();
+    if (isOutdated (request)) {
+        return nullptr;
+    }
+    revalidated_at.insert (fn_id, now);
+
+    // Cached code is from a completed decompilation, anything else on server is not newer
+    u32 status = GetAiDecompilationStatus (GetConnection(), fn_id) & STATUS_MASK;
+    if ((status != STATUS_SUCCESS && status != STATUS_COMPLETE) || isOutdated (request)) {
+        return nullptr;
+    }
+
+    AiDecompilation  aidec = GetAiDecompilation (GetConnection(), fn_id, true);
+    RzAnnotatedCode *fresh = AnnotatedCodeFromAiDecompilation (&aidec);
+    if (fresh && cached_text != fresh->code) {
+        LOG_INFO ("AI decompilation of function ID %llu changed on RevEngAI, updating cache", fn_id);
+        CachePutAnnotatedCode (fn_id, fresh);
+        CachePutStr (CACHE_KIND_DECOMPILATION, fn_id, NULL, &aidec.decompilation);
+    } else if (fresh) {
+        rz_annotated_code_free (fresh);
+        fresh = nullptr;
+    }
+    AiDecompilationDeinit (&aidec);
+
+    return fresh;
+}
+
+bool ReaiDec::isRequestCancelled (void *self) {
+    ReaiDec     *dec = static_cast<ReaiDec *> (self);
+    QMutexLocker locker (&dec->lock);
+
+    // Requests for same function are merged in `decompileAt`, so any pending request is for another one
+    return dec->stop_requested || dec->has_request;
+}
+
+bool ReaiDec::isOutdated (u64 request) {
+    QMutexLocker locker (&lock);
+    return stop_requested || has_request || request != latest_request;
+}
+
+bool ReaiDec::deliver (RzAnnotatedCode *code, u64 request) {
+    // A revalidated result must not land after a newer request's result
+    QMutexLocker deliver_locker (&deliver_lock);
+    if (isOutdated (request)) {
+        rz_annotated_code_free (code);
+        return false;
+    }
+
+    finished (code);
+    return true;
+}
+
+void ReaiDec::serveRevalidations() {
     while (true) {
-        LOG_INFO ("Checking decompilation status...");
-
-        status = GetAiDecompilationStatus (GetConnection(), fn_id);
-        switch (status & STATUS_MASK) {
-            case STATUS_ERROR : {
-                RzAnnotatedCode *code = rz_annotated_code_new (
-                    strdup ("AI decompilation process errored out. Failed to get AI decompilation")
-                );
-                is_finished = true;
-                finished (code);
+        FunctionId fn_id   = 0;
+        u64        request = 0;
+        QByteArray cached_text;
+        {
+            QMutexLocker locker (&lock);
+            while (!has_revalidation && !stop_requested) {
+                revalidate_wake.wait (&lock);
+            }
+            if (stop_requested) {
                 return;
             }
 
-            case STATUS_UNINITIALIZED :
-                if (!BeginAiDecompilation (GetConnection(), fn_id)) {
-                    RzAnnotatedCode *code = rz_annotated_code_new (strdup ("Failed to start AI decompilation."));
-                    is_finished           = true;
-                    finished (code);
-                    return;
-                }
-                break;
-
-            case STATUS_PENDING : {
-                LOG_INFO ("AI decompilation status @ 0x%llx : Pending", rva_addr);
-                break;
-            }
+            fn_id            = revalidate_fn_id;
+            request          = revalidate_request;
+            cached_text      = revalidate_text;
+            has_revalidation = false;
+            revalidate_text.clear();
+        }
 
-            case STATUS_SUCCESS : {
-                LOG_INFO ("Decompilation complete @ 0x%llx", rva_addr);
-
-                // finally get ai-decompilation after finish
-                AiDecompilation aidec = GetAiDecompilation (GetConnection(), fn_id, true);
-                Str            *smry  = &aidec.ai_summary;
-                Str            *dec   = &aidec.raw_decompilation;
-
-                // split summary into comments
-                static i32 SOFT_LIMIT = 120;
-                i32        l          = smry->length;
-                char      *p          = smry->data;
-                while (l > SOFT_LIMIT) {
-                    char *p1 = strchr (p + SOFT_LIMIT, ' ');
-                    if (p1) {
-                        StrAppendf (&final_code, "// %.*s\n", (i32)(p1 - p), p);
-                        p1++;
-                        l -= (p1 - p);
-                        p  = p1;
-                    } else {
-                        break;
-                    }
-                }
-                StrAppendf (&final_code, "// %.*s\n\n", (i32)l, p);
-
-                // decompilation code comes after summary
-                StrMerge (&final_code, dec);
-
-                LOG_INFO ("aidec.functions.length = %zu", aidec.functions.length);
-                VecForeachIdx (&aidec.functions, function, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<DISASM_FUNCTION_%llu>", idx);
-                    StrReplace (&final_code, &dname, &function.name, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.strings.length = %zu", aidec.strings.length);
-                VecForeachIdx (&aidec.strings, string, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<DISASM_STRING_%llu>", idx);
-                    StrReplace (&final_code, &dname, &string.string, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.unmatched.functions.length = %zu", aidec.unmatched.functions.length);
-                VecForeachIdx (&aidec.unmatched.functions, function, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<UNMATCHED_FUNCTION_%llu>", idx);
-                    StrReplace (&final_code, &dname, &function.name, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.unmatched.strings.length = %zu", aidec.unmatched.strings.length);
-                VecForeachIdx (&aidec.unmatched.strings, string, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<UNMATCHED_STRING_%llu>", idx);
-                    StrReplace (&final_code, &dname, &string.value.str, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.unmatched.vars.length = %zu", aidec.unmatched.vars.length);
-                VecForeachIdx (&aidec.unmatched.vars, var, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<VAR_%llu>", idx);
-                    StrReplace (&final_code, &dname, &var.value.str, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.unmatched.external_vars.length = %zu", aidec.unmatched.external_vars.length);
-                VecForeachIdx (&aidec.unmatched.external_vars, var, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<EXTERNAL_VARIABLE_%llu>", idx);
-                    StrReplace (&final_code, &dname, &var.value.str, -1);
-                    StrDeinit (&dname);
-                });
-
-                LOG_INFO ("aidec.unmatched.custom_types.length = %zu", aidec.unmatched.custom_types.length);
-                VecForeachIdx (&aidec.unmatched.custom_types, var, idx, {
-                    Str dname = StrInit();
-                    StrPrintf (&dname, "<CUSTOM_TYPE_%llu>", idx);
-                    StrReplace (&final_code, &dname, &var.value.str, -1);
-                    StrDeinit (&dname);
-                });
-
-
-                RzAnnotatedCode *code = NULL;
-
-                LOG_INFO ("Final Code : %s", final_code.data);
-
-                if (aidec.decompilation.length) {
-                    code = rz_annotated_code_new (strdup (final_code.data));
-
-                    SymbolInfos all_functions = VecInit();
-                    if (aidec.functions.length) {
-                        VecMerge (&all_functions, &aidec.functions);
-                    }
-                    if (aidec.unmatched.functions.length) {
-                        VecMerge (&all_functions, &aidec.unmatched.functions);
-                    }
-
-                    VecForeachPtr (&all_functions, function, {
-                        if (function->is_external) {
-                            LOG_INFO ("Skipping external function '%s'", function->name.data);
-                            continue;
-                        }
-
-                        // Search for function and create annotation
-                        char *name_beg = strstr (final_code.data, function->name.data);
-                        while (name_beg) {
-                            size name_len = function->name.length;
-                            LOG_INFO ("Found string at offset %d", (i32)(name_beg - final_code.data));
-
-                            // provide funciton address information through code annotation
-                            RzCodeAnnotation a;
-                            a.type             = RZ_CODE_ANNOTATION_TYPE_FUNCTION_NAME;
-                            a.start            = name_beg - final_code.data;
-                            a.end              = a.start + name_len;
-                            a.reference.name   = strdup (function->name.data);
-                            a.reference.offset = function->value.addr;
-                            rz_annotated_code_add_annotation (code, &a);
-
-                            LOG_INFO ("Annotating %s in (%zu, %zu)", function->name.data, a.start, a.end);
-
-                            // syntax highlight function name
-                            a.type                  = RZ_CODE_ANNOTATION_TYPE_SYNTAX_HIGHLIGHT;
-                            a.syntax_highlight.type = RZ_SYNTAX_HIGHLIGHT_TYPE_FUNCTION_NAME;
-                            rz_annotated_code_add_annotation (code, &a);
-
-                            if (name_beg + name_len < final_code.data + final_code.length) {
-                                name_beg = strstr (name_beg + name_len, function->name.data);
-                            } else {
-                                name_beg = NULL;
-                            }
-                        }
-                    });
-
-                    VecDeinit (&all_functions);
-                } else {
-                    code = rz_annotated_code_new (strdup ("/* empty */"));
-                }
-
-                StrDeinit (&final_code);
-
-                is_finished = true;
-                finished (code);
+        // Cached code is on screen already, replace it only if RevEngAI's version differs
+        RzAnnotatedCode *fresh = revalidate (fn_id, cached_text, request);
+        if (fresh && !deliver (fresh, request)) {
+            LOG_INFO ("Dropping outdated revalidation of function ID %llu", fn_id);
+        }
+    }
+}
 
-                AiDecompilationDeinit (&aidec);
-                return;
+void ReaiDec::serveRequests() {
+    while (true) {
+        RVA addr = 0;
+        u64 request = 0;
+        {
+            QMutexLocker locker (&lock);
+            while (!has_request && !stop_requested) {
+                wake.wait (&lock);
             }
-            default :
-                StrDeinit (&final_code);
-                LOG_FATAL ("Unreachable code reached. Invalid decompilation status = '%u'", status & STATUS_MASK);
+            if (stop_requested) {
+                is_busy = false;
                 return;
+            }
+
+            addr            = requested_addr;
+            request         = latest_request;
+            has_request     = false;
+            current_addr    = addr;
+            current_request = request;
+            is_busy         = true;
         }
-    }
-}
 
-class ReaiDecWorker : public QObject {
-    Q_OBJECT
-   public:
-    ReaiDec *dec;
-    RVA      rva_addr;
+        FunctionId       fn_id = 0;
+        QByteArray       cached_text;
+        RzAnnotatedCode *code = decompile (addr, &fn_id, &cached_text);
+
+        bool delivered = false;
+        {
+            QMutexLocker deliver_locker (&deliver_lock);
+            {
+                QMutexLocker locker (&lock);
+                is_busy   = false;
+                delivered = !stop_requested && current_request == latest_request;
+            }
 
-    explicit ReaiDecWorker (ReaiDec *d, RVA addr) : dec (d), rva_addr (addr) {}
+            if (delivered) {
+                finished (code);
+            }
+        }
 
-   public slots:
-    void doWork() {
-        dec->pollAndSignalFinished (rva_addr);
-        emit finished();
-    }
+        if (!delivered) {
+            LOG_INFO ("Dropping outdated decompilation @ 0x%llx", addr);
+            rz_annotated_code_free (code);
+            continue;
+        }
 
-   signals:
-    void finished();
-};
+        // Hand cached delivery to revalidation thread, replacing one it hasn't picked up yet
+        if (!cached_text.isEmpty()) {
+            QMutexLocker locker (&lock);
+            revalidate_fn_id   = fn_id;
+            revalidate_text    = cached_text;
+            revalidate_request = request;
+            has_revalidation   = true;
+            if (!revalidator) {
+                revalidator = QThread::create ([this]() { serveRevalidations(); });
+                revalidator->start();
+            }
+            revalidate_wake.wakeOne();
+        }
+    }
+}
 
+bool ReaiDec::isRunning() {
+    QMutexLocker locker (&lock);
+    return is_busy || has_request;
+}
 
 void ReaiDec::decompileAt (RVA rva_addr) {
     LOG_INFO ("decompile called @ 0x%llx", rva_addr);
 
-    QThread       *thread = new QThread;
-    ReaiDecWorker *worker = new ReaiDecWorker (this, rva_addr);
-
-    worker->moveToThread (thread);
+    QMutexLocker locker (&lock);
+
+    if (is_busy && current_addr == rva_addr) {
+        // Already decompiling this function, make it the one to deliver again
+        has_request    = false;
+        latest_request = current_request;
+    } else if (!(has_request && requested_addr == rva_addr)) {
+        // Replaces any request that's not picked up yet
+        requested_addr = rva_addr;
+        has_request    = true;
+        latest_request = ++request_count;
+    }
 
-    connect (thread, &QThread::started, worker, &ReaiDecWorker::doWork);
-    connect (worker, &ReaiDecWorker::finished, thread, &QThread::quit);
-    connect (worker, &ReaiDecWorker::finished, worker, &QObject::deleteLater);
-    connect (thread, &QThread::finished, thread, &QObject::deleteLater);
+    if (!worker) {
+        worker = QThread::create ([this]() { serveRequests(); });
+        worker->start();
+    }
 
-    thread->start();
+    wake.wakeOne();
 }
-
-#include "Decompiler.moc"
@@ -11,7 +11,15 @@
 // Cutter's decompiler interface
 #include <cutter/common/Decompiler.h>
 
-class ReaiDecWorker;
+// revengai
+#include <Reai/Types.h>
+
+// qt
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QThread>
+#include <QWaitCondition>
 
 /**
  * Cutter decompiler interface implementation for RevEngAI's
@@ -20,27 +28,99 @@ class ReaiDecWorker;
  * generated by AI.
  * */
 class ReaiDec : public Decompiler {
-    std::atomic<bool> is_finished = true;
-
    public:
     ReaiDec (QObject *parent = nullptr);
+    ~ReaiDec() override;
 
     /**
-     * Check whether the decompilation is finished. This will
-     * make an API call to RevEngAI servers to check whether the decompilation
-     * process is running on the server or not.
+     * Check whether a decompilation requested with `decompileAt` is still
+     * waiting to be delivered.
      * */
     bool isRunning() override;
 
     /**
      * Get's function at given address, gets corresponding function ID, and
      * then issues a decompilation request for function at given address.
+     *
+     * All requests are served by a single long-lived worker thread. Only the most
+     * recent request is delivered through `finished`. A request for the function
+     * that's already being decompiled is merged with it, and a request that's still
+     * waiting for RevEngAI is cancelled once user moves to another function.
+     *
+     * Cached decompilations are delivered right away, marked as cached, and then
+     * revalidated on a separate thread, so requests never wait behind it. `finished`
+     * is emitted again only if RevEngAI has a different version and user is still
+     * looking at same function.
      * */
     void decompileAt (RVA addr) override;
 
    private:
-    void pollAndSignalFinished (RVA rva_addr);
-    friend ReaiDecWorker;
+    /**
+     * Worker thread loop. Takes latest request, decompiles it and delivers result
+     * if no newer request arrived meanwhile.
+     * */
+    void serveRequests();
+
+    /**
+     * Runs on worker thread. RzCore is locked only while function at given
+     * address is looked up, waiting for RevEngAI happens without holding it.
+     *
+     * @param fn_id       : Set to function ID of decompiled function, if it's found.
+     * @param cached_text : Set to code without cache mark, if result came from cache.
+     * */
+    RzAnnotatedCode *decompile (RVA rva_addr, FunctionId *fn_id, QByteArray *cached_text);
+
+    /**
+     * Revalidation thread loop. Takes latest cached delivery and revalidates it.
+     * */
+    void serveRevalidations();
+
+    /**
+     * Runs on revalidation thread, after cached code of a function is delivered. Fetches
+     * completed decompilation from RevEngAI and updates cache if it changed. Never
+     * starts a new decompilation, and checks each function at most once in a while.
+     * Gives up before each request to RevEngAI once user moved to another function.
+     *
+     * @param request : Request number cached code was delivered for.
+     *
+     * @return New code if it differs from `cached_text`, `nullptr` otherwise.
+     * */
+    RzAnnotatedCode *revalidate (FunctionId fn_id, const QByteArray &cached_text, u64 request);
+
+    /**
+     * Emit `finished` with given code if `request` is still the one to deliver.
+     * Takes ownership of `code`.
+     * */
+    bool deliver (RzAnnotatedCode *code, u64 request);
+
+    static bool isRequestCancelled (void *self);
+    bool        isOutdated (u64 request);
+
+    QThread       *worker      = nullptr;
+    QThread       *revalidator = nullptr;
+    QMutex         lock;
+    QMutex         deliver_lock; ///< Makes checking whether a result is outdated and emitting it one step.
+    QWaitCondition wake;
+    QWaitCondition revalidate_wake;
+
+    // All of these are protected by `lock`
+    RVA  requested_addr  = 0;     ///< Address of request waiting to be picked up.
+    bool has_request     = false; ///< Whether `requested_addr` is valid.
+    RVA  current_addr    = 0;     ///< Address being decompiled by worker.
+    bool is_busy         = false; ///< Whether worker is decompiling `current_addr`.
+    u64  current_request = 0;     ///< Request number of decompilation in progress.
+    u64  latest_request  = 0;     ///< Request number whose result should be delivered.
+    u64  request_count   = 0;
+    bool stop_requested  = false;
+
+    // Latest cached delivery waiting to be revalidated, also protected by `lock`
+    FunctionId revalidate_fn_id   = 0;
+    QByteArray revalidate_text;
+    u64        revalidate_request = 0;
+    bool       has_revalidation   = false;
+
+    // Only used by revalidation thread
+    QHash<FunctionId, u64> revalidated_at; ///< Monotonic time (microseconds) of last revalidation.
 };
 
 #endif // REAI_PLUGIN_CUTTER_DECOMPILER_HPP
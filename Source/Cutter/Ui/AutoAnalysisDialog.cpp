@@ -250,41 +250,50 @@ void AutoAnalysisDialog::applyRenames (const QList<ProposedRename> &renames) {
         return;
     }
 
-    showProgress (0, "Applying function renames...");
+    showProgress (0, "Syncing function renames with RevEngAI...");
+
+    // Send whole rename set at once, then apply only the ones that went through locally
+    FunctionRenames batch = VecInitWithDeepCopy_T (&batch, NULL, FunctionRenameDeinit);
+    for (const ProposedRename &rename : renames) {
+        FunctionRename r = {};
+        r.function_id    = rename.functionId;
+        r.new_name       = StrInitFromZstr (rename.proposedName.toUtf8().constData());
+        VecPushBack (&batch, r);
+    }
 
-    int totalRenames = renames.size();
-    int appliedCount = 0;
-    int failedCount  = 0;
+    int appliedCount = BatchRenameFunctions (&batch);
+    int failedCount  = renames.size() - appliedCount;
+    if (appliedCount) {
+        InvalidateFunctionInfosCache (GetBinaryId());
+    }
 
-    for (int i = 0; i < renames.size(); ++i) {
-        const ProposedRename &rename = renames[i];
+    showProgress (80, "Renaming functions...");
 
-        showProgress (
-            (i * 100) / totalRenames,
-            QString ("Renaming %1 to %2...").arg (rename.originalName).arg (rename.proposedName)
-        );
+    QStringList failedRenames;
 
-        // Apply the rename via RevEngAI API
-        Str name = StrInitFromZstr (rename.proposedName.toUtf8().data());
-        if (RenameFunction (GetConnection(), rename.functionId, name)) {
-            Core()->renameFunction (rename.functionId, rename.proposedName);
-            appliedCount++;
+    // Already synced with RevEngAI, don't send these again through the rename hook
+    BeginRenameSyncSuppression();
+    for (int i = 0; i < renames.size(); ++i) {
+        const ProposedRename &rename = renames[i];
+        if (VecPtrAt (&batch, i)->synced) {
+            Core()->renameFunction (rename.address, rename.proposedName);
             LOG_INFO (
                 "Successfully renamed '%s' to '%s'",
                 rename.originalName.toStdString().c_str(),
                 rename.proposedName.toStdString().c_str()
             );
         } else {
-            failedCount++;
+            failedRenames << QString ("%1 -> %2").arg (rename.originalName).arg (rename.proposedName);
             LOG_ERROR (
                 "Failed to rename '%s' to '%s'",
                 rename.originalName.toStdString().c_str(),
                 rename.proposedName.toStdString().c_str()
             );
         }
-
-        StrDeinit (&name);
     }
+    EndRenameSyncSuppression();
+
+    VecDeinit (&batch);
 
     showProgress (100, "Refreshing UI...");
 
@@ -300,12 +309,19 @@ void AutoAnalysisDialog::applyRenames (const QList<ProposedRename> &renames) {
                 .arg (appliedCount);
         statusLabel->setText (QString ("Successfully renamed %1 functions").arg (appliedCount));
     } else {
+        // Don't make the message box taller than the screen on huge failures
+        QStringList shownFailures = failedRenames.mid (0, 20);
+        if (failedRenames.size() > shownFailures.size()) {
+            shownFailures << QString ("... and %1 more").arg (failedRenames.size() - shownFailures.size());
+        }
+
         message = QString (
-                      "Renamed %1 functions successfully, %2 failed.\n\nCheck the logs for details on failed "
-                      "renames.\nThe UI has been refreshed to show the updated function names."
+                      "Renamed %1 functions successfully, %2 failed.\n\nFailed renames:\n%3\n\nCheck the logs for "
+                      "details on failed renames.\nThe UI has been refreshed to show the updated function names."
         )
                       .arg (appliedCount)
-                      .arg (failedCount);
+                      .arg (failedCount)
+                      .arg (shownFailures.join ("\n"));
         statusLabel->setText (QString ("Renamed %1 functions (%2 failed)").arg (appliedCount).arg (failedCount));
     }
 
@@ -373,11 +389,15 @@ void AutoAnalysisWorker::performAnalysis (const AutoAnalysisRequest &request) {
             return;
         }
 
+        // Group matches by source function once, instead of scanning all matches per function
+        AnnSymbolIndex bestMatches;
+        AnnSymbolIndexInit (&bestMatches, &map);
+
         emitProgress (40, "Getting function information...");
 
-        // Get RevEngAI functions for lookup
-        FunctionInfos revengaiFunctions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), binaryId);
-        if (!revengaiFunctions.length) {
+        // Builds function ID index on this worker thread if no lookup has built it yet
+        if (!LoadFunctionIndex (binaryId, false)) {
+            AnnSymbolIndexDeinit (&bestMatches);
             VecDeinit (&map);
             emit analysisError ("Failed to get function info list from RevEng.AI servers.");
             return;
@@ -391,8 +411,8 @@ void AutoAnalysisWorker::performAnalysis (const AutoAnalysisRequest &request) {
 
         for (const FunctionDescription &fn : request.functions) {
             if (m_cancelled) {
+                AnnSymbolIndexDeinit (&bestMatches);
                 VecDeinit (&map);
-                VecDeinit (&revengaiFunctions);
                 emit analysisError ("Analysis cancelled");
                 return;
             }
@@ -404,9 +424,9 @@ void AutoAnalysisWorker::performAnalysis (const AutoAnalysisRequest &request) {
                 QString ("Processing function %1/%2: %3").arg (processedFunctions).arg (totalFunctions).arg (fn.name)
             );
 
-            FunctionId id = lookupFunctionId (request.functions, fn, revengaiFunctions, request.baseAddr);
+            FunctionId id = lookupFunctionId (fn, binaryId, request.baseAddr);
             if (id) {
-                AnnSymbol *bestMatch = rzGetMostSimilarFunctionSymbol (&map, id);
+                AnnSymbol *bestMatch = AnnSymbolIndexGetBest (&bestMatches, id);
                 if (bestMatch) {
                     // Create proposed rename instead of applying immediately
                     ProposedRename rename;
@@ -429,8 +449,8 @@ void AutoAnalysisWorker::performAnalysis (const AutoAnalysisRequest &request) {
             }
         }
 
+        AnnSymbolIndexDeinit (&bestMatches);
         VecDeinit (&map);
-        VecDeinit (&revengaiFunctions);
 
         emitProgress (100, "Analysis completed");
 
@@ -445,30 +465,20 @@ void AutoAnalysisWorker::performAnalysis (const AutoAnalysisRequest &request) {
 
 // Custom function ID lookup that works with FunctionDescription
 FunctionId AutoAnalysisWorker::lookupFunctionId (
-    const QList<FunctionDescription> &cutterFunctions,
-    const FunctionDescription        &targetFunction,
-    const FunctionInfos              &revengaiFunctions,
-    u64                               baseAddr
+    const FunctionDescription &targetFunction,
+    BinaryId                   binaryId,
+    u64                        baseAddr
 ) {
-    // Look up the function ID by matching addresses
-    // targetFunction.offset is the virtual address in Cutter
-    u64 targetAddr = targetFunction.offset;
-
-    FunctionId id = 0;
-    VecForeachPtr (&revengaiFunctions, fn, {
-        // fn->symbol.value.addr is the RevEngAI function address (without base)
-        // Add base address to match with Cutter's virtual address
-        if (targetAddr == fn->symbol.value.addr + baseAddr) {
-            LOG_INFO (
-                "CutterFunction -> [FunctionName, FunctionID] :: \"%s\" -> [\"%s\", %llu]",
-                targetFunction.name.toStdString().c_str(),
-                fn->symbol.name.data,
-                fn->id
-            );
-            id = fn->id;
-            break;
-        }
-    });
+    // targetFunction.offset is the virtual address in Cutter, RevEngAI stores it without base address
+    u64        targetAddr = targetFunction.offset;
+    FunctionId id         = GetFunctionIdForOffset (binaryId, targetAddr - baseAddr);
+    if (id) {
+        LOG_INFO (
+            "CutterFunction -> FunctionID :: \"%s\" -> %llu",
+            targetFunction.name.toStdString().c_str(),
+            id
+        );
+    }
 
     if (!id) {
         LOG_ERROR (
@@ -121,12 +121,7 @@ class AutoAnalysisWorker : public QObject {
     }
 
     // Custom function ID lookup that works with FunctionDescription
-    FunctionId lookupFunctionId (
-        const QList<FunctionDescription> &cutterFunctions,
-        const FunctionDescription        &targetFunction,
-        const FunctionInfos              &revengaiFunctions,
-        u64                               baseAddr
-    );
+    FunctionId lookupFunctionId (const FunctionDescription &targetFunction, BinaryId binaryId, u64 baseAddr);
 };
 
 #endif // REAI_PLUGIN_CUTTER_UI_AUTO_ANALYSIS_DIALOG_HPP
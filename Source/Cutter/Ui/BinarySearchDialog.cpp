@@ -16,6 +16,7 @@
 #include <QUrl>
 #include <QLabel>
 #include <QMessageBox>
+#include <QTimer>
 
 /* cutter */
 #include <Reai/Util/Str.h>
@@ -63,8 +64,7 @@ BinarySearchDialog::BinarySearchDialog (QWidget* parent, bool openPageOnDoubleCl
     modelNameSelector->setPlaceholderText ("any model");
     modelNameSelector->setToolTip ("Model used to perform analysis");
 
-    ModelInfos* models = GetModels();
-    VecForeachPtr (models, model, { modelNameSelector->addItem (model->name.data); });
+    loadModels();
 
     l->addWidget (n, 2, 0);
     l->addWidget (modelNameSelector, 2, 1);
@@ -107,6 +107,20 @@ BinarySearchDialog::BinarySearchDialog (QWidget* parent, bool openPageOnDoubleCl
     connect (cancelButton, &QPushButton::clicked, this, &BinarySearchDialog::cancelAsyncOperation);
 }
 
+void BinarySearchDialog::loadModels() {
+    // Served from last known list without waiting for network.
+    // On first run list may still be on it's way, so check back until it arrives.
+    ModelInfos* models = GetModels();
+    if (!models->length && IsModelsRefreshPending()) {
+        modelNameSelector->setPlaceholderText ("loading models...");
+        QTimer::singleShot (500, this, &BinarySearchDialog::loadModels);
+        return;
+    }
+
+    modelNameSelector->setPlaceholderText ("any model");
+    VecForeachPtr (models, model, { modelNameSelector->addItem (model->name.data); });
+}
+
 BinarySearchDialog::~BinarySearchDialog() {
     if (worker) {
         worker->cancel();
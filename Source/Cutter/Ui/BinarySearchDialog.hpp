@@ -45,6 +45,7 @@ class BinarySearchDialog : public QDialog {
     void onSearchFinished (const BinaryInfos &binaries);
     void onSearchError (const QString &error);
     void cancelAsyncOperation();
+    void loadModels();
 
    private:
     void addNewRowToResultsTable (QTableWidget *t, const QStringList &row);
@@ -16,6 +16,7 @@
 #include <QUrl>
 #include <QLabel>
 #include <QMessageBox>
+#include <QTimer>
 
 /* cutter */
 #include <cutter/core/Cutter.h>
@@ -70,8 +71,7 @@ CollectionSearchDialog::CollectionSearchDialog (QWidget* parent, bool openPageOn
     modelNameSelector->setPlaceholderText ("any model");
     modelNameSelector->setToolTip ("Model used to analyze the binaries in collection");
 
-    ModelInfos* models = GetModels();
-    VecForeachPtr (models, model, { modelNameSelector->addItem (model->name.data); });
+    loadModels();
 
     l->addWidget (n, 3, 0);
     l->addWidget (modelNameSelector, 3, 1);
@@ -113,6 +113,20 @@ CollectionSearchDialog::CollectionSearchDialog (QWidget* parent, bool openPageOn
     connect (cancelButton, &QPushButton::clicked, this, &CollectionSearchDialog::cancelAsyncOperation);
 }
 
+void CollectionSearchDialog::loadModels() {
+    // Served from last known list without waiting for network.
+    // On first run list may still be on it's way, so check back until it arrives.
+    ModelInfos* models = GetModels();
+    if (!models->length && IsModelsRefreshPending()) {
+        modelNameSelector->setPlaceholderText ("loading models...");
+        QTimer::singleShot (500, this, &CollectionSearchDialog::loadModels);
+        return;
+    }
+
+    modelNameSelector->setPlaceholderText ("any model");
+    VecForeachPtr (models, model, { modelNameSelector->addItem (model->name.data); });
+}
+
 CollectionSearchDialog::~CollectionSearchDialog() {
     if (worker) {
         worker->cancel();
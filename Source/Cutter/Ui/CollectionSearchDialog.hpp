@@ -45,6 +45,7 @@ class CollectionSearchDialog : public QDialog {
     void onSearchFinished (const CollectionInfos &collections);
     void onSearchError (const QString &error);
     void cancelAsyncOperation();
+    void loadModels();
 
    private:
     void addNewRowToResultsTable (QTableWidget *t, const QStringList &row);
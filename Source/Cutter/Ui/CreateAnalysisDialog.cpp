@@ -12,6 +12,7 @@
 #include <QLabel>
 #include <QMessageBox>
 #include <QThread>
+#include <QTimer>
 
 /* cutter */
 #include <cutter/core/Cutter.h>
@@ -40,10 +41,7 @@ CreateAnalysisDialog::CreateAnalysisDialog (QWidget* parent)
 
     aiModelInput = new QComboBox (this);
     aiModelInput->setPlaceholderText ("AI Model");
-
-    // Load models (this could also be made async, but it's usually fast)
-    ModelInfos* models = GetModels();
-    VecForeachPtr (models, model, { aiModelInput->addItem (model->name.data); });
+    loadModels();
 
     mainLayout->addWidget (aiModelInput);
 
@@ -84,6 +82,20 @@ CreateAnalysisDialog::~CreateAnalysisDialog() {
     cancelAsyncCreateAnalysis();
 }
 
+void CreateAnalysisDialog::loadModels() {
+    // Served from last known list without waiting for network.
+    // On first run list may still be on it's way, so check back until it arrives.
+    ModelInfos* models = GetModels();
+    if (!models->length && IsModelsRefreshPending()) {
+        aiModelInput->setPlaceholderText ("Loading AI models...");
+        QTimer::singleShot (500, this, &CreateAnalysisDialog::loadModels);
+        return;
+    }
+
+    aiModelInput->setPlaceholderText ("AI Model");
+    VecForeachPtr (models, model, { aiModelInput->addItem (model->name.data); });
+}
+
 void CreateAnalysisDialog::on_CreateAnalysis() {
     rzClearMsg();
 
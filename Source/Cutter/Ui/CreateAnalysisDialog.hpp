@@ -84,6 +84,7 @@ class CreateAnalysisDialog : public QDialog {
     void onAnalysisProgress (int percentage, const QString& message);
     void onAnalysisFinished (const CreateAnalysisResult& result);
     void onAnalysisError (const QString& error);
+    void loadModels();
 
    private:
     QVBoxLayout* mainLayout;
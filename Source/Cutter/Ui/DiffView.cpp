@@ -0,0 +1,187 @@
+/**
+ * @file      : DiffView.cpp
+ * @author    : agent (agent@local)
+ * @date      : 16th October 2026
+ * @copyright : Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* qt */
+#include <QEvent>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QScrollBar>
+
+/* plugin */
+#include <Cutter/Ui/DiffView.hpp>
+
+// Gap between panel border and text
+#define DIFF_VIEW_MARGIN 4
+
+DiffView::DiffView (Side side, QWidget *parent)
+    : QAbstractScrollArea (parent), side (side), diff (nullptr), maxRowLength (0) {
+    setHorizontalScrollBarPolicy (Qt::ScrollBarAsNeeded);
+    setVerticalScrollBarPolicy (Qt::ScrollBarAsNeeded);
+    viewport()->setBackgroundRole (QPalette::Base);
+    viewport()->setAutoFillBackground (true);
+}
+
+void DiffView::setDiff (const DiffLines *newDiff) {
+    diff         = newDiff;
+    maxRowLength = 0;
+
+    // Only lengths are looked at here, text of a row is converted when it's painted
+    if (diff) {
+        VecForeachPtr (diff, line, {
+            u64 length = 0;
+            switch (line->type) {
+                case DIFF_TYPE_SAM :
+                    length = line->sam.content.length;
+                    break;
+                case DIFF_TYPE_ADD :
+                    length = side == TARGET ? line->add.content.length : 0;
+                    break;
+                case DIFF_TYPE_REM :
+                    length = side == SOURCE ? line->rem.content.length : 0;
+                    break;
+                case DIFF_TYPE_MOD :
+                    length = side == SOURCE ? line->mod.old_content.length : line->mod.new_content.length;
+                    break;
+                case DIFF_TYPE_MOV :
+                    length = side == SOURCE ? line->mov.old_content.length : line->mov.new_content.length;
+                    break;
+                default :
+                    break;
+            }
+            maxRowLength = qMax (maxRowLength, length);
+        });
+    }
+
+    verticalScrollBar()->setValue (0);
+    horizontalScrollBar()->setValue (0);
+    updateScrollBars();
+    viewport()->update();
+}
+
+void DiffView::clear() {
+    setDiff (nullptr);
+}
+
+void DiffView::setPlaceholderText (const QString &text) {
+    placeholderText = text;
+    viewport()->update();
+}
+
+void DiffView::updateScrollBars() {
+    QFontMetrics fm (font());
+    int          lineHeight  = qMax (1, fm.height());
+    int          visibleRows = qMax (1, viewport()->height() / lineHeight);
+    int          rows        = diff ? (int)diff->length : 0;
+
+    // Vertical scroll is in rows, so first visible row is just scroll bar value
+    verticalScrollBar()->setRange (0, qMax (0, rows - visibleRows));
+    verticalScrollBar()->setPageStep (visibleRows);
+    verticalScrollBar()->setSingleStep (1);
+
+    // Font is monospace, widest row is longest row
+    int contentWidth = (int)maxRowLength * fm.horizontalAdvance (QLatin1Char ('M')) + 2 * DIFF_VIEW_MARGIN;
+    horizontalScrollBar()->setRange (0, qMax (0, contentWidth - viewport()->width()));
+    horizontalScrollBar()->setPageStep (viewport()->width());
+    horizontalScrollBar()->setSingleStep (fm.horizontalAdvance (QLatin1Char ('M')));
+}
+
+QString DiffView::rowText (u64 row, DiffType *type) const {
+    const DiffLine *line = VecPtrAt (diff, row);
+    const Str      *text = nullptr;
+
+    *type = line->type;
+    switch (line->type) {
+        case DIFF_TYPE_SAM :
+            text = &line->sam.content;
+            break;
+        case DIFF_TYPE_ADD :
+            text = side == TARGET ? &line->add.content : nullptr;
+            break;
+        case DIFF_TYPE_REM :
+            text = side == SOURCE ? &line->rem.content : nullptr;
+            break;
+        case DIFF_TYPE_MOD :
+            text = side == SOURCE ? &line->mod.old_content : &line->mod.new_content;
+            break;
+        case DIFF_TYPE_MOV :
+            text = side == SOURCE ? &line->mov.old_content : &line->mov.new_content;
+            break;
+        default :
+            break;
+    }
+
+    // Blank row keeps both sides aligned
+    if (!text || !text->length) {
+        return QString();
+    }
+
+    QString s = QString::fromUtf8 (text->data, (int)text->length);
+    s.replace (QLatin1Char ('\t'), QLatin1String ("    "));
+    return s;
+}
+
+// Same colours as text based renderer used before
+QColor DiffView::colorForDiffType (DiffType type) const {
+    static const QColor sourceColors[] = {QColor(), QColor(), QColor ("red"), QColor ("orange"), QColor ("purple")};
+    static const QColor targetColors[] = {QColor(), QColor ("green"), QColor(), QColor ("blue"), QColor ("purple")};
+
+    if ((int)type < 0 || (int)type > DIFF_TYPE_MOV) {
+        return QColor();
+    }
+    return side == SOURCE ? sourceColors[type] : targetColors[type];
+}
+
+void DiffView::paintEvent (QPaintEvent *event) {
+    Q_UNUSED (event);
+
+    QPainter     painter (viewport());
+    QFontMetrics fm (font());
+    QColor       defaultColor = palette().color (QPalette::Text);
+    painter.setFont (font());
+
+    if (!diff || !diff->length) {
+        if (!placeholderText.isEmpty()) {
+            painter.setPen (palette().color (QPalette::Disabled, QPalette::Text));
+            painter.drawText (
+                viewport()->rect().adjusted (DIFF_VIEW_MARGIN, DIFF_VIEW_MARGIN, -DIFF_VIEW_MARGIN, 0),
+                Qt::AlignLeft | Qt::AlignTop | Qt::TextWordWrap,
+                placeholderText
+            );
+        }
+        return;
+    }
+
+    int lineHeight = qMax (1, fm.height());
+    u64 firstRow   = (u64)verticalScrollBar()->value();
+    u64 rowCount   = (u64)(viewport()->height() / lineHeight + 1);
+    int x          = DIFF_VIEW_MARGIN - horizontalScrollBar()->value();
+
+    for (u64 i = 0; i < rowCount && firstRow + i < diff->length; i++) {
+        DiffType type;
+        QString  text = rowText (firstRow + i, &type);
+        if (text.isEmpty()) {
+            continue;
+        }
+
+        QColor color = colorForDiffType (type);
+        painter.setPen (color.isValid() ? color : defaultColor);
+        painter.drawText (x, (int)i * lineHeight + fm.ascent(), text);
+    }
+}
+
+void DiffView::resizeEvent (QResizeEvent *event) {
+    QAbstractScrollArea::resizeEvent (event);
+    updateScrollBars();
+}
+
+void DiffView::changeEvent (QEvent *event) {
+    QAbstractScrollArea::changeEvent (event);
+    if (event->type() == QEvent::FontChange) {
+        updateScrollBars();
+        viewport()->update();
+    }
+}
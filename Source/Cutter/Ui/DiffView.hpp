@@ -0,0 +1,55 @@
+/**
+ * @file      : DiffView.hpp
+ * @author    : agent (agent@local)
+ * @date      : 16th October 2026
+ * @copyright : Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+#ifndef REAI_PLUGIN_CUTTER_UI_DIFF_VIEW_HPP
+#define REAI_PLUGIN_CUTTER_UI_DIFF_VIEW_HPP
+
+/* qt */
+#include <QAbstractScrollArea>
+#include <QColor>
+#include <QString>
+
+/* reai */
+#include <Reai/Diff.h>
+
+// One side of a side by side diff. Keeps a pointer to diff lines and paints only rows that are
+// visible, so showing or scrolling a diff of thousands of lines costs as much as a few dozen.
+// All rows have same height, one row per diff line, so both sides of a diff line up row by row.
+class DiffView : public QAbstractScrollArea {
+    Q_OBJECT
+
+   public:
+    enum Side {
+        SOURCE, // Shows old content, blank rows for additions
+        TARGET  // Shows new content, blank rows for removals
+    };
+
+    explicit DiffView (Side side, QWidget *parent = nullptr);
+
+    // Show a diff. Diff is not copied and must outlive view, or be replaced before it's freed.
+    void setDiff (const DiffLines *diff);
+    void clear();
+
+    void setPlaceholderText (const QString &text);
+
+   protected:
+    void paintEvent (QPaintEvent *event) override;
+    void resizeEvent (QResizeEvent *event) override;
+    void changeEvent (QEvent *event) override;
+
+   private:
+    void    updateScrollBars();
+    QString rowText (u64 row, DiffType *type) const;
+    QColor  colorForDiffType (DiffType type) const;
+
+    Side             side;
+    const DiffLines *diff;
+    u64              maxRowLength; // Longest row in characters, for horizontal scroll range
+    QString          placeholderText;
+};
+
+#endif // REAI_PLUGIN_CUTTER_UI_DIFF_VIEW_HPP
@@ -10,6 +10,7 @@
 #include <QMessageBox>
 #include <QApplication>
 #include <QScrollArea>
+#include <QScrollBar>
 #include <QDebug>
 #include <QStringListModel>
 
@@ -19,6 +20,9 @@
 
 /* reai */
 #include <Plugin.h>
+#include <Cache.h>
+#include <DiffCache.h>
+#include <JobWaiter.h>
 #include <Reai/Api.h>
 #include <Reai/Log.h>
 #include <Reai/Diff.h>
@@ -36,7 +40,7 @@ InteractiveDiffWidget::InteractiveDiffWidget (MainWindow *main)
     // Initialize string containers
     sourceDisassembly   = StrInit();
     sourceDecompilation = StrInit();
-    currentDiffLines    = VecInit();
+    currentDiffLines    = nullptr;
 
     // Initialize async components
     searchWorker        = nullptr;
@@ -95,7 +99,8 @@ InteractiveDiffWidget::~InteractiveDiffWidget() {
     // Clean up string containers
     StrDeinit (&sourceDisassembly);
     StrDeinit (&sourceDecompilation);
-    VecDeinit (&currentDiffLines);
+    clearPanels();
+    DiffCacheRelease (currentDiffLines);
 }
 
 void InteractiveDiffWidget::setupUI() {
@@ -139,16 +144,14 @@ void InteractiveDiffWidget::setupThreePanelLayout() {
     functionListPanel->sortByColumn (2, Qt::DescendingOrder); // Sort by similarity desc
 
     // Middle panel: Source diff
-    sourceDiffPanel = new QTextEdit();
-    sourceDiffPanel->setReadOnly (true);
+    sourceDiffPanel = new DiffView (DiffView::SOURCE);
     sourceDiffPanel->setFont (QFont ("Consolas", 10));
     sourceDiffPanel->setPlaceholderText ("Source function disassembly will appear here...");
     sourceDiffPanel->setMinimumWidth (150);
     sourceDiffPanel->setSizePolicy (QSizePolicy::Expanding, QSizePolicy::Expanding);
 
     // Right panel: Target diff
-    targetDiffPanel = new QTextEdit();
-    targetDiffPanel->setReadOnly (true);
+    targetDiffPanel = new DiffView (DiffView::TARGET);
     targetDiffPanel->setFont (QFont ("Consolas", 10));
     targetDiffPanel->setPlaceholderText ("Target function disassembly will appear here...");
     targetDiffPanel->setMinimumWidth (150);
@@ -167,6 +170,20 @@ void InteractiveDiffWidget::setupThreePanelLayout() {
 
     // Make splitter collapsible for better flexibility
     mainSplitter->setChildrenCollapsible (true);
+
+    // Rows of both sides belong to same diff lines, keep them scrolled together
+    connect (
+        sourceDiffPanel->verticalScrollBar(),
+        &QScrollBar::valueChanged,
+        targetDiffPanel->verticalScrollBar(),
+        &QScrollBar::setValue
+    );
+    connect (
+        targetDiffPanel->verticalScrollBar(),
+        &QScrollBar::valueChanged,
+        sourceDiffPanel->verticalScrollBar(),
+        &QScrollBar::setValue
+    );
 }
 
 void InteractiveDiffWidget::setupControlsArea() {
@@ -210,6 +227,11 @@ void InteractiveDiffWidget::setupControlsArea() {
     toggleButton->setCheckable (true);
     toggleButton->setChecked (false); // Default to assembly
 
+    // Operand normalization for assembly diff
+    normalizeCheckBox = new QCheckBox ("Normalize operands");
+    normalizeCheckBox->setChecked (true);
+    normalizeCheckBox->setToolTip ("Ignore addresses, immediates, stack offsets and block labels when matching lines");
+
     // Status label
     statusLabel = new QLabel ("Ready");
     statusLabel->setStyleSheet ("color: gray; font-style: italic;");
@@ -237,6 +259,7 @@ void InteractiveDiffWidget::setupControlsArea() {
     controlsLayout->addWidget (renameButton);
     controlsLayout->addSpacing (10);
     controlsLayout->addWidget (toggleButton);
+    controlsLayout->addWidget (normalizeCheckBox);
     controlsLayout->addStretch(); // Push status to right
     controlsLayout->addWidget (progressBar);
     controlsLayout->addWidget (cancelButton);
@@ -259,6 +282,7 @@ void InteractiveDiffWidget::connectSignals() {
 
     // Toggle button
     connect (toggleButton, &QPushButton::toggled, this, &InteractiveDiffWidget::onToggleRequested);
+    connect (normalizeCheckBox, &QCheckBox::toggled, this, &InteractiveDiffWidget::onNormalizeToggled);
 
     // Cancel button
     connect (cancelButton, &QPushButton::clicked, this, &InteractiveDiffWidget::cancelAsyncSearch);
@@ -481,7 +505,9 @@ void InteractiveDiffWidget::updateDiffPanels() {
     showLoadingState ("Generating diff...");
 
     // Generate diff between source and target based on mode
-    VecDeinit (&currentDiffLines);
+    clearPanels();
+    DiffCacheRelease (currentDiffLines);
+    currentDiffLines = nullptr;
 
     if (isDecompilationMode) {
         // Check if decompilation is available for both functions
@@ -493,7 +519,7 @@ void InteractiveDiffWidget::updateDiffPanels() {
             return;
         }
         // Use decompilation content
-        currentDiffLines = GetDiff (&sourceDecompilation, &targetFunc.decompilation);
+        currentDiffLines = DiffCacheAcquire (&sourceDecompilation, &targetFunc.decompilation, DIFF_MODE_DECOMPILATION);
     } else {
         // Check if disassembly is available for both functions
         if (sourceDisassembly.length == 0 || targetFunc.disassembly.length == 0) {
@@ -502,17 +528,19 @@ void InteractiveDiffWidget::updateDiffPanels() {
             return;
         }
         // Use assembly content (original behavior)
-        currentDiffLines = GetDiff (&sourceDisassembly, &targetFunc.disassembly);
+        currentDiffLines = DiffCacheAcquire (&sourceDisassembly, &targetFunc.disassembly, assemblyDiffMode());
     }
 
-    if (currentDiffLines.length == 0) {
+    prefetchNeighbourDiffs();
+
+    if (currentDiffLines->length == 0) {
         showErrorState ("Failed to generate diff");
         return;
     }
 
     // Render diff in both panels
-    renderSourceDiff (currentDiffLines);
-    renderTargetDiff (currentDiffLines);
+    renderSourceDiff (*currentDiffLines);
+    renderTargetDiff (*currentDiffLines);
 
     QString mode = isDecompilationMode ? "decompilation" : "assembly";
     updateStatusLabel (QString ("Showing %1 diff with %2 (%3%)")
@@ -521,101 +549,30 @@ void InteractiveDiffWidget::updateDiffPanels() {
                            .arg (targetFunc.similarity, 0, 'f', 1));
 }
 
-void InteractiveDiffWidget::renderSourceDiff (const DiffLines &diff) {
-    sourceDiffPanel->clear();
-    QTextCursor cursor (sourceDiffPanel->document());
-
-    VecForeachPtr (&diff, line, {
-        QString text;
-        QString color = getColorForDiffType (line->type, true);
-
-        switch (line->type) {
-            case DIFF_TYPE_SAM :
-                text = QString::fromUtf8 (line->sam.content.data);
-                break;
-            case DIFF_TYPE_REM :
-                text = QString::fromUtf8 (line->rem.content.data);
-                break;
-            case DIFF_TYPE_MOD :
-                text = QString::fromUtf8 (line->mod.old_content.data);
-                break;
-            case DIFF_TYPE_MOV :
-                text = QString::fromUtf8 (line->mov.old_content.data);
-                break;
-            case DIFF_TYPE_ADD :
-                text = ""; // Empty line for additions
-                break;
-            default :
-                continue;
+void InteractiveDiffWidget::prefetchNeighbourDiffs() {
+    // Functions above and below selected one in list are most likely to be viewed next
+    for (int idx = currentSelectedIndex - 1; idx <= currentSelectedIndex + 1; idx += 2) {
+        if (idx < 0 || idx >= similarFunctions.size()) {
+            continue;
         }
 
-        if (!color.isEmpty()) {
-            cursor.insertHtml (
-                QString ("<span style='color: %1'>%2</span><br>").arg (color).arg (text.toHtmlEscaped())
-            );
-        } else {
-            cursor.insertText (text + "\n");
+        const SimilarFunctionData &func = similarFunctions[idx];
+        if (isDecompilationMode) {
+            if (sourceHasDecompilation && func.hasDecompilation) {
+                DiffCachePrefetch (&sourceDecompilation, &func.decompilation, DIFF_MODE_DECOMPILATION);
+            }
+        } else if (sourceDisassembly.length && func.disassembly.length) {
+            DiffCachePrefetch (&sourceDisassembly, &func.disassembly, assemblyDiffMode());
         }
-    });
-
-    sourceDiffPanel->setTextCursor (cursor);
+    }
 }
 
-void InteractiveDiffWidget::renderTargetDiff (const DiffLines &diff) {
-    targetDiffPanel->clear();
-    QTextCursor cursor (targetDiffPanel->document());
-
-    VecForeachPtr (&diff, line, {
-        QString text;
-        QString color = getColorForDiffType (line->type, false);
-
-        switch (line->type) {
-            case DIFF_TYPE_SAM :
-                text = QString::fromUtf8 (line->sam.content.data);
-                break;
-            case DIFF_TYPE_ADD :
-                text = QString::fromUtf8 (line->add.content.data);
-                break;
-            case DIFF_TYPE_MOD :
-                text = QString::fromUtf8 (line->mod.new_content.data);
-                break;
-            case DIFF_TYPE_MOV :
-                text = QString::fromUtf8 (line->mov.new_content.data);
-                break;
-            case DIFF_TYPE_REM :
-                text = ""; // Empty line for removals
-                break;
-            default :
-                continue;
-        }
-
-        if (!color.isEmpty()) {
-            cursor.insertHtml (
-                QString ("<span style='color: %1'>%2</span><br>").arg (color).arg (text.toHtmlEscaped())
-            );
-        } else {
-            cursor.insertText (text + "\n");
-        }
-    });
-
-    targetDiffPanel->setTextCursor (cursor);
+void InteractiveDiffWidget::renderSourceDiff (const DiffLines &diff) {
+    sourceDiffPanel->setDiff (&diff);
 }
 
-QString InteractiveDiffWidget::getColorForDiffType (DiffType type, bool isSource) {
-    switch (type) {
-        case DIFF_TYPE_SAM :
-            return ""; // Default color
-        case DIFF_TYPE_ADD :
-            return isSource ? "" : "green";
-        case DIFF_TYPE_REM :
-            return isSource ? "red" : "";
-        case DIFF_TYPE_MOD :
-            return isSource ? "orange" : "blue";
-        case DIFF_TYPE_MOV :
-            return isSource ? "purple" : "purple";
-        default :
-            return "";
-    }
+void InteractiveDiffWidget::renderTargetDiff (const DiffLines &diff) {
+    targetDiffPanel->setDiff (&diff);
 }
 
 void InteractiveDiffWidget::showLoadingState (const QString &message) {
@@ -640,9 +597,15 @@ void InteractiveDiffWidget::updateStatusLabel (const QString &status) {
 }
 
 Str InteractiveDiffWidget::getFunctionDisassembly (FunctionId functionId) {
+    Str linear_disasm = StrInit();
+
+    // Same format as CmdHandlers.c, so cache entries are shared with Rizin plugin
+    if (CacheGetStr (CACHE_KIND_LINEAR_DISASM, functionId, NULL, &linear_disasm)) {
+        return linear_disasm;
+    }
+
     // Get the control flow graph for this function (reusing CmdHandlers.c logic)
-    ControlFlowGraph cfg           = GetFunctionControlFlowGraph (GetConnection(), functionId);
-    Str              linear_disasm = StrInit();
+    ControlFlowGraph cfg = GetFunctionControlFlowGraph (GetConnection(), functionId);
 
     if (cfg.blocks.length == 0) {
         LOG_ERROR ("No blocks found in control flow graph for function ID %llu", functionId);
@@ -699,12 +662,19 @@ Str InteractiveDiffWidget::getFunctionDisassembly (FunctionId functionId) {
     // Replace all tab characters with four spaces
     StrReplaceZstr (&linear_disasm, "\t", "    ", -1);
 
+    CachePutStr (CACHE_KIND_LINEAR_DISASM, functionId, NULL, &linear_disasm);
+
     return linear_disasm;
 }
 
 Str InteractiveDiffWidget::getFunctionDecompilation (FunctionId functionId) {
     Str final_code = StrInit();
 
+    // Only completed decompilations are cached, anything else needs a status check
+    if (CacheGetStr (CACHE_KIND_DECOMPILATION, functionId, NULL, &final_code)) {
+        return final_code;
+    }
+
     // Check decompilation status
     Status status = GetAiDecompilationStatus (GetConnection(), functionId);
 
@@ -727,6 +697,10 @@ Str InteractiveDiffWidget::getFunctionDecompilation (FunctionId functionId) {
         AiDecompilation aidec = GetAiDecompilation (GetConnection(), functionId, true);
         final_code            = StrDup (&aidec.decompilation);
         AiDecompilationDeinit (&aidec);
+
+        if (final_code.length) {
+            CachePutStr (CACHE_KIND_DECOMPILATION, functionId, NULL, &final_code);
+        }
     }
 
     return final_code;
@@ -734,6 +708,7 @@ Str InteractiveDiffWidget::getFunctionDecompilation (FunctionId functionId) {
 
 void InteractiveDiffWidget::onToggleRequested() {
     isDecompilationMode = toggleButton->isChecked();
+    normalizeCheckBox->setEnabled (!isDecompilationMode);
 
     if (isDecompilationMode) {
         toggleButton->setText ("Show Assembly");
@@ -753,6 +728,16 @@ void InteractiveDiffWidget::onToggleRequested() {
     }
 }
 
+void InteractiveDiffWidget::onNormalizeToggled() {
+    if (!isDecompilationMode && currentSelectedIndex >= 0) {
+        updateDiffPanels();
+    }
+}
+
+DiffMode InteractiveDiffWidget::assemblyDiffMode() const {
+    return normalizeCheckBox->isChecked() ? DIFF_MODE_ASSEMBLY_NORMALIZED : DIFF_MODE_ASSEMBLY;
+}
+
 // Note: fetchDecompilationForCurrentSelection and fetchDecompilationForFunction
 // have been replaced with async versions startAsyncDecompilation() and the
 // DecompilationWorker class to prevent UI freezing
@@ -789,14 +774,18 @@ void InteractiveDiffWidget::onRenameRequested() {
         return;
     }
 
-    // Rename the function
+    // Rename the function, RevEngAI is updated explicitly below so skip the rename hook
+    BeginRenameSyncSuppression();
     bool success = rz_analysis_function_rename (func, targetFunc.name.toUtf8().constData());
+    EndRenameSyncSuppression();
 
     FunctionId fn_id = rzLookupFunctionIdForFunctionWithName (core, targetFunc.name.toUtf8().constData());
     if (fn_id) {
         Str new_name = StrInit();
         StrPushBackZstr (&new_name, targetFunc.name.toUtf8().constData());
-        RenameFunction (GetConnection(), fn_id, new_name);
+        if (RenameFunction (GetConnection(), fn_id, new_name)) {
+            InvalidateFunctionInfosCache (GetBinaryIdFromCore (core));
+        }
         StrDeinit (&new_name);
     } else {
         QMessageBox::critical (this, "Error", "Failed to rename function : Function not found in RevEngAI analysis");
@@ -1014,7 +1003,7 @@ void SimilarFunctionsWorker::performSearch (const SimilarFunctionsWorker::Search
         }
 
         // Make the actual API call
-        SimilarFunctions similar_functions = GetSimilarFunctions (GetConnection(), &search);
+        SimilarFunctions similar_functions = GetSimilarFunctionsCached (&search);
         SimilarFunctionsRequestDeinit (&search);
 
         if (similar_functions.length == 0) {
@@ -1378,6 +1367,10 @@ void InteractiveDiffWidget::onDisassemblyError (const QString &error) {
 }
 
 // DecompilationWorker implementation
+
+// Maximum time to wait for AI decompilation of a function shown in diff view
+#define DIFF_DECOMPILATION_DEADLINE_MS (60ULL * 1000)
+
 DecompilationWorker::DecompilationWorker (QObject *parent) : QObject (parent), m_cancelled (false) {}
 
 void DecompilationWorker::performDecompilation (const DecompilationRequest &request) {
@@ -1396,79 +1389,47 @@ void DecompilationWorker::performDecompilation (const DecompilationRequest &requ
             return;
         }
 
-        // Check decompilation status
-        Status status = GetAiDecompilationStatus (GetConnection(), request.functionId);
-
-        if ((status & STATUS_MASK) == STATUS_ERROR || (status & STATUS_MASK) == STATUS_UNINITIALIZED) {
-            emitProgress (30, QString ("Starting decompilation for %1...").arg (request.functionName));
-
-            if (m_cancelled) {
-                emit decompilationError ("Decompilation cancelled");
-                return;
-            }
-
-            // Try to begin decompilation
-            if (!BeginAiDecompilation (GetConnection(), request.functionId)) {
-                result.errorMessage = QString ("Failed to start decompilation for %1").arg (request.functionName);
-                emit decompilationError (result.errorMessage);
-                return;
-            }
-
-            // Wait for decompilation to complete with periodic status checks
-            emitProgress (50, QString ("Waiting for decompilation of %1...").arg (request.functionName));
-
-            int       attempts    = 0;
-            const int maxAttempts = 30; // 30 seconds timeout
-
-            while (attempts < maxAttempts) {
-                if (m_cancelled) {
-                    emit decompilationError ("Decompilation cancelled");
-                    return;
-                }
-
-                QThread::msleep (1000); // Wait 1 second
-                status = GetAiDecompilationStatus (GetConnection(), request.functionId);
-
-                if ((status & STATUS_MASK) == STATUS_SUCCESS) {
-                    break;
-                } else if ((status & STATUS_MASK) == STATUS_ERROR) {
-                    result.errorMessage = QString ("Decompilation failed for %1").arg (request.functionName);
-                    emit decompilationError (result.errorMessage);
-                    return;
-                }
-
-                attempts++;
-                int progress = 50 + (attempts * 40 / maxAttempts);
-                emitProgress (progress, QString ("Decompiling %1... (%2s)").arg (request.functionName).arg (attempts));
-            }
-
-            if (attempts >= maxAttempts) {
-                result.errorMessage = QString ("Decompilation timeout for %1").arg (request.functionName);
-                emit decompilationError (result.errorMessage);
-                return;
-            }
+        // Completed decompilations don't change, skip status polling if we already have it
+        if (CacheGetStr (CACHE_KIND_DECOMPILATION, request.functionId, NULL, &result.decompilation)) {
+            result.success = true;
+            emitProgress (100, QString ("Decompilation completed for %1").arg (request.functionName));
+            emit decompilationFinished (result);
+            return;
         }
 
-        if ((status & STATUS_MASK) == STATUS_PENDING) {
-            // Still pending - wait a bit more
-            emitProgress (70, QString ("Decompilation pending for %1...").arg (request.functionName));
-
-            int       attempts    = 0;
-            const int maxAttempts = 10; // 10 seconds additional wait
+        // Start decompilation if required, and wait for it to complete
+        emitProgress (30, QString ("Waiting for decompilation of %1...").arg (request.functionName));
+
+        m_functionName = request.functionName;
+
+        JobWaiter waiter    = JobWaiterInit (DIFF_DECOMPILATION_DEADLINE_MS);
+        waiter.user         = this;
+        waiter.is_cancelled = [] (void *user) -> bool {
+            return static_cast<DecompilationWorker *> (user)->m_cancelled;
+        };
+        waiter.on_progress = [] (void *user, Status status, u32 attempt, u64 elapsed_ms) {
+            (void)status;
+            (void)attempt;
+            DecompilationWorker *worker  = static_cast<DecompilationWorker *> (user);
+            u64                  elapsed = MIN2 (elapsed_ms, DIFF_DECOMPILATION_DEADLINE_MS);
+            worker->emitProgress (
+                30 + (int)(elapsed * 60 / DIFF_DECOMPILATION_DEADLINE_MS),
+                QString ("Decompiling %1... (%2s)").arg (worker->m_functionName).arg (elapsed_ms / 1000)
+            );
+        };
 
-            while (attempts < maxAttempts && (status & STATUS_MASK) == STATUS_PENDING) {
-                if (m_cancelled) {
-                    emit decompilationError ("Decompilation cancelled");
-                    return;
-                }
+        JobWaitResult wait_result = WaitForAiDecompilation (&waiter, request.functionId);
 
-                QThread::msleep (1000);
-                status = GetAiDecompilationStatus (GetConnection(), request.functionId);
-                attempts++;
-            }
+        if (wait_result == JOB_WAIT_CANCELLED) {
+            emit decompilationError ("Decompilation cancelled");
+            return;
+        } else if (wait_result == JOB_WAIT_TIMEOUT) {
+            result.errorMessage = QString ("Decompilation timeout for %1").arg (request.functionName);
+            emit decompilationError (result.errorMessage);
+            return;
         }
 
-        if ((status & STATUS_MASK) == STATUS_SUCCESS) {
+        if (wait_result == JOB_WAIT_SUCCESS) {
             emitProgress (90, QString ("Fetching decompilation for %1...").arg (request.functionName));
 
             if (m_cancelled) {
@@ -1481,6 +1442,10 @@ void DecompilationWorker::performDecompilation (const DecompilationRequest &requ
             result.decompilation  = StrDup (&aidec.decompilation);
             AiDecompilationDeinit (&aidec);
 
+            if (result.decompilation.length) {
+                CachePutStr (CACHE_KIND_DECOMPILATION, request.functionId, NULL, &result.decompilation);
+            }
+
             result.success = true;
             emitProgress (100, QString ("Decompilation completed for %1").arg (request.functionName));
             emit decompilationFinished (result);
@@ -1527,6 +1492,14 @@ void DisassemblyWorker::performDisassembly (const DisassemblyRequest &request) {
             return;
         }
 
+        // This view uses a more compact format than `getFunctionDisassembly`, so it's cached separately
+        if (CacheGetStr (CACHE_KIND_LINEAR_DISASM, request.functionId, "compact", &result.disassembly)) {
+            result.success = true;
+            emitProgress (100, QString ("Disassembly completed for %1").arg (request.functionName));
+            emit disassemblyFinished (result);
+            return;
+        }
+
         // Get the control flow graph for this function
         ControlFlowGraph cfg = GetFunctionControlFlowGraph (GetConnection(), request.functionId);
 
@@ -1575,6 +1548,8 @@ void DisassemblyWorker::performDisassembly (const DisassemblyRequest &request) {
         result.disassembly = linear_disasm;
         ControlFlowGraphDeinit (&cfg);
 
+        CachePutStr (CACHE_KIND_LINEAR_DISASM, request.functionId, "compact", &result.disassembly);
+
         result.success = true;
         emitProgress (100, QString ("Disassembly completed for %1").arg (request.functionName));
         emit disassemblyFinished (result);
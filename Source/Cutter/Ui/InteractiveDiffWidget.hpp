@@ -14,7 +14,6 @@
 #include <QHBoxLayout>
 #include <QSplitter>
 #include <QTreeWidget>
-#include <QTextEdit>
 #include <QLineEdit>
 #include <QSlider>
 #include <QLabel>
@@ -24,12 +23,17 @@
 #include <QTreeWidgetItem>
 #include <QThread>
 #include <QProgressBar>
+#include <QCheckBox>
 #include <QTimer>
 
 /* cutter */
 #include <cutter/widgets/CutterDockWidget.h>
 #include <cutter/core/MainWindow.h>
 
+/* plugin */
+#include <Cutter/Ui/DiffView.hpp>
+#include <DiffCache.h>
+
 /* reai */
 #include <Reai/Api.h>
 #include <Reai/Diff.h>
@@ -223,6 +227,7 @@ class InteractiveDiffWidget : public CutterDockWidget {
     void onFunctionListItemClicked (QTreeWidgetItem *item, int column);
     void onRenameRequested();
     void onToggleRequested();
+    void onNormalizeToggled();
 
     // Async slots
     void onSearchFinished (const SearchResult &result);
@@ -241,8 +246,8 @@ class InteractiveDiffWidget : public CutterDockWidget {
 
     // Three main panels
     QTreeWidget *functionListPanel; // Left: Similar functions list
-    QTextEdit   *sourceDiffPanel;   // Middle: Source function diff
-    QTextEdit   *targetDiffPanel;   // Right: Target function diff
+    DiffView    *sourceDiffPanel;   // Middle: Source function diff
+    DiffView    *targetDiffPanel;   // Right: Target function diff
 
     // Bottom control area
     QLineEdit    *functionNameInput; // Function name with autocomplete
@@ -252,6 +257,7 @@ class InteractiveDiffWidget : public CutterDockWidget {
     QPushButton  *searchButton;      // Trigger search
     QPushButton  *renameButton;      // Rename to selected function
     QPushButton  *toggleButton;      // Toggle between assembly/decompilation
+    QCheckBox    *normalizeCheckBox; // Ignore operands in assembly diff
     QLabel       *statusLabel;       // Status information
     QProgressBar *progressBar;       // Progress indicator for async operations
     QPushButton  *cancelButton;      // Cancel ongoing search
@@ -260,7 +266,7 @@ class InteractiveDiffWidget : public CutterDockWidget {
     QString                    currentSourceFunction;
     QList<SimilarFunctionData> similarFunctions;
     int                        currentSelectedIndex;
-    DiffLines                  currentDiffLines;       // Current diff data
+    DiffLines                 *currentDiffLines;       // Current diff, owned by diff cache
     Str                        sourceDisassembly;      // Source function disassembly
     Str                        sourceDecompilation;    // Source function decompilation
     QStringList                functionNameList;       // All function names for autocomplete
@@ -287,12 +293,13 @@ class InteractiveDiffWidget : public CutterDockWidget {
     void updateFunctionList();     // Update left panel with similar functions
     void updateDiffPanels();       // Update source/target panels
     void generateDiff();           // Generate DiffLines from source/target
+    void prefetchNeighbourDiffs(); // Compute diffs of functions next to selected one in background
+    DiffMode assemblyDiffMode() const; // Raw or normalized assembly diff, as chosen by user
 
-    // Diff rendering (adapted from CmdHandlers.c logic)
+    // Diff rendering, panels paint rows straight from diff lines
     void    renderSourceDiff (const DiffLines &diff);
     void    renderTargetDiff (const DiffLines &diff);
     QString formatDiffLineForQt (const DiffLine &line, bool isSource);
-    QString getColorForDiffType (DiffType type, bool isSource);
 
     // Utility methods
     void applySyntaxHighlighting();
@@ -400,7 +407,8 @@ class DecompilationWorker : public QObject {
     void progressUpdate (int percentage, const QString &status);
 
    private:
-    bool m_cancelled;
+    bool    m_cancelled;
+    QString m_functionName; ///< Function being decompiled, used in progress messages.
     void emitProgress (int percentage, const QString &status);
 };
 
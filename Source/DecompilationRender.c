@@ -0,0 +1,371 @@
+/**
+ * @file : DecompilationRender.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_types.h>
+#include <rz_util/rz_annotated_code.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <DecompilationRender.h>
+
+// Summary lines are broken at first space after this many characters
+#define SUMMARY_SOFT_LIMIT 120
+
+// Longest placeholder is `<EXTERNAL_VARIABLE_n>`, anything much longer is not a placeholder
+#define PLACEHOLDER_MAX_LENGTH 48
+
+typedef struct PlaceholderName {
+    const char *name;
+    size        length;
+} PlaceholderName;
+
+static const PlaceholderName placeholder_names[PLACEHOLDER_KIND_MAX] = {
+    [PLACEHOLDER_DISASM_FUNCTION]    = {"DISASM_FUNCTION", sizeof ("DISASM_FUNCTION") - 1},
+    [PLACEHOLDER_DISASM_STRING]      = {"DISASM_STRING", sizeof ("DISASM_STRING") - 1},
+    [PLACEHOLDER_UNMATCHED_FUNCTION] = {"UNMATCHED_FUNCTION", sizeof ("UNMATCHED_FUNCTION") - 1},
+    [PLACEHOLDER_UNMATCHED_STRING]   = {"UNMATCHED_STRING", sizeof ("UNMATCHED_STRING") - 1},
+    [PLACEHOLDER_VAR]                = {"VAR", sizeof ("VAR") - 1},
+    [PLACEHOLDER_EXTERNAL_VARIABLE]  = {"EXTERNAL_VARIABLE", sizeof ("EXTERNAL_VARIABLE") - 1},
+    [PLACEHOLDER_CUSTOM_TYPE]        = {"CUSTOM_TYPE", sizeof ("CUSTOM_TYPE") - 1},
+};
+
+// A placeholder found in template, with the text it's replaced with
+typedef struct Token {
+    u64             start; // Offset of '<' in template
+    u64             end;   // One past '>' in template
+    PlaceholderKind kind;
+    u64             index;
+    const Str      *value;
+} Token;
+
+const SymbolInfo *SubstitutionSymbol (const AiDecompilation *aidec, const Substitution *sub) {
+    if (!aidec || !sub) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    const SymbolInfos *symbols = NULL;
+    switch (sub->kind) {
+        case PLACEHOLDER_DISASM_FUNCTION :
+            symbols = &aidec->functions;
+            break;
+        case PLACEHOLDER_UNMATCHED_FUNCTION :
+            symbols = &aidec->unmatched.functions;
+            break;
+        case PLACEHOLDER_UNMATCHED_STRING :
+            symbols = &aidec->unmatched.strings;
+            break;
+        case PLACEHOLDER_VAR :
+            symbols = &aidec->unmatched.vars;
+            break;
+        case PLACEHOLDER_EXTERNAL_VARIABLE :
+            symbols = &aidec->unmatched.external_vars;
+            break;
+        case PLACEHOLDER_CUSTOM_TYPE :
+            symbols = &aidec->unmatched.custom_types;
+            break;
+        default :
+            return NULL;
+    }
+
+    return sub->index < symbols->length ? VecPtrAt (symbols, sub->index) : NULL;
+}
+
+// Text a placeholder is replaced with, same as what each kind was replaced with before
+static const Str *placeholderValue (const AiDecompilation *aidec, PlaceholderKind kind, u64 index) {
+    if (kind == PLACEHOLDER_DISASM_STRING) {
+        return index < aidec->strings.length ? &VecPtrAt (&aidec->strings, index)->string : NULL;
+    }
+
+    Substitution      sub = {.kind = kind, .index = index};
+    const SymbolInfo *sym = SubstitutionSymbol (aidec, &sub);
+    if (!sym) {
+        return NULL;
+    }
+
+    switch (kind) {
+        case PLACEHOLDER_DISASM_FUNCTION :
+        case PLACEHOLDER_UNMATCHED_FUNCTION :
+            return &sym->name;
+        default :
+            return &sym->value.str;
+    }
+}
+
+// Parse a placeholder starting at `s[0] == '<'`, with `avail` bytes left in template.
+static bool parsePlaceholder (const char *s, u64 avail, PlaceholderKind *kind, u64 *index, u64 *length) {
+    const char *close = memchr (s + 1, '>', MIN2 (avail, PLACEHOLDER_MAX_LENGTH) - 1);
+    if (!close) {
+        return false;
+    }
+
+    // Index is the digits after last underscore
+    const char *digits = close;
+    while (digits > s + 1 && digits[-1] >= '0' && digits[-1] <= '9') {
+        digits--;
+    }
+    if (digits == close || digits[-1] != '_' || close - digits > 18) {
+        return false;
+    }
+
+    const char *name        = s + 1;
+    size        name_length = (digits - 1) - name;
+    for (u32 k = 0; k < PLACEHOLDER_KIND_MAX; k++) {
+        if (placeholder_names[k].length == name_length && !memcmp (placeholder_names[k].name, name, name_length)) {
+            *kind   = (PlaceholderKind)k;
+            *index  = strtoull (digits, NULL, 10);
+            *length = close + 1 - s;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void appendSummary (Str *out, const Str *summary) {
+    i32         l = summary->length;
+    const char *p = summary->data ? summary->data : "";
+    while (l > SUMMARY_SOFT_LIMIT) {
+        const char *p1 = strchr (p + SUMMARY_SOFT_LIMIT, ' ');
+        if (p1) {
+            StrAppendf (out, "// %.*s\n", (i32)(p1 - p), p);
+            p1++;
+            l -= (p1 - p);
+            p  = p1;
+        } else {
+            break;
+        }
+    }
+    StrAppendf (out, "// %.*s\n\n", (i32)l, p);
+}
+
+Str RenderAiDecompilation (const AiDecompilation *aidec, bool with_summary, Substitutions *subs) {
+    if (!aidec) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    Str tmpl = StrInit();
+    if (with_summary) {
+        appendSummary (&tmpl, &aidec->ai_summary);
+    }
+    if (aidec->raw_decompilation.length) {
+        StrAppendf (&tmpl, "%.*s", (i32)aidec->raw_decompilation.length, aidec->raw_decompilation.data);
+    }
+    if (!tmpl.length) {
+        return tmpl;
+    }
+
+    // First pass finds all placeholders and computes exact size of output
+    Token *tokens      = NULL;
+    u64    token_count = 0;
+    u64    token_cap   = 0;
+    u64    out_length  = tmpl.length;
+
+    for (const char *c = memchr (tmpl.data, '<', tmpl.length); c;) {
+        u64             pos   = c - tmpl.data;
+        PlaceholderKind kind  = 0;
+        u64             index = 0, length = 1;
+        const Str      *value = NULL;
+
+        if (parsePlaceholder (c, tmpl.length - pos, &kind, &index, &length) &&
+            (value = placeholderValue (aidec, kind, index))) {
+            if (token_count == token_cap) {
+                u64    cap = token_cap ? token_cap * 2 : 64;
+                Token *t   = realloc (tokens, cap * sizeof (Token));
+                if (!t) {
+                    LOG_ERROR ("Failed to allocate memory for placeholders");
+                    free (tokens);
+                    StrDeinit (&tmpl);
+                    return StrInit();
+                }
+                tokens    = t;
+                token_cap = cap;
+            }
+
+            tokens[token_count++]  = (Token) {pos, pos + length, kind, index, value};
+            out_length            += value->length;
+            out_length            -= length;
+        } else {
+            length = 1;
+        }
+
+        u64 next = pos + length;
+        c        = next < tmpl.length ? memchr (tmpl.data + next, '<', tmpl.length - next) : NULL;
+    }
+
+    // Second pass copies template and values into exactly sized buffer
+    char *buf = malloc (out_length + 1);
+    if (!buf) {
+        LOG_ERROR ("Failed to allocate memory for rendered decompilation");
+        free (tokens);
+        StrDeinit (&tmpl);
+        return StrInit();
+    }
+
+    u64 in = 0, out = 0;
+    for (u64 i = 0; i < token_count; i++) {
+        Token *t = &tokens[i];
+
+        memcpy (buf + out, tmpl.data + in, t->start - in);
+        out += t->start - in;
+
+        if (t->value->length) {
+            memcpy (buf + out, t->value->data, t->value->length);
+        }
+        if (subs) {
+            Substitution sub = {.start = out, .end = out + t->value->length, .kind = t->kind, .index = t->index};
+            VecPushBack (subs, sub);
+        }
+        out += t->value->length;
+        in   = t->end;
+    }
+    memcpy (buf + out, tmpl.data + in, tmpl.length - in);
+    out      += tmpl.length - in;
+    buf[out]  = 0;
+
+    Str code = StrInitFromZstr (buf);
+
+    free (buf);
+    free (tokens);
+    StrDeinit (&tmpl);
+    return code;
+}
+
+static void addHighlight (RzAnnotatedCode *code, u64 start, u64 end, RzSyntaxHighlightType type) {
+    RzCodeAnnotation a      = {0};
+    a.start                 = start;
+    a.end                   = end;
+    a.type                  = RZ_CODE_ANNOTATION_TYPE_SYNTAX_HIGHLIGHT;
+    a.syntax_highlight.type = type;
+    rz_annotated_code_add_annotation (code, &a);
+}
+
+static void
+    addReference (RzAnnotatedCode *code, u64 start, u64 end, RzCodeAnnotationType type, const Str *name, u64 addr) {
+    RzCodeAnnotation a = {0};
+    a.start            = start;
+    a.end              = end;
+    a.type             = type;
+    a.reference.name   = strdup (name->data ? name->data : "");
+    a.reference.offset = addr;
+    rz_annotated_code_add_annotation (code, &a);
+}
+
+size AnnotateAiDecompilation (RzAnnotatedCode *code, const AiDecompilation *aidec, const Substitutions *subs) {
+    if (!code || !aidec || !subs) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    size annotated = 0;
+    VecForeachPtr (subs, sub, {
+        // Empty names can't be clicked on
+        if (sub->start == sub->end) {
+            continue;
+        }
+
+        if (sub->kind == PLACEHOLDER_DISASM_STRING) {
+            const StringInfo *str = VecPtrAt (&aidec->strings, sub->index);
+            if (str->address) {
+                addReference (
+                    code,
+                    sub->start,
+                    sub->end,
+                    RZ_CODE_ANNOTATION_TYPE_CONSTANT_VARIABLE,
+                    &str->string,
+                    str->address
+                );
+            }
+            addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_CONSTANT_VARIABLE);
+            annotated++;
+            continue;
+        }
+
+        const SymbolInfo *sym = SubstitutionSymbol (aidec, sub);
+        if (!sym) {
+            continue;
+        }
+
+        switch (sub->kind) {
+            case PLACEHOLDER_DISASM_FUNCTION :
+            case PLACEHOLDER_UNMATCHED_FUNCTION :
+                // External functions have no address in this binary to go to
+                if (!sym->is_external) {
+                    addReference (
+                        code,
+                        sub->start,
+                        sub->end,
+                        RZ_CODE_ANNOTATION_TYPE_FUNCTION_NAME,
+                        &sym->name,
+                        sym->value.addr
+                    );
+                }
+                addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_FUNCTION_NAME);
+                break;
+
+            case PLACEHOLDER_UNMATCHED_STRING :
+                addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_CONSTANT_VARIABLE);
+                break;
+
+            case PLACEHOLDER_VAR : {
+                RzCodeAnnotation a = {0};
+                a.start            = sub->start;
+                a.end              = sub->end;
+                a.type             = RZ_CODE_ANNOTATION_TYPE_LOCAL_VARIABLE;
+                a.variable.name    = strdup (sym->value.str.data ? sym->value.str.data : "");
+                rz_annotated_code_add_annotation (code, &a);
+                addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_LOCAL_VARIABLE);
+                break;
+            }
+
+            case PLACEHOLDER_EXTERNAL_VARIABLE :
+                addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_GLOBAL_VARIABLE);
+                break;
+
+            case PLACEHOLDER_CUSTOM_TYPE :
+                addHighlight (code, sub->start, sub->end, RZ_SYNTAX_HIGHLIGHT_TYPE_DATATYPE);
+                break;
+
+            default :
+                continue;
+        }
+
+        annotated++;
+    });
+
+    return annotated;
+}
+
+RzAnnotatedCode *AnnotatedCodeFromAiDecompilation (const AiDecompilation *aidec) {
+    if (!aidec) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!aidec->decompilation.length) {
+        return NULL;
+    }
+
+    Substitutions    subs       = VecInit();
+    Str              final_code = RenderAiDecompilation (aidec, true, &subs);
+    RzAnnotatedCode *code       = NULL;
+
+    if (final_code.length) {
+        code           = rz_annotated_code_new (strdup (final_code.data));
+        size annotated = AnnotateAiDecompilation (code, aidec, &subs);
+        LOG_INFO ("Annotated %zu of %llu symbol references", annotated, (u64)subs.length);
+    }
+
+    VecDeinit (&subs);
+    StrDeinit (&final_code);
+    return code;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file : DecompilationRender.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Render AI decompilation received from RevEngAI into final code.
+ * Raw decompilation refers to symbols with `<KIND_n>` placeholders (`<DISASM_FUNCTION_0>`,
+ * `<VAR_3>`, ...), where `n` indexes into the matching vector of `AiDecompilation`.
+ * All placeholders are resolved in a single pass, and output range of each substitution
+ * is recorded, so annotations can be made without searching the code again.
+ * */
+
+#ifndef REAI_PLUGIN_DECOMPILATION_RENDER
+#define REAI_PLUGIN_DECOMPILATION_RENDER
+
+/* revenai */
+#include <Reai/Api.h>
+
+/* rizin */
+#include <rz_util/rz_annotated_code.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum PlaceholderKind {
+        PLACEHOLDER_DISASM_FUNCTION = 0,  ///< `AiDecompilation::functions`
+        PLACEHOLDER_DISASM_STRING,        ///< `AiDecompilation::strings`
+        PLACEHOLDER_UNMATCHED_FUNCTION,   ///< `AiDecompilation::unmatched.functions`
+        PLACEHOLDER_UNMATCHED_STRING,     ///< `AiDecompilation::unmatched.strings`
+        PLACEHOLDER_VAR,                  ///< `AiDecompilation::unmatched.vars`
+        PLACEHOLDER_EXTERNAL_VARIABLE,    ///< `AiDecompilation::unmatched.external_vars`
+        PLACEHOLDER_CUSTOM_TYPE,          ///< `AiDecompilation::unmatched.custom_types`
+        PLACEHOLDER_KIND_MAX
+    } PlaceholderKind;
+
+    ///
+    /// A placeholder that was replaced while rendering.
+    ///
+    typedef struct Substitution {
+        u64             start; ///< Offset of replaced text in rendered code.
+        u64             end;   ///< One past last byte of replaced text.
+        PlaceholderKind kind;
+        u64             index; ///< Index in vector of `AiDecompilation` selected by `kind`.
+    } Substitution;
+
+    typedef Vec (Substitution) Substitutions;
+
+    ///
+    /// Render AI decompilation into final code in one pass over it.
+    /// Placeholders whose index is out of range are left as they are.
+    ///
+    /// aidec[in]        : AI decompilation to render.
+    /// with_summary[in] : Put AI summary before code, as comments wrapped at around 120 columns.
+    /// subs[out]        : Appended with every substitution made, in order of offset. Can be `NULL`.
+    ///
+    /// SUCCESS : Rendered code.
+    /// FAILURE : Empty `Str` with log messages.
+    ///
+    Str RenderAiDecompilation (const AiDecompilation* aidec, bool with_summary, Substitutions* subs);
+
+    ///
+    /// Get symbol a substitution refers to.
+    ///
+    /// SUCCESS : Symbol from `aidec`.
+    /// FAILURE : `NULL` for `PLACEHOLDER_DISASM_STRING` (not a `SymbolInfo`), or an invalid substitution.
+    ///
+    const SymbolInfo* SubstitutionSymbol (const AiDecompilation* aidec, const Substitution* sub);
+
+    ///
+    /// Annotate every symbol reference in rendered code, using substitutions recorded while
+    /// rendering it. Each reference is annotated exactly where it's placeholder was, so
+    /// no searching is required, and names are never matched inside longer identifiers.
+    ///
+    /// Functions get a function name annotation with their address, strings with a known
+    /// address get a constant variable annotation, and local variables a local variable
+    /// annotation. All references get syntax highlighting.
+    ///
+    /// code[in,out] : Code rendered by `RenderAiDecompilation`.
+    /// aidec[in]    : AI decompilation code was rendered from.
+    /// subs[in]     : Substitutions recorded while rendering.
+    ///
+    /// SUCCESS : Number of references annotated.
+    /// FAILURE : Zero.
+    ///
+    size AnnotateAiDecompilation (RzAnnotatedCode* code, const AiDecompilation* aidec, const Substitutions* subs);
+
+    ///
+    /// Render AI decompilation with it's summary, and annotate all symbol references in it.
+    /// This is what decompiler views show, and what gets cached for completed decompilations.
+    ///
+    /// SUCCESS : Annotated code owned by caller.
+    /// FAILURE : `NULL` if decompilation is empty or could not be rendered.
+    ///
+    RzAnnotatedCode* AnnotatedCodeFromAiDecompilation (const AiDecompilation* aidec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_DECOMPILATION_RENDER
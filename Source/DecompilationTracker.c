@@ -0,0 +1,398 @@
+/**
+ * @file : DecompilationTracker.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_th.h>
+#include <rz_types.h>
+#include <rz_util/rz_sys.h>
+#include <rz_util/rz_time.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <DecompilationTracker.h>
+#include <JobWaiter.h>
+#include <Plugin.h>
+#include <TaskGroup.h>
+#include <Util.h>
+
+// Longest time tracker sleeps before looking for due checks and new watches again
+#define TRACKER_SLICE_MS 50
+
+typedef struct TrackedDecompilation {
+    AiDecompilationPoll poll;
+    Status              status; // latest status received
+    u32                 checks;
+    u32                 poll_failures;
+    JobBackoff          backoff; // same backoff as `JobWait`, kept for each decompilation
+    u64                 next_check_us;
+    u32                 watchers;
+} TrackedDecompilation;
+
+typedef struct DecompilationWatch {
+    u64                 id;
+    FunctionId          fn_id;
+    DecompilationDoneFn on_done;
+    void               *user;
+    Status              status; // final status, once `done`
+    u32                 checks;
+    bool                done;
+} DecompilationWatch;
+
+// One status check made by tracker thread, outside the lock
+typedef struct TrackerCheck {
+    AiDecompilationPoll poll;
+    Status              status;
+} TrackerCheck;
+
+static struct {
+    RzThreadLock         *lock;
+    RzThreadCond         *wake; // signalled on new watch and on stop
+    RzThread             *worker;
+    TaskGroup            *pool; // runs status checks of worker, lives as long as worker does
+    bool                  stop;
+    TrackedDecompilation *tracked;
+    u32                   tracked_count;
+    u32                   tracked_capacity;
+    DecompilationWatch   *watches;
+    u32                   watch_count;
+    u32                   watch_capacity;
+    u64                   last_watch_id;
+    u64                   seed; // jitter of each tracked decompilation is seeded from this
+} tracker;
+
+// Grow an array of `elem_size` elements to hold at least one more
+static bool growArray (void **array, u32 *capacity, u32 count, size elem_size) {
+    if (count < *capacity) {
+        return true;
+    }
+
+    u32   new_capacity = *capacity ? *capacity * 2 : 16;
+    void *grown        = realloc (*array, (size)new_capacity * elem_size);
+    if (!grown) {
+        return false;
+    }
+    *array    = grown;
+    *capacity = new_capacity;
+    return true;
+}
+
+static TrackedDecompilation *findTracked (FunctionId fn_id) {
+    for (u32 i = 0; i < tracker.tracked_count; i++) {
+        if (tracker.tracked[i].poll.fn_id == fn_id) {
+            return &tracker.tracked[i];
+        }
+    }
+    return NULL;
+}
+
+static DecompilationWatch *findWatch (u64 watch_id) {
+    for (u32 i = 0; i < tracker.watch_count; i++) {
+        if (tracker.watches[i].id == watch_id) {
+            return &tracker.watches[i];
+        }
+    }
+    return NULL;
+}
+
+static void removeTracked (TrackedDecompilation *t) {
+    *t = tracker.tracked[--tracker.tracked_count];
+}
+
+// Tell all watchers a decompilation finished, and stop tracking it. Called with lock held.
+static void finishTracked (TrackedDecompilation *t, Status status) {
+    for (u32 i = 0; i < tracker.watch_count; i++) {
+        DecompilationWatch *w = &tracker.watches[i];
+        if (w->fn_id != t->poll.fn_id || w->done) {
+            continue;
+        }
+
+        w->done   = true;
+        w->status = status;
+        w->checks = t->checks;
+        if (w->on_done) {
+            w->on_done (w->user, w->fn_id, status);
+        }
+    }
+
+    removeTracked (t);
+}
+
+static void scheduleNextCheck (TrackedDecompilation *t, u64 now_us) {
+    t->next_check_us = now_us + JobBackoffNext (&t->backoff) * 1000;
+}
+
+static void applyCheck (const TrackerCheck *c, u64 now_us) {
+    TrackedDecompilation *t = findTracked (c->poll.fn_id);
+    if (!t) {
+        // Nobody watches it anymore
+        return;
+    }
+
+    t->poll   = c->poll;
+    t->status = c->status;
+    t->checks++;
+
+    if (!(c->status & STATUS_MASK)) {
+        if (++t->poll_failures >= JOB_WAIT_MAX_POLL_FAILURES) {
+            LOG_ERROR (
+                "Failed to get AI decompilation status of function ID %llu %u times in a row, giving up",
+                t->poll.fn_id,
+                t->poll_failures
+            );
+            finishTracked (t, STATUS_ERROR);
+        } else {
+            scheduleNextCheck (t, now_us);
+        }
+        return;
+    }
+
+    t->poll_failures = 0;
+    switch (c->status & STATUS_MASK) {
+        case STATUS_SUCCESS :
+        case STATUS_COMPLETE :
+        case STATUS_ERROR :
+            finishTracked (t, c->status & STATUS_MASK);
+            break;
+        default :
+            scheduleNextCheck (t, now_us);
+            break;
+    }
+}
+
+static void *trackerCheckTask (void *user) {
+    TrackerCheck *c = user;
+    c->status       = PollAiDecompilation (&c->poll);
+    return c;
+}
+
+// Checks that can't be handed to pool are made right here
+static void runChecks (TaskGroup *pool, TrackerCheck *checks, u32 count) {
+    for (u32 i = 0; i < count; i++) {
+        if (count == 1 || !pool || !TaskGroupSubmit (pool, trackerCheckTask, &checks[i])) {
+            trackerCheckTask (&checks[i]);
+        }
+    }
+
+    u64   task   = 0;
+    void *result = NULL;
+    while (pool && TaskGroupWaitNext (pool, &task, &result)) {}
+}
+
+static void *trackerWorker (void *user) {
+    (void)user;
+
+    TrackerCheck *checks   = NULL;
+    u32           capacity = 0;
+
+    rz_th_lock_enter (tracker.lock);
+    TaskGroup *pool = tracker.pool;
+    while (!tracker.stop) {
+        if (!tracker.tracked_count) {
+            rz_th_cond_wait (tracker.wake, tracker.lock);
+            continue;
+        }
+
+        // Collect every decompilation that is due for a status check
+        u64 now_us  = rz_time_now_mono();
+        u64 next_us = now_us + TRACKER_SLICE_MS * 1000;
+        u32 count   = 0;
+        for (u32 i = 0; i < tracker.tracked_count; i++) {
+            TrackedDecompilation *t = &tracker.tracked[i];
+            if (t->next_check_us > now_us) {
+                next_us = MIN2 (next_us, t->next_check_us);
+                continue;
+            }
+
+            if (!growArray ((void **)&checks, &capacity, count, sizeof (TrackerCheck))) {
+                LOG_ERROR ("Failed to allocate memory for status checks, checking fewer this time");
+                break;
+            }
+            checks[count++] = (TrackerCheck) {.poll = t->poll};
+
+            // Don't pick it up again while it's being checked
+            t->next_check_us = UT64_MAX;
+        }
+
+        if (!count) {
+            rz_th_lock_leave (tracker.lock);
+            rz_sys_usleep (next_us - now_us);
+            rz_th_lock_enter (tracker.lock);
+            continue;
+        }
+
+        rz_th_lock_leave (tracker.lock);
+        runChecks (pool, checks, count);
+        rz_th_lock_enter (tracker.lock);
+
+        now_us = rz_time_now_mono();
+        for (u32 i = 0; i < count; i++) {
+            applyCheck (&checks[i], now_us);
+        }
+    }
+
+    // Nobody is left to check status, let all watchers go
+    while (tracker.tracked_count) {
+        finishTracked (&tracker.tracked[0], 0);
+    }
+    rz_th_lock_leave (tracker.lock);
+
+    free (checks);
+    return NULL;
+}
+
+void DecompilationTrackerInit() {
+    if (tracker.lock) {
+        return;
+    }
+
+    tracker.seed           = rz_time_now_mono();
+    RzThreadCond **conds[] = {&tracker.wake};
+    if (!ThreadSyncNew (&tracker.lock, conds, 1)) {
+        LOG_ERROR ("Failed to create decompilation tracker synchronization primitives");
+    }
+}
+
+u64 DecompilationTrackerWatch (FunctionId fn_id, DecompilationDoneFn on_done, void *user) {
+    if (!fn_id) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!tracker.lock) {
+        return 0;
+    }
+
+    rz_th_lock_enter (tracker.lock);
+
+    if (!tracker.worker && !tracker.stop) {
+        // Worker runs without pool if it can't be created, checks are then made one by one
+        tracker.pool   = TaskGroupNew (GetMaxParallelRequests());
+        tracker.worker = rz_th_new (trackerWorker, NULL);
+        if (!tracker.worker) {
+            TaskGroupFree (tracker.pool, NULL);
+            tracker.pool = NULL;
+        }
+    }
+    bool has_room =
+        growArray ((void **)&tracker.watches, &tracker.watch_capacity, tracker.watch_count, sizeof (DecompilationWatch)) &&
+        growArray ((void **)&tracker.tracked, &tracker.tracked_capacity, tracker.tracked_count, sizeof (TrackedDecompilation));
+    if (!tracker.worker || !has_room) {
+        rz_th_lock_leave (tracker.lock);
+        LOG_ERROR ("Failed to track AI decompilation of function ID %llu", fn_id);
+        return 0;
+    }
+
+    TrackedDecompilation *t = findTracked (fn_id);
+    if (!t) {
+        // Checked right away, that also starts decompilation if required
+        t  = &tracker.tracked[tracker.tracked_count++];
+        *t = (TrackedDecompilation) {
+            .poll    = AiDecompilationPollInit (fn_id),
+            .backoff = JobBackoffInit (0, 0, tracker.seed + fn_id),
+        };
+    }
+    t->watchers++;
+
+    u64 watch_id                           = ++tracker.last_watch_id;
+    tracker.watches[tracker.watch_count++] = (DecompilationWatch) {
+        .id      = watch_id,
+        .fn_id   = fn_id,
+        .on_done = on_done,
+        .user    = user,
+    };
+
+    rz_th_cond_signal (tracker.wake);
+    rz_th_lock_leave (tracker.lock);
+
+    return watch_id;
+}
+
+bool DecompilationTrackerCheck (u64 watch_id, Status *status, u32 *checks) {
+    if (!tracker.lock) {
+        return false;
+    }
+
+    rz_th_lock_enter (tracker.lock);
+
+    bool                done = false;
+    DecompilationWatch *w    = findWatch (watch_id);
+    if (w && w->done) {
+        done = true;
+        if (status) {
+            *status = w->status;
+        }
+        if (checks) {
+            *checks = w->checks;
+        }
+    } else if (w) {
+        TrackedDecompilation *t = findTracked (w->fn_id);
+        if (status) {
+            *status = t ? t->status : 0;
+        }
+        if (checks) {
+            *checks = t ? t->checks : 0;
+        }
+    }
+
+    rz_th_lock_leave (tracker.lock);
+    return done;
+}
+
+void DecompilationTrackerUnwatch (u64 watch_id) {
+    if (!tracker.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (tracker.lock);
+
+    DecompilationWatch *w = findWatch (watch_id);
+    if (w) {
+        TrackedDecompilation *t = w->done ? NULL : findTracked (w->fn_id);
+        if (t && !--t->watchers) {
+            removeTracked (t);
+        }
+        *w = tracker.watches[--tracker.watch_count];
+    }
+
+    rz_th_lock_leave (tracker.lock);
+}
+
+void DecompilationTrackerShutdown() {
+    if (!tracker.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (tracker.lock);
+    tracker.stop    = true;
+    RzThread  *th   = tracker.worker;
+    TaskGroup *pool = tracker.pool;
+    tracker.worker  = NULL;
+    tracker.pool    = NULL;
+    rz_th_cond_signal_all (tracker.wake);
+    rz_th_lock_leave (tracker.lock);
+
+    // Pool is used by worker only, free it once worker is gone
+    if (th) {
+        rz_th_wait (th);
+        rz_th_free (th);
+    }
+    TaskGroupFree (pool, NULL);
+
+    // Watches are owned by their watchers, only tracked decompilations are dropped here
+    rz_th_lock_enter (tracker.lock);
+    while (tracker.tracked_count) {
+        finishTracked (&tracker.tracked[0], 0);
+    }
+    tracker.stop = false;
+    rz_th_lock_leave (tracker.lock);
+}
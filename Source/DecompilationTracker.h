@@ -0,0 +1,84 @@
+/**
+ * @file : DecompilationTracker.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Single tracker for all AI decompilations plugin is waiting for.
+ * Instead of every waiter polling status of it's own decompilation, waiters register the
+ * function ID here. One tracker thread checks status of every tracked decompilation with
+ * backoff, over at most `GetMaxParallelRequests()` connections at once, and tells all
+ * watchers when it completes. Waiting for the same function twice costs nothing extra,
+ * and number of threads and status requests stays bounded however many are pending.
+ *
+ * RevEngAI has no batch status endpoint, so each tick sends one status request per
+ * decompilation that is due for a check.
+ * */
+
+#ifndef REAI_PLUGIN_DECOMPILATION_TRACKER
+#define REAI_PLUGIN_DECOMPILATION_TRACKER
+
+/* revenai */
+#include <Reai/Api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Called on tracker thread when a watched decompilation finishes.
+    /// Tracker is locked during the call, so it must return quickly and must not call
+    /// any tracker function.
+    ///
+    /// status : `STATUS_SUCCESS` or `STATUS_COMPLETE` on success, `STATUS_ERROR` on failure,
+    ///          and zero if tracker was shut down before decompilation finished.
+    ///
+    typedef void (*DecompilationDoneFn) (void* user, FunctionId fn_id, Status status);
+
+    ///
+    /// Create tracker state. Must be called on main thread before any other tracker function.
+    ///
+    void DecompilationTrackerInit();
+
+    ///
+    /// Start watching AI decompilation of a function. Decompilation is started if it's not
+    /// started already. First error status is treated as a stale result and decompilation
+    /// is restarted, every error after that fails it.
+    ///
+    /// fn_id[in]   : Function to watch decompilation of.
+    /// on_done[in] : Called once decompilation finishes. Can be `NULL`.
+    /// user[in]    : Passed to `on_done`.
+    ///
+    /// SUCCESS : Non-zero watch ID, to be passed to `DecompilationTrackerUnwatch` when done.
+    /// FAILURE : Zero with log messages.
+    ///
+    u64 DecompilationTrackerWatch (FunctionId fn_id, DecompilationDoneFn on_done, void* user);
+
+    ///
+    /// Get state of a watched decompilation.
+    ///
+    /// watch_id[in] : ID returned by `DecompilationTrackerWatch`.
+    /// status[out]  : Latest status received, zero if not checked yet. Can be `NULL`.
+    /// checks[out]  : Number of status checks made so far. Can be `NULL`.
+    ///
+    /// SUCCESS : `true` if decompilation finished, final status is in `status`.
+    /// FAILURE : `false` while it's still pending.
+    ///
+    bool DecompilationTrackerCheck (u64 watch_id, Status* status, u32* checks);
+
+    ///
+    /// Stop watching. `on_done` of watch is never called after this returns.
+    /// Decompilation stops being tracked once nobody watches it.
+    ///
+    void DecompilationTrackerUnwatch (u64 watch_id);
+
+    ///
+    /// Stop tracker thread. All pending watches finish with zero status.
+    ///
+    void DecompilationTrackerShutdown();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_DECOMPILATION_TRACKER
@@ -0,0 +1,350 @@
+/**
+ * @file : DiffCache.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_th.h>
+#include <rz_types.h>
+
+/* revengai */
+#include <Reai/Log.h>
+
+/* local includes */
+#include <AsmDiff.h>
+#include <DiffCache.h>
+#include <Util.h>
+
+// Diffs of a few functions against a few dozen similar functions each
+#define DIFF_CACHE_MAX_ENTRIES 64
+
+// Prefetch requests waiting for worker. Newest are computed first, oldest are dropped when full.
+#define DIFF_CACHE_MAX_JOBS 4
+
+typedef struct DiffCacheKey {
+    u64      source_hash;
+    u64      target_hash;
+    u64      source_length;
+    u64      target_length;
+    DiffMode mode;
+} DiffCacheKey;
+
+typedef struct DiffCacheEntry {
+    DiffLines    lines; // must be first, callers get a pointer to it
+    DiffCacheKey key;
+    u32          refs;
+    u64          last_used;
+    bool         ready;  // diff is computed, `lines` can be read
+    bool         cached; // entry is in table, and is freed on eviction and not on last release
+} DiffCacheEntry;
+
+typedef struct DiffCacheJob {
+    Str          source;
+    Str          target;
+    DiffCacheKey key;
+} DiffCacheJob;
+
+static struct {
+    RzThreadLock   *lock;
+    RzThreadCond   *ready; // signalled when any entry becomes ready
+    RzThreadCond   *wake;  // signalled on new job and on stop
+    RzThread       *worker;
+    bool            stop;
+    DiffCacheEntry *entries[DIFF_CACHE_MAX_ENTRIES];
+    u32             entry_count;
+    DiffCacheJob    jobs[DIFF_CACHE_MAX_JOBS];
+    u32             job_count;
+    u64             tick;
+    DiffCacheEntry  empty; // handed out when an entry can't be allocated
+} diff_cache;
+
+static u64 diffCacheHash (const Str *s) {
+    return HashFnv1a (HASH_FNV1A_SEED, s->data, s->length);
+}
+
+static DiffCacheKey diffCacheKey (const Str *source, const Str *target, DiffMode mode) {
+    return (DiffCacheKey) {
+        .source_hash   = diffCacheHash (source),
+        .target_hash   = diffCacheHash (target),
+        .source_length = source->length,
+        .target_length = target->length,
+        .mode          = mode,
+    };
+}
+
+static bool diffCacheKeyEq (const DiffCacheKey *a, const DiffCacheKey *b) {
+    return a->source_hash == b->source_hash && a->target_hash == b->target_hash &&
+           a->source_length == b->source_length && a->target_length == b->target_length && a->mode == b->mode;
+}
+
+static void entryFree (DiffCacheEntry *e) {
+    if (e->ready) {
+        VecDeinit (&e->lines);
+    }
+    free (e);
+}
+
+static DiffLines diffCompute (Str *source, Str *target, DiffMode mode) {
+    return mode == DIFF_MODE_ASSEMBLY_NORMALIZED ? AsmDiffCompute (source, target) : GetDiff (source, target);
+}
+
+static DiffCacheEntry *entryFind (const DiffCacheKey *key) {
+    for (u32 i = 0; i < diff_cache.entry_count; i++) {
+        if (diffCacheKeyEq (&diff_cache.entries[i]->key, key)) {
+            return diff_cache.entries[i];
+        }
+    }
+    return NULL;
+}
+
+// Put a new entry in table, evicting least recently used unused one if table is full.
+// Called with lock held. Entry stays uncached if every entry in table is in use.
+static void entryInsert (DiffCacheEntry *e) {
+    if (diff_cache.entry_count < DIFF_CACHE_MAX_ENTRIES) {
+        diff_cache.entries[diff_cache.entry_count++] = e;
+        e->cached                                    = true;
+        return;
+    }
+
+    DiffCacheEntry **victim = NULL;
+    for (u32 i = 0; i < diff_cache.entry_count; i++) {
+        DiffCacheEntry *c = diff_cache.entries[i];
+        if (c->ready && !c->refs && (!victim || c->last_used < (*victim)->last_used)) {
+            victim = &diff_cache.entries[i];
+        }
+    }
+
+    if (victim) {
+        entryFree (*victim);
+        *victim   = e;
+        e->cached = true;
+    }
+}
+
+// Create an entry in use by caller, not yet ready. Called with lock held.
+static DiffCacheEntry *entryNew (const DiffCacheKey *key) {
+    DiffCacheEntry *e = calloc (1, sizeof (DiffCacheEntry));
+    if (!e) {
+        LOG_ERROR ("Failed to allocate memory for diff cache entry");
+        return NULL;
+    }
+
+    e->key       = *key;
+    e->refs      = 1;
+    e->last_used = ++diff_cache.tick;
+    entryInsert (e);
+    return e;
+}
+
+// Compute diff of an entry created by `entryNew` and mark it ready. Called without lock.
+static void entryCompute (DiffCacheEntry *e, Str *source, Str *target) {
+    DiffLines lines = diffCompute (source, target, e->key.mode);
+
+    rz_th_lock_enter (diff_cache.lock);
+    e->lines = lines;
+    e->ready = true;
+    rz_th_cond_signal_all (diff_cache.ready);
+    rz_th_lock_leave (diff_cache.lock);
+}
+
+static void jobDeinit (DiffCacheJob *job) {
+    StrDeinit (&job->source);
+    StrDeinit (&job->target);
+}
+
+static void *diffCacheWorker (void *user) {
+    (void)user;
+
+    rz_th_lock_enter (diff_cache.lock);
+    while (true) {
+        while (!diff_cache.stop && !diff_cache.job_count) {
+            rz_th_cond_wait (diff_cache.wake, diff_cache.lock);
+        }
+        if (diff_cache.stop) {
+            break;
+        }
+
+        DiffCacheJob job = diff_cache.jobs[--diff_cache.job_count];
+
+        // Viewer may have asked for it already, or table may be full of diffs in use
+        DiffCacheEntry *e = entryFind (&job.key) ? NULL : entryNew (&job.key);
+        if (e && !e->cached) {
+            entryFree (e);
+            e = NULL;
+        }
+
+        if (e) {
+            rz_th_lock_leave (diff_cache.lock);
+            entryCompute (e, &job.source, &job.target);
+            rz_th_lock_enter (diff_cache.lock);
+            e->refs--;
+        }
+        jobDeinit (&job);
+    }
+    rz_th_lock_leave (diff_cache.lock);
+
+    return NULL;
+}
+
+void DiffCacheInit() {
+    if (diff_cache.lock) {
+        return;
+    }
+
+    RzThreadCond **conds[] = {&diff_cache.ready, &diff_cache.wake};
+    if (!ThreadSyncNew (&diff_cache.lock, conds, 2)) {
+        LOG_ERROR ("Failed to create diff cache synchronization primitives");
+    }
+}
+
+DiffLines *DiffCacheAcquire (Str *source, Str *target, DiffMode mode) {
+    if (!source || !target) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    // Without cache state, every diff is computed and freed on release
+    if (!diff_cache.lock) {
+        DiffCacheEntry *e = calloc (1, sizeof (DiffCacheEntry));
+        if (!e) {
+            LOG_ERROR ("Failed to allocate memory for diff cache entry");
+            return &diff_cache.empty.lines;
+        }
+        e->refs  = 1;
+        e->lines = diffCompute (source, target, mode);
+        e->ready = true;
+        return &e->lines;
+    }
+
+    DiffCacheKey key = diffCacheKey (source, target, mode);
+
+    rz_th_lock_enter (diff_cache.lock);
+    DiffCacheEntry *e = entryFind (&key);
+    if (e) {
+        e->refs++;
+        e->last_used = ++diff_cache.tick;
+
+        // Worker is computing this one right now
+        while (!e->ready) {
+            rz_th_cond_wait (diff_cache.ready, diff_cache.lock);
+        }
+        rz_th_lock_leave (diff_cache.lock);
+        return &e->lines;
+    }
+
+    e = entryNew (&key);
+    rz_th_lock_leave (diff_cache.lock);
+
+    if (!e) {
+        return &diff_cache.empty.lines;
+    }
+
+    entryCompute (e, source, target);
+    return &e->lines;
+}
+
+void DiffCacheRelease (DiffLines *diff) {
+    if (!diff || diff == &diff_cache.empty.lines) {
+        return;
+    }
+
+    DiffCacheEntry *e = (DiffCacheEntry *)diff;
+    if (!diff_cache.lock) {
+        entryFree (e);
+        return;
+    }
+
+    rz_th_lock_enter (diff_cache.lock);
+    bool unused = !--e->refs && !e->cached;
+    rz_th_lock_leave (diff_cache.lock);
+
+    if (unused) {
+        entryFree (e);
+    }
+}
+
+void DiffCachePrefetch (const Str *source, const Str *target, DiffMode mode) {
+    if (!source || !target) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!diff_cache.lock) {
+        return;
+    }
+
+    DiffCacheKey key = diffCacheKey (source, target, mode);
+
+    rz_th_lock_enter (diff_cache.lock);
+    bool queued = false;
+    for (u32 i = 0; i < diff_cache.job_count && !queued; i++) {
+        queued = diffCacheKeyEq (&diff_cache.jobs[i].key, &key);
+    }
+    if (queued || entryFind (&key) || diff_cache.stop) {
+        rz_th_lock_leave (diff_cache.lock);
+        return;
+    }
+
+    if (!diff_cache.worker) {
+        diff_cache.worker = rz_th_new (diffCacheWorker, NULL);
+        if (!diff_cache.worker) {
+            LOG_ERROR ("Failed to start diff cache worker");
+            rz_th_lock_leave (diff_cache.lock);
+            return;
+        }
+    }
+
+    // User moved on, drop the oldest request
+    if (diff_cache.job_count == DIFF_CACHE_MAX_JOBS) {
+        jobDeinit (&diff_cache.jobs[0]);
+        memmove (&diff_cache.jobs[0], &diff_cache.jobs[1], (DIFF_CACHE_MAX_JOBS - 1) * sizeof (DiffCacheJob));
+        diff_cache.job_count--;
+    }
+
+    diff_cache.jobs[diff_cache.job_count++] = (DiffCacheJob) {
+        .source = StrDup (source),
+        .target = StrDup (target),
+        .key    = key,
+    };
+    rz_th_cond_signal (diff_cache.wake);
+    rz_th_lock_leave (diff_cache.lock);
+}
+
+void DiffCacheShutdown() {
+    if (!diff_cache.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (diff_cache.lock);
+    diff_cache.stop   = true;
+    RzThread *th      = diff_cache.worker;
+    diff_cache.worker = NULL;
+    rz_th_cond_signal_all (diff_cache.wake);
+    rz_th_lock_leave (diff_cache.lock);
+
+    if (th) {
+        rz_th_wait (th);
+        rz_th_free (th);
+    }
+
+    // Diffs still shown by a viewer are freed by their last release
+    rz_th_lock_enter (diff_cache.lock);
+    while (diff_cache.job_count) {
+        jobDeinit (&diff_cache.jobs[--diff_cache.job_count]);
+    }
+    for (u32 i = 0; i < diff_cache.entry_count; i++) {
+        DiffCacheEntry *e = diff_cache.entries[i];
+        if (e->refs) {
+            e->cached = false;
+        } else {
+            entryFree (e);
+        }
+    }
+    diff_cache.entry_count = 0;
+    diff_cache.stop        = false;
+    rz_th_lock_leave (diff_cache.lock);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file : DiffCache.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b In-memory cache of computed diffs, shared by all diff viewers.
+ * Diffs are keyed by hashes of source and target content and by diff mode, so going back
+ * to a pair that was already viewed costs nothing. Viewers also ask for diffs of items next
+ * to the selected one, which are computed on a worker thread before user gets to them.
+ * */
+
+#ifndef REAI_PLUGIN_DIFF_CACHE
+#define REAI_PLUGIN_DIFF_CACHE
+
+/* revengai */
+#include <Reai/Diff.h>
+#include <Reai/Util/Str.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// What is being diffed. Same contents diffed in different modes are cached separately.
+    ///
+    typedef enum DiffMode {
+        DIFF_MODE_ASSEMBLY,
+        DIFF_MODE_ASSEMBLY_NORMALIZED, ///< Assembly matched ignoring operands, see `AsmDiffCompute`.
+        DIFF_MODE_DECOMPILATION,
+    } DiffMode;
+
+    ///
+    /// Create diff cache state. Must be called on main thread before any other diff cache function.
+    ///
+    void DiffCacheInit();
+
+    ///
+    /// Get diff of `target` against `source`, computing it on calling thread if it's not cached.
+    /// If the same diff is being computed on worker thread, waits for it instead.
+    ///
+    /// source[in] : Source content.
+    /// target[in] : Target content.
+    /// mode[in]   : What's being diffed.
+    ///
+    /// SUCCESS : Diff, that must not be modified and must be released with `DiffCacheRelease`.
+    /// FAILURE : Empty diff with log messages if memory can't be allocated. Still to be released.
+    ///
+    DiffLines* DiffCacheAcquire (Str* source, Str* target, DiffMode mode);
+
+    ///
+    /// Release a diff returned by `DiffCacheAcquire`. Can be `NULL`.
+    ///
+    void DiffCacheRelease (DiffLines* diff);
+
+    ///
+    /// Compute diff in background so a later `DiffCacheAcquire` finds it ready.
+    /// Contents are copied. Only the most recent few requests are kept, older ones are dropped.
+    ///
+    /// source[in] : Source content.
+    /// target[in] : Target content.
+    /// mode[in]   : What's being diffed.
+    ///
+    void DiffCachePrefetch (const Str* source, const Str* target, DiffMode mode);
+
+    ///
+    /// Stop worker thread and drop all cached diffs that are not in use.
+    ///
+    void DiffCacheShutdown();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_DIFF_CACHE
@@ -0,0 +1,236 @@
+/**
+ * @file : JobWaiter.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* rizin */
+#include <rz_types.h>
+#include <rz_util/rz_sys.h>
+#include <rz_util/rz_time.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <DecompilationTracker.h>
+#include <JobWaiter.h>
+#include <Plugin.h>
+
+// Most AI decompilations finish in a few seconds, so start checking often and back off
+// for the long ones.
+#define JOB_WAIT_INITIAL_DELAY_MS 250
+#define JOB_WAIT_MAX_DELAY_MS     5000
+
+// Sleeps are split into slices of this length so that cancellation is noticed quickly
+#define JOB_WAIT_SLICE_MS 50
+
+JobWaiter JobWaiterInit (u64 deadline_ms) {
+    return (JobWaiter) {
+        .initial_delay_ms = JOB_WAIT_INITIAL_DELAY_MS,
+        .max_delay_ms     = JOB_WAIT_MAX_DELAY_MS,
+        .deadline_ms      = deadline_ms,
+    };
+}
+
+static u64 elapsedMs (u64 start_us) {
+    return (rz_time_now_mono() - start_us) / 1000;
+}
+
+JobBackoff JobBackoffInit (u64 initial_delay_ms, u64 max_delay_ms, u64 seed) {
+    u64 delay_ms = initial_delay_ms ? initial_delay_ms : JOB_WAIT_INITIAL_DELAY_MS;
+    u64 rng      = seed ^ 0x9e3779b97f4a7c15ULL;
+    return (JobBackoff) {
+        .delay_ms     = delay_ms,
+        .max_delay_ms = MAX2 (max_delay_ms ? max_delay_ms : JOB_WAIT_MAX_DELAY_MS, delay_ms),
+        .rng          = rng ? rng : 0x9e3779b97f4a7c15ULL, // xorshift never leaves zero
+    };
+}
+
+u64 JobBackoffNext (JobBackoff *backoff) {
+    if (!backoff) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    // xorshift64
+    u64 x         = backoff->rng;
+    x            ^= x << 13;
+    x            ^= x >> 7;
+    x            ^= x << 17;
+    backoff->rng  = x;
+
+    // Equal jitter : wait somewhere between half and full of current delay
+    u64 half          = backoff->delay_ms / 2;
+    u64 sleep         = half + (half ? x % (half + 1) : 0);
+    backoff->delay_ms = MIN2 (backoff->delay_ms * 2, backoff->max_delay_ms);
+    return sleep;
+}
+
+static bool isCancelled (const JobWaiter *waiter) {
+    return waiter->is_cancelled && waiter->is_cancelled (waiter->user);
+}
+
+// Sleep for given time, unless wait is cancelled or deadline comes first.
+static JobWaitResult sleepFor (const JobWaiter *waiter, u64 start_us, u64 delay_ms) {
+    u64 slept_ms = 0;
+    while (slept_ms < delay_ms) {
+        if (isCancelled (waiter)) {
+            return JOB_WAIT_CANCELLED;
+        }
+        if (waiter->deadline_ms && elapsedMs (start_us) >= waiter->deadline_ms) {
+            return JOB_WAIT_TIMEOUT;
+        }
+
+        u64 slice = MIN2 (JOB_WAIT_SLICE_MS, delay_ms - slept_ms);
+        rz_sys_usleep (slice * 1000);
+        slept_ms += slice;
+    }
+
+    return JOB_WAIT_SUCCESS;
+}
+
+JobWaitResult JobWait (const JobWaiter *waiter, JobPollFn poll, void *poll_user, Status *last_status) {
+    if (!waiter || !poll) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    u64        start_us      = rz_time_now_mono();
+    u64        seed          = start_us ^ (u64)(size_t)&start_us;
+    JobBackoff backoff       = JobBackoffInit (waiter->initial_delay_ms, waiter->max_delay_ms, seed);
+    u32        poll_failures = 0;
+
+    for (u32 attempt = 1;; attempt++) {
+        if (isCancelled (waiter)) {
+            return JOB_WAIT_CANCELLED;
+        }
+
+        Status status = poll (poll_user);
+        if (last_status) {
+            *last_status = status;
+        }
+        if (waiter->on_progress) {
+            waiter->on_progress (waiter->user, status, attempt, elapsedMs (start_us));
+        }
+
+        if (!(status & STATUS_MASK)) {
+            if (++poll_failures >= JOB_WAIT_MAX_POLL_FAILURES) {
+                LOG_ERROR ("Failed to get job status %u times in a row, giving up", poll_failures);
+                return JOB_WAIT_FAILED;
+            }
+        } else {
+            poll_failures = 0;
+            switch (status & STATUS_MASK) {
+                case STATUS_SUCCESS :
+                case STATUS_COMPLETE :
+                    return JOB_WAIT_SUCCESS;
+                case STATUS_ERROR :
+                    return JOB_WAIT_FAILED;
+                default :
+                    break;
+            }
+        }
+
+        JobWaitResult r = sleepFor (waiter, start_us, JobBackoffNext (&backoff));
+        if (r != JOB_WAIT_SUCCESS) {
+            return r;
+        }
+    }
+}
+
+AiDecompilationPoll AiDecompilationPollInit (FunctionId fn_id) {
+    return (AiDecompilationPoll) {.fn_id = fn_id, .first = true};
+}
+
+Status PollAiDecompilation (void *poll) {
+    AiDecompilationPoll *p = poll;
+
+    Status status = GetAiDecompilationStatus (GetConnection(), p->fn_id);
+    bool   first  = p->first;
+    p->first      = false;
+
+    switch (status & STATUS_MASK) {
+        case STATUS_ERROR :
+            // Ignore first status value (suggested by revengai team)
+            if (!first) {
+                return status;
+            }
+            LOG_INFO ("Initial AI decompilation status was STATUS_ERROR, restarting decompilation");
+        // fallthrough
+        case STATUS_UNINITIALIZED :
+            if (!BeginAiDecompilation (GetConnection(), p->fn_id)) {
+                LOG_ERROR ("Failed to start AI decompilation of function ID %llu", p->fn_id);
+                return STATUS_ERROR;
+            }
+            return STATUS_PENDING;
+
+        default :
+            return status;
+    }
+}
+
+// Wait for a decompilation tracked by decompilation tracker. Only shared state is checked
+// here, status requests are made by tracker for all waiters together.
+static JobWaitResult waitForWatch (const JobWaiter *waiter, u64 watch_id, Status *status) {
+    u64 start_us    = rz_time_now_mono();
+    u32 seen_checks = 0;
+
+    while (true) {
+        u32  checks = 0;
+        bool done   = DecompilationTrackerCheck (watch_id, status, &checks);
+        if (checks != seen_checks && waiter->on_progress) {
+            waiter->on_progress (waiter->user, *status, checks, elapsedMs (start_us));
+        }
+        seen_checks = checks;
+
+        if (done) {
+            switch (*status & STATUS_MASK) {
+                case STATUS_SUCCESS :
+                case STATUS_COMPLETE :
+                    return JOB_WAIT_SUCCESS;
+                default :
+                    return JOB_WAIT_FAILED;
+            }
+        }
+
+        JobWaitResult r = sleepFor (waiter, start_us, JOB_WAIT_SLICE_MS);
+        if (r != JOB_WAIT_SUCCESS) {
+            return r;
+        }
+    }
+}
+
+JobWaitResult WaitForAiDecompilation (const JobWaiter *waiter, FunctionId fn_id) {
+    if (!waiter || !fn_id) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    Status        status   = 0;
+    JobWaitResult r        = JOB_WAIT_FAILED;
+    u64           watch_id = DecompilationTrackerWatch (fn_id, NULL, NULL);
+    if (watch_id) {
+        r = waitForWatch (waiter, watch_id, &status);
+        DecompilationTrackerUnwatch (watch_id);
+    } else {
+        // Tracker is not available, check status of this decompilation here
+        AiDecompilationPoll p = AiDecompilationPollInit (fn_id);
+        r                     = JobWait (waiter, PollAiDecompilation, &p, &status);
+    }
+
+    switch (r) {
+        case JOB_WAIT_SUCCESS :
+            break;
+        case JOB_WAIT_FAILED :
+            LOG_ERROR ("AI decompilation of function ID %llu failed (status = %u)", fn_id, status);
+            break;
+        case JOB_WAIT_TIMEOUT :
+            LOG_ERROR ("Timed out waiting for AI decompilation of function ID %llu", fn_id);
+            break;
+        case JOB_WAIT_CANCELLED :
+            LOG_INFO ("Cancelled waiting for AI decompilation of function ID %llu", fn_id);
+            break;
+    }
+
+    return r;
+}
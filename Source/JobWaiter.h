@@ -0,0 +1,143 @@
+/**
+ * @file : JobWaiter.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Wait for a job running on RevEngAI servers (AI decompilation, analysis) to finish.
+ * Status is polled with exponential backoff and jitter, so short jobs are noticed
+ * quickly while long ones don't flood the API with status requests. Waiting can be
+ * bounded by a deadline and cancelled by caller.
+ * */
+
+#ifndef REAI_PLUGIN_JOB_WAITER
+#define REAI_PLUGIN_JOB_WAITER
+
+/* revenai */
+#include <Reai/Api.h>
+
+// Failed status requests (network errors) are retried this many times in a row
+#define JOB_WAIT_MAX_POLL_FAILURES 3
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum JobWaitResult {
+        JOB_WAIT_SUCCESS = 0, ///< Job completed successfully.
+        JOB_WAIT_FAILED,      ///< Job errored out, or it's status could not be fetched.
+        JOB_WAIT_TIMEOUT,     ///< Deadline passed before job completed.
+        JOB_WAIT_CANCELLED    ///< Caller cancelled the wait.
+    } JobWaitResult;
+
+    ///
+    /// Get current status of a job. Returning zero means status request failed, which is
+    /// retried a few times before giving up.
+    ///
+    typedef Status (*JobPollFn) (void* user);
+
+    typedef struct JobWaiter {
+        u64 initial_delay_ms; ///< Delay before second status check.
+        u64 max_delay_ms;     ///< Delay between status checks grows up to this.
+        u64 deadline_ms;      ///< Give up after waiting this long. Zero waits until job finishes.
+
+        ///
+        /// Checked frequently while waiting, return `true` to stop waiting. Can be `NULL`.
+        ///
+        bool (*is_cancelled) (void* user);
+
+        ///
+        /// Called after every status check with latest status. Can be `NULL`.
+        ///
+        void (*on_progress) (void* user, Status status, u32 attempt, u64 elapsed_ms);
+
+        void* user; ///< Passed to `is_cancelled` and `on_progress`.
+    } JobWaiter;
+
+    ///
+    /// Get waiter with default backoff, and no cancellation or progress callback.
+    ///
+    /// deadline_ms[in] : Maximum time to wait, zero to wait until job finishes.
+    ///
+    JobWaiter JobWaiterInit (u64 deadline_ms);
+
+    ///
+    /// Exponential backoff with equal jitter between status checks of one job. Jitter spreads
+    /// out checks of jobs that started together.
+    ///
+    typedef struct JobBackoff {
+        u64 delay_ms;     ///< Current delay, doubled after every step up to `max_delay_ms`.
+        u64 max_delay_ms;
+        u64 rng;          ///< xorshift64 state.
+    } JobBackoff;
+
+    ///
+    /// Get backoff state for a new job.
+    ///
+    /// initial_delay_ms[in] : Delay before second status check, zero for default.
+    /// max_delay_ms[in]     : Delay grows up to this, zero for default.
+    /// seed[in]             : Jitter seed, should differ between jobs waited for together.
+    ///
+    JobBackoff JobBackoffInit (u64 initial_delay_ms, u64 max_delay_ms, u64 seed);
+
+    ///
+    /// Get time to sleep before next status check, somewhere between half and full of current
+    /// delay, and grow delay for the check after that.
+    ///
+    u64 JobBackoffNext (JobBackoff* backoff);
+
+    ///
+    /// Poll status of a job until it succeeds, fails, deadline passes or wait is cancelled.
+    ///
+    /// waiter[in]      : Backoff, deadline and callbacks to use.
+    /// poll[in]        : Gets current status of job.
+    /// poll_user[in]   : Passed to `poll`.
+    /// last_status[out]: Last status received from `poll`. Can be `NULL`.
+    ///
+    /// SUCCESS : `JOB_WAIT_SUCCESS`
+    /// FAILURE : Reason why wait stopped.
+    ///
+    JobWaitResult JobWait (const JobWaiter* waiter, JobPollFn poll, void* poll_user, Status* last_status);
+
+    ///
+    /// State of status checks for one AI decompilation.
+    ///
+    typedef struct AiDecompilationPoll {
+        FunctionId fn_id;
+        bool       first; ///< No status received yet.
+    } AiDecompilationPoll;
+
+    AiDecompilationPoll AiDecompilationPollInit (FunctionId fn_id);
+
+    ///
+    /// Get status of an AI decompilation, starting it if it's not started already.
+    /// First error status is treated as a stale result and decompilation is restarted.
+    /// Can be used as a `JobPollFn` with an `AiDecompilationPoll` as it's argument, or called
+    /// directly to check many decompilations in one sweep.
+    ///
+    /// poll[in,out] : `AiDecompilationPoll` of decompilation.
+    ///
+    /// SUCCESS : Current status. `STATUS_PENDING` if decompilation was just started.
+    /// FAILURE : Zero if status request failed, `STATUS_ERROR` if decompilation could not be started.
+    ///
+    Status PollAiDecompilation (void* poll);
+
+    ///
+    /// Start AI decompilation of given function if it's not started already, and wait for it
+    /// to complete. First error status is treated as a stale result and decompilation is
+    /// restarted, every error after that fails the wait.
+    ///
+    /// Status is checked by decompilation tracker, together with every other decompilation
+    /// plugin is waiting for, so backoff settings of `waiter` are not used. Deadline,
+    /// cancellation and progress callback work as they do with `JobWait`.
+    ///
+    /// SUCCESS : `JOB_WAIT_SUCCESS`, decompilation can now be fetched.
+    /// FAILURE : Reason why wait stopped, with log messages.
+    ///
+    JobWaitResult WaitForAiDecompilation (const JobWaiter* waiter, FunctionId fn_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_JOB_WAITER
@@ -22,12 +22,22 @@
 #include <Reai/Log.h>
 #include <Reai/Types.h>
 
+/* curl */
+#include <curl/curl.h>
+
 /* libc */
+#include <rz_util/rz_path.h>
 #include <rz_util/rz_str.h>
 #include <rz_util/rz_sys.h>
 
 /* plugin includes */
+#include <Archive.h>
+#include <Cache.h>
+#include <DecompilationTracker.h>
+#include <DiffCache.h>
 #include <Plugin.h>
+#include <Prefetch.h>
+#include <TaskGroup.h>
 #include <stdlib.h>
 #include "PluginVersion.h"
 
@@ -36,6 +46,8 @@ typedef struct Plugin {
     Connection connection;
     BinaryId   binary_id;
     ModelInfos models;
+    u64        models_fetched_at;     ///< Wall clock time in microseconds.
+    u32        max_parallel_requests; ///< Cap on requests made at once by multi-function operations.
 } Plugin;
 
 #ifdef __cplusplus
@@ -47,11 +59,369 @@ typedef struct Plugin {
 #    define SRE_TOOL_VERSION RZ_VERSION
 #endif
 
+// Used when config does not specify `cache_dir` or `cache_size_mb`
+#define DEFAULT_CACHE_DIR     "~/.reai-rz/cache"
+#define DEFAULT_CACHE_SIZE_MB 256
+
+// Used when config does not specify `max_parallel_requests`
+#define DEFAULT_MAX_PARALLEL_REQUESTS 8
+#define MAX_PARALLEL_REQUESTS_LIMIT   64
+
+// Used when config enables `prefetch_callees` without a `prefetch_budget`
+#define DEFAULT_PREFETCH_BUDGET 32
+
+///
+/// Function ID index for one binary ID.
+///
+/// Entries are stored in a flat array in the order returned by RevEngAI servers, and an
+/// open-addressing table maps offset -> entry. Slots store entry index + 1, so a zero slot is
+/// empty. Addresses are stored exactly as returned by the server (without base
+/// address), callers subtract the current base address before lookup.
+///
+typedef struct FunctionIndexEntry {
+    u64        addr;
+    FunctionId id;
+} FunctionIndexEntry;
+
+typedef struct FunctionIndex {
+    BinaryId            binary_id;
+    FunctionIndexEntry *entries;
+    u64                 length;
+    u64                *by_addr;
+    u64                 capacity; // always a power of two
+} FunctionIndex;
+
+static FunctionIndex  function_index      = {0};
+static RzThreadLock  *function_index_lock = NULL;
+
+static RzThreadLock *functionIndexLock (void) {
+    // First call happens from getPlugin on main thread, before any worker thread exists.
+    if (!function_index_lock) {
+        function_index_lock = rz_th_lock_new (true);
+    }
+    return function_index_lock;
+}
+
+static u64 hashAddr (u64 addr) {
+    // splitmix64 finalizer
+    addr ^= addr >> 30;
+    addr *= 0xbf58476d1ce4e5b9ULL;
+    addr ^= addr >> 27;
+    addr *= 0x94d049bb133111ebULL;
+    addr ^= addr >> 31;
+    return addr;
+}
+
+static void functionIndexDeinit (FunctionIndex *index) {
+    free (index->entries);
+    free (index->by_addr);
+    memset (index, 0, sizeof (FunctionIndex));
+}
+
+static bool functionIndexInit (FunctionIndex *index, BinaryId binary_id, FunctionInfos *functions) {
+    memset (index, 0, sizeof (FunctionIndex));
+
+    // keep load factor at or below 0.5
+    u64 capacity = 16;
+    while (capacity < functions->length * 2) {
+        capacity <<= 1;
+    }
+
+    index->entries  = calloc (functions->length ? functions->length : 1, sizeof (FunctionIndexEntry));
+    index->by_addr  = calloc (capacity, sizeof (u64));
+    index->capacity = capacity;
+    if (!index->entries || !index->by_addr) {
+        LOG_ERROR ("Failed to allocate memory for function index");
+        functionIndexDeinit (index);
+        return false;
+    }
+
+    u64 mask = capacity - 1;
+    VecForeachPtr (functions, fn, {
+        FunctionIndexEntry *e = &index->entries[index->length];
+        e->addr               = fn->symbol.value.addr;
+        e->id                 = fn->id;
+        index->length++;
+
+        // first entry wins on duplicate keys, same as the linear scan it replaces
+        u64 slot = hashAddr (e->addr) & mask;
+        while (index->by_addr[slot] && index->entries[index->by_addr[slot] - 1].addr != e->addr) {
+            slot = (slot + 1) & mask;
+        }
+        if (!index->by_addr[slot]) {
+            index->by_addr[slot] = index->length;
+        }
+    });
+
+    index->binary_id = binary_id;
+    return true;
+}
+
+static FunctionIndexEntry *functionIndexFindAddr (FunctionIndex *index, u64 addr) {
+    if (!index->capacity) {
+        return NULL;
+    }
+
+    u64 mask = index->capacity - 1;
+    for (u64 slot = hashAddr (addr) & mask; index->by_addr[slot]; slot = (slot + 1) & mask) {
+        FunctionIndexEntry *e = &index->entries[index->by_addr[slot] - 1];
+        if (e->addr == addr) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// Replace current index with one built from given function list.
+static bool functionIndexRebuild (BinaryId binary_id, FunctionInfos *functions) {
+    FunctionIndex index = {0};
+    if (!functionIndexInit (&index, binary_id, functions)) {
+        return false;
+    }
+
+    rz_th_lock_enter (functionIndexLock());
+    functionIndexDeinit (&function_index);
+    function_index = index;
+    rz_th_lock_leave (functionIndexLock());
+
+    LOG_INFO ("Indexed %llu functions for binary ID %llu", index.length, binary_id);
+    return true;
+}
+
+///
+/// Analysis status cache. COMPLETE and ERROR never change once reached, so they are kept
+/// for the lifetime of the plugin. Any other status is refetched after a short time.
+///
+#define ANALYSIS_STATUS_CACHE_SIZE 16
+#define ANALYSIS_STATUS_TTL_US     (3 * 1000 * 1000)
+
+typedef struct AnalysisStatusEntry {
+    BinaryId binary_id;
+    Status   status;
+    u64      fetched_at; // monotonic time in microseconds
+} AnalysisStatusEntry;
+
+static AnalysisStatusEntry analysis_status_cache[ANALYSIS_STATUS_CACHE_SIZE] = {0};
+static RzThreadLock       *analysis_status_lock                              = NULL;
+
+static RzThreadLock *analysisStatusLock (void) {
+    // First call happens from getPlugin on main thread, before any worker thread exists.
+    if (!analysis_status_lock) {
+        analysis_status_lock = rz_th_lock_new (true);
+    }
+    return analysis_status_lock;
+}
+
+static bool isTerminalAnalysisStatus (Status status) {
+    return (status & STATUS_MASK) == STATUS_COMPLETE || (status & STATUS_MASK) == STATUS_ERROR;
+}
+
+static void analysisStatusCacheClear (void) {
+    rz_th_lock_enter (analysisStatusLock());
+    memset (analysis_status_cache, 0, sizeof (analysis_status_cache));
+    rz_th_lock_leave (analysisStatusLock());
+}
+
+///
+/// Rename sync suppression. While suppressed, the function rename hook does not push renames
+/// to RevEngAI. Used when the plugin itself applies names that came from (or were already sent
+/// to) RevEngAI. This is a process-wide counter, so nested sections work as expected.
+///
+static u32           rename_sync_suppressed      = 0;
+static RzThreadLock *rename_sync_suppressed_lock = NULL;
+
+static RzThreadLock *renameSyncSuppressedLock (void) {
+    // First call happens from getPlugin on main thread, before any worker thread exists.
+    if (!rename_sync_suppressed_lock) {
+        rename_sync_suppressed_lock = rz_th_lock_new (true);
+    }
+    return rename_sync_suppressed_lock;
+}
+
+void BeginRenameSyncSuppression() {
+    rz_th_lock_enter (renameSyncSuppressedLock());
+    rename_sync_suppressed++;
+    rz_th_lock_leave (renameSyncSuppressedLock());
+}
+
+void EndRenameSyncSuppression() {
+    rz_th_lock_enter (renameSyncSuppressedLock());
+    if (rename_sync_suppressed) {
+        rename_sync_suppressed--;
+    } else {
+        LOG_ERROR ("Unbalanced rename sync suppression end");
+    }
+    rz_th_lock_leave (renameSyncSuppressedLock());
+}
+
+bool IsRenameSyncSuppressed() {
+    rz_th_lock_enter (renameSyncSuppressedLock());
+    bool suppressed = rename_sync_suppressed != 0;
+    rz_th_lock_leave (renameSyncSuppressedLock());
+    return suppressed;
+}
+
+///
+/// AI models list is persisted in response cache along with time it was fetched at. A list older
+/// than `AI_MODELS_REFRESH_US` is still served, while a fresh one is fetched in background.
+///
+#define AI_MODELS_REFRESH_US (24ULL * 60 * 60 * 1000 * 1000)
+
+///
+/// When no list is known and a fetch fails, next fetch is started only after this long, so that
+/// polling `GetModels` while offline doesn't start a new fetch thread on every call.
+///
+#define AI_MODELS_RETRY_US (60ULL * 1000 * 1000)
+
+///
+/// `thread` and `connection` are only read and written on main thread, so they need no lock.
+/// Worker thread only writes `models` and `is_done`, with `modelsRefreshLock` held.
+///
+typedef struct ModelsRefresh {
+    RzThread  *thread;
+    Connection connection; ///< Copy of plugin connection, plugin may be reloaded while thread runs.
+    ModelInfos models;     ///< Fetched list, picked up by next `GetModels` call.
+    bool       is_done;
+} ModelsRefresh;
+
+static ModelsRefresh models_refresh      = {0};
+static RzThreadLock *models_refresh_lock = NULL;
+
+static RzThreadLock *modelsRefreshLock (void) {
+    // First call happens from getPlugin on main thread, before any worker thread exists.
+    if (!models_refresh_lock) {
+        models_refresh_lock = rz_th_lock_new (false);
+    }
+    return models_refresh_lock;
+}
+
+static void modelsSaveToCache (ModelInfos *models, u64 fetched_at) {
+    CacheBuffer buf = {0};
+    CacheBufferWriteU64 (&buf, fetched_at);
+    CacheBufferWriteU64 (&buf, models->length);
+    VecForeachPtr (models, model, {
+        CacheBufferWriteU64 (&buf, model->id);
+        CacheBufferWriteStr (&buf, &model->name);
+    });
+    CachePut (CACHE_KIND_AI_MODELS, 0, NULL, &buf);
+    CacheBufferDeinit (&buf);
+}
+
+static bool modelsLoadFromCache (ModelInfos *models, u64 *fetched_at) {
+    CacheBuffer buf = {0};
+    if (!CacheGet (CACHE_KIND_AI_MODELS, 0, NULL, &buf)) {
+        return false;
+    }
+
+    ModelInfos loaded = VecInitWithDeepCopy_T (&loaded, NULL, ModelInfoDeinit);
+    u64        time   = CacheBufferReadU64 (&buf);
+    u64        count  = CacheBufferReadU64 (&buf);
+    for (u64 i = 0; i < count && !buf.failed; i++) {
+        ModelInfo model = {0};
+        model.id        = CacheBufferReadU64 (&buf);
+        model.name      = CacheBufferReadStr (&buf);
+        VecPushBack (&loaded, model);
+    }
+
+    bool ok = !buf.failed && loaded.length;
+    CacheBufferDeinit (&buf);
+    if (!ok) {
+        VecDeinit (&loaded);
+        return false;
+    }
+
+    VecDeinit (models);
+    *models     = loaded;
+    *fetched_at = time;
+    return true;
+}
+
+static void *modelsRefreshWorker (void *user) {
+    (void)user;
+
+    ModelInfos models = GetAiModelInfos (&models_refresh.connection);
+    if (models.length) {
+        modelsSaveToCache (&models, rz_time_now());
+    } else {
+        LOG_ERROR ("Failed to refresh AI models list in background");
+    }
+
+    rz_th_lock_enter (modelsRefreshLock());
+    models_refresh.models  = models;
+    models_refresh.is_done = true;
+    rz_th_lock_leave (modelsRefreshLock());
+
+    return NULL;
+}
+
+// Must be called from main thread
+static void modelsRefreshStart (Connection *connection) {
+    if (models_refresh.thread) {
+        return;
+    }
+
+    models_refresh.connection.host       = StrInitFromStr (&connection->host);
+    models_refresh.connection.api_key    = StrInitFromStr (&connection->api_key);
+    models_refresh.connection.user_agent = StrInitFromStr (&connection->user_agent);
+    models_refresh.models                = (ModelInfos) {0};
+    models_refresh.is_done               = false;
+
+    models_refresh.thread = rz_th_new (modelsRefreshWorker, NULL);
+    if (!models_refresh.thread) {
+        LOG_ERROR ("Failed to start AI models refresh thread");
+        StrDeinit (&models_refresh.connection.host);
+        StrDeinit (&models_refresh.connection.api_key);
+        StrDeinit (&models_refresh.connection.user_agent);
+    }
+}
+
+// Must be called from main thread. Waits for refresh to complete if `wait` is set.
+// Returns `true` with fetched list in `models` (empty if fetch failed) if a refresh has completed.
+static bool modelsRefreshCollect (bool wait, ModelInfos *models) {
+    if (!models_refresh.thread) {
+        return false;
+    }
+
+    rz_th_lock_enter (modelsRefreshLock());
+    bool is_done = models_refresh.is_done;
+    rz_th_lock_leave (modelsRefreshLock());
+    if (!is_done && !wait) {
+        return false;
+    }
+
+    rz_th_wait (models_refresh.thread);
+    rz_th_free (models_refresh.thread);
+
+    *models = models_refresh.models;
+    StrDeinit (&models_refresh.connection.host);
+    StrDeinit (&models_refresh.connection.api_key);
+    StrDeinit (&models_refresh.connection.user_agent);
+    memset (&models_refresh, 0, sizeof (models_refresh));
+
+    return true;
+}
+
+void PluginShutdown() {
+    ModelInfos pending_models = {0};
+    if (modelsRefreshCollect (true, &pending_models)) {
+        VecDeinit (&pending_models);
+    }
+
+    // Prefetcher writes to cache and waits on tracker, stop it first
+    PrefetchShutdown();
+    DecompilationTrackerShutdown();
+    DiffCacheShutdown();
+    CacheDeinit();
+    ArchiveUnmount();
+}
+
 void pluginDeinit (Plugin *p) {
     if (!p) {
         LOG_FATAL ("Invalid argument");
     }
 
+    PluginShutdown();
+
     StrDeinit (&p->connection.api_key);
     StrDeinit (&p->connection.host);
     ConfigDeinit (&p->config);
@@ -59,10 +429,42 @@ void pluginDeinit (Plugin *p) {
     memset (p, 0, sizeof (Plugin));
 }
 
+///
+/// creait creates it's transfers internally, but global libcurl state (TLS backend, resolver)
+/// must be set up once before any thread makes a request. Leaving it to first request is not
+/// thread-safe, and requests are made from worker threads as well. Never cleaned up, because
+/// libcurl may still be in use by Rizin or other plugins after this plugin is unloaded.
+///
+static void transportInit (void) {
+    static bool is_inited = false;
+    if (is_inited) {
+        return;
+    }
+
+    CURLcode rc = curl_global_init (CURL_GLOBAL_DEFAULT);
+    if (rc != CURLE_OK) {
+        LOG_ERROR ("Failed to initialize libcurl : %s", curl_easy_strerror (rc));
+        return;
+    }
+
+    is_inited = true;
+}
+
 Plugin *getPlugin (bool reinit) {
     static Plugin p;
     static bool   is_inited = false;
 
+    // All of these must happen on main thread, before any request or worker thread
+    transportInit();
+    functionIndexLock();
+    analysisStatusLock();
+    renameSyncSuppressedLock();
+    modelsRefreshLock();
+    ArchiveInit();
+    DecompilationTrackerInit();
+    DiffCacheInit();
+    PrefetchInit();
+
     if (reinit) {
         if (!is_inited) {
             p.config             = ConfigInit();
@@ -105,12 +507,47 @@ Plugin *getPlugin (bool reinit) {
         p.connection.user_agent =
             StrInitFromZstr ("reai_rz-" REAI_PLUGIN_VERSION " (" SRE_TOOL_NAME "-version = " SRE_TOOL_VERSION ")");
 
-        // Get AI models, this way we also perform an implicit auth-check
-        p.models = GetAiModelInfos (&p.connection);
+        // Response cache is optional, plugin works without it
+        Str  *cache_dir_cfg  = ConfigGet (&p.config, "cache_dir");
+        Str  *cache_size_cfg = ConfigGet (&p.config, "cache_size_mb");
+        u64   cache_size_mb  = cache_size_cfg ? strtoull (cache_size_cfg->data, NULL, 0) : DEFAULT_CACHE_SIZE_MB;
+        char *cache_dir      = rz_path_home_expand (cache_dir_cfg ? cache_dir_cfg->data : DEFAULT_CACHE_DIR);
+        if (cache_dir) {
+            CacheInit (cache_dir, cache_size_mb * 1024 * 1024, p.connection.host.data);
+            free (cache_dir);
+        }
+
+        Str *parallel_cfg       = ConfigGet (&p.config, "max_parallel_requests");
+        u64  parallel           = parallel_cfg ? strtoull (parallel_cfg->data, NULL, 0) : DEFAULT_MAX_PARALLEL_REQUESTS;
+        p.max_parallel_requests = (u32)CLAMP (parallel, 1, MAX_PARALLEL_REQUESTS_LIMIT);
+
+        // Prefetching decompilation of callees costs server time, so it's opt-in
+        Str *prefetch_cfg        = ConfigGet (&p.config, "prefetch_callees");
+        Str *prefetch_budget_cfg = ConfigGet (&p.config, "prefetch_budget");
+        u64  prefetch_budget =
+            prefetch_budget_cfg ? strtoull (prefetch_budget_cfg->data, NULL, 0) : DEFAULT_PREFETCH_BUDGET;
+        PrefetchConfigure (
+            prefetch_cfg && rz_str_is_true (prefetch_cfg->data),
+            (u32)MIN2 (prefetch_budget, UT32_MAX),
+            MIN2 (p.max_parallel_requests, 4)
+        );
+
+        // Responses exported on another machine, for use without network
+        Str *archive_cfg = ConfigGet (&p.config, "offline_archive");
+        if (archive_cfg && archive_cfg->length) {
+            char *archive_path = rz_path_home_expand (archive_cfg->data);
+            if (archive_path && ArchiveMount (archive_path)) {
+                p.binary_id = ArchiveGetBinaryId (NULL);
+            } else {
+                DISPLAY_ERROR ("Failed to load offline archive '%s'", archive_cfg->data);
+            }
+            free (archive_path);
+        }
+
+        // Start fetching AI models list if none is known, so it's ready when a dialog or command needs it
+        modelsLoadFromCache (&p.models, &p.models_fetched_at);
         if (!p.models.length) {
-            DISPLAY_ERROR ("Failed to get AI models. Please check host and API key in config.");
-            pluginDeinit (&p);
-            return NULL;
+            modelsRefreshStart (&p.connection);
         }
 
         is_inited = true;
@@ -119,6 +556,11 @@ Plugin *getPlugin (bool reinit) {
 }
 
 void ReloadPluginData() {
+    rz_th_lock_enter (functionIndexLock());
+    functionIndexDeinit (&function_index);
+    rz_th_lock_leave (functionIndexLock());
+    analysisStatusCacheClear();
+
     getPlugin (true);
 }
 
@@ -139,6 +581,11 @@ Connection *GetConnection() {
     }
 }
 
+u32 GetMaxParallelRequests() {
+    Plugin *p = getPlugin (false);
+    return p ? p->max_parallel_requests : 1;
+}
+
 BinaryId GetBinaryId() {
     // First try to get from local plugin instance
     if (getPlugin (false)) {
@@ -177,6 +624,49 @@ BinaryId GetBinaryIdFromCore (RzCore *core) {
     return 0;
 }
 
+bool LoadFunctionIndex (BinaryId binary_id, bool force_refresh) {
+    if (!binary_id) {
+        return false;
+    }
+
+    if (!force_refresh) {
+        rz_th_lock_enter (functionIndexLock());
+        bool is_built = function_index.binary_id == binary_id;
+        rz_th_lock_leave (functionIndexLock());
+        if (is_built) {
+            return true;
+        }
+    }
+
+    // Network request happens outside the lock, lookups on other threads are not blocked meanwhile.
+    FunctionInfos functions = GetFunctionInfosCached (binary_id, force_refresh);
+    if (!functions.length) {
+        LOG_ERROR ("Failed to get function info list for binary ID %llu", binary_id);
+        VecDeinit (&functions);
+        return false;
+    }
+
+    bool ok = functionIndexRebuild (binary_id, &functions);
+    VecDeinit (&functions);
+    return ok;
+}
+
+FunctionId GetFunctionIdForOffset (BinaryId binary_id, u64 offset) {
+    if (!binary_id || !LoadFunctionIndex (binary_id, false)) {
+        return 0;
+    }
+
+    FunctionId id = 0;
+    rz_th_lock_enter (functionIndexLock());
+    if (function_index.binary_id == binary_id) {
+        FunctionIndexEntry *e = functionIndexFindAddr (&function_index, offset);
+        id                    = e ? e->id : 0;
+    }
+    rz_th_lock_leave (functionIndexLock());
+
+    return id;
+}
+
 void SetBinaryId (BinaryId binary_id) {
     // Set in local plugin instance
     if (getPlugin (false)) {
@@ -198,13 +688,61 @@ void SetBinaryIdInCore (RzCore *core, BinaryId binary_id) {
     }
 }
 
-ModelInfos *GetModels() {
-    if (getPlugin (false)) {
-        return &getPlugin (false)->models;
-    } else {
+static ModelInfos *modelsGet (bool wait) {
+    Plugin *p = getPlugin (false);
+    if (!p) {
         static ModelInfos empty_models_vec = VecInitWithDeepCopy (ModelInfoInitClone, ModelInfoDeinit);
         return &empty_models_vec;
     }
+
+    if (!p->models.length) {
+        modelsLoadFromCache (&p->models, &p->models_fetched_at);
+    }
+
+    // Nothing to serve, make sure a fetch is running (does nothing if one already is).
+    // After a failed fetch, wait a while before trying again, unless caller is willing to wait.
+    u64 now = rz_time_now();
+    if (!p->models.length &&
+        (wait || now < p->models_fetched_at || now - p->models_fetched_at > AI_MODELS_RETRY_US)) {
+        modelsRefreshStart (&p->connection);
+    }
+
+    // Pick up result of a background refresh, waiting for it only if there's nothing else to serve.
+    // Time of completion is recorded even on failure. An old list is then kept and not refreshed
+    // until it's stale again, and with no list next fetch is delayed by `AI_MODELS_RETRY_US`.
+    ModelInfos refreshed = {0};
+    if (modelsRefreshCollect (wait && !p->models.length, &refreshed)) {
+        if (refreshed.length) {
+            VecDeinit (&p->models);
+            p->models = refreshed;
+        } else {
+            VecDeinit (&refreshed);
+            if (wait && !p->models.length) {
+                DISPLAY_ERROR ("Failed to get AI models. Please check host and API key in config.");
+            }
+        }
+        p->models_fetched_at = rz_time_now();
+    }
+
+    now = rz_time_now();
+    if (p->models.length && (now < p->models_fetched_at || now - p->models_fetched_at > AI_MODELS_REFRESH_US)) {
+        modelsRefreshStart (&p->connection);
+    }
+
+    return &p->models;
+}
+
+ModelInfos *GetModels() {
+    return modelsGet (false);
+}
+
+ModelInfos *WaitForModels() {
+    return modelsGet (true);
+}
+
+// Reads `models_refresh.thread` without lock, see `ModelsRefresh`
+bool IsModelsRefreshPending() {
+    return models_refresh.thread != NULL;
 }
 
 AnnSymbol *rzGetMostSimilarFunctionSymbol (AnnSymbols *symbols, FunctionId origin_fn_id) {
@@ -227,6 +765,131 @@ AnnSymbol *rzGetMostSimilarFunctionSymbol (AnnSymbols *symbols, FunctionId origi
     return most_similar_fn;
 }
 
+void AnnSymbolIndexDeinit (AnnSymbolIndex *index) {
+    if (!index) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    free (index->order);
+    free (index->group_start);
+    free (index->group_keys);
+    free (index->slots);
+    memset (index, 0, sizeof (AnnSymbolIndex));
+}
+
+static u64 annSymbolIndexFind (AnnSymbolIndex *index, FunctionId origin_fn_id) {
+    u64 mask = index->capacity - 1;
+    u64 slot = hashAddr (origin_fn_id) & mask;
+    while (index->slots[slot] && index->group_keys[index->slots[slot] - 1] != origin_fn_id) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool AnnSymbolIndexInit (AnnSymbolIndex *index, AnnSymbols *symbols) {
+    if (!index || !symbols) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    memset (index, 0, sizeof (AnnSymbolIndex));
+    index->symbols = symbols;
+
+    u64 n        = symbols->length;
+    u64 capacity = 16;
+    while (capacity < n * 2) {
+        capacity <<= 1;
+    }
+
+    // group_of is scratch space : group index of each symbol
+    u64 *group_of      = calloc (n ? n : 1, sizeof (u64));
+    index->order       = calloc (n ? n : 1, sizeof (u64));
+    index->group_start = calloc (n + 2, sizeof (u64));
+    index->group_keys  = calloc (n ? n : 1, sizeof (FunctionId));
+    index->slots       = calloc (capacity, sizeof (u64));
+    index->capacity    = capacity;
+    if (!group_of || !index->order || !index->group_start || !index->group_keys || !index->slots) {
+        LOG_ERROR ("Failed to allocate memory for similar symbols index");
+        free (group_of);
+        AnnSymbolIndexDeinit (index);
+        index->symbols = symbols;
+        return false;
+    }
+
+    // Pass 1 : assign group to each symbol and count group sizes (in group_start[g + 1])
+    for (u64 i = 0; i < n; i++) {
+        FunctionId id   = VecPtrAt (symbols, i)->source_function_id;
+        u64        slot = annSymbolIndexFind (index, id);
+        if (!index->slots[slot]) {
+            index->group_keys[index->group_count] = id;
+            index->slots[slot]                    = ++index->group_count;
+        }
+        group_of[i] = index->slots[slot] - 1;
+        index->group_start[group_of[i] + 1]++;
+    }
+
+    for (u64 g = 0; g < index->group_count; g++) {
+        index->group_start[g + 1] += index->group_start[g];
+    }
+
+    // Pass 2 : scatter symbols into their groups, keeping each group sorted by distance.
+    // Groups are at most `limit` symbols long, so insertion is cheap.
+    u64 *fill = calloc (index->group_count ? index->group_count : 1, sizeof (u64));
+    if (!fill) {
+        LOG_ERROR ("Failed to allocate memory for similar symbols index");
+        free (group_of);
+        AnnSymbolIndexDeinit (index);
+        index->symbols = symbols;
+        return false;
+    }
+
+    for (u64 i = 0; i < n; i++) {
+        u64  g     = group_of[i];
+        u64 *group = index->order + index->group_start[g];
+        f64  dist  = VecPtrAt (symbols, i)->distance;
+
+        u64 pos = fill[g]++;
+        while (pos && VecPtrAt (symbols, group[pos - 1])->distance > dist) {
+            group[pos] = group[pos - 1];
+            pos--;
+        }
+        group[pos] = i;
+    }
+
+    free (fill);
+    free (group_of);
+    return true;
+}
+
+AnnSymbol *AnnSymbolIndexGetBest (AnnSymbolIndex *index, FunctionId origin_fn_id) {
+    AnnSymbol *best = NULL;
+    AnnSymbolIndexGetTopK (index, origin_fn_id, &best, 1);
+    return best;
+}
+
+size AnnSymbolIndexGetTopK (AnnSymbolIndex *index, FunctionId origin_fn_id, AnnSymbol **matches, size k) {
+    if (!index || !matches) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!index->capacity || !k) {
+        return 0;
+    }
+
+    u64 slot = annSymbolIndexFind (index, origin_fn_id);
+    if (!index->slots[slot]) {
+        return 0;
+    }
+
+    u64  g     = index->slots[slot] - 1;
+    u64 *group = index->order + index->group_start[g];
+    size count = MIN2 (k, index->group_start[g + 1] - index->group_start[g]);
+    for (size i = 0; i < count; i++) {
+        matches[i] = VecPtrAt (index->symbols, group[i]);
+    }
+
+    return count;
+}
+
 FunctionInfos getFunctionBoundaries (RzCore *core) {
     if (!core) {
         DISPLAY_FATAL ("Invalid argument: Invalid rizin core provided.");
@@ -261,6 +924,16 @@ void rzApplyAnalysis (RzCore *core, BinaryId binary_id) {
     }
 
     if (rzCanWorkWithAnalysis (binary_id, true)) {
+        // Always fetch latest names, this also refreshes the cached list
+        FunctionInfos functions = GetFunctionInfosCached (binary_id, true);
+        if (!functions.length) {
+            DISPLAY_ERROR ("Failed to get functions from RevEngAI analysis.");
+            return;
+        }
+
+        // Reuse fetched list for function ID index, so setting binary ID below won't fetch it again
+        functionIndexRebuild (binary_id, &functions);
+
         // Set binary ID BEFORE applying analysis so that function rename hooks work properly
         SetBinaryId (binary_id);
 
@@ -268,14 +941,11 @@ void rzApplyAnalysis (RzCore *core, BinaryId binary_id) {
         SetBinaryIdInCore (core, binary_id);
         LOG_INFO ("Set binary ID %llu in both local plugin and RzCore config", binary_id);
 
-        FunctionInfos functions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), binary_id);
-        if (!functions.length) {
-            DISPLAY_ERROR ("Failed to get functions from RevEngAI analysis.");
-            return;
-        }
-
         u64  base_addr = rzGetCurrentBinaryBaseAddr (core);
         bool failed    = false;
+
+        // Names come from RevEngAI, don't send them back through the rename hook
+        BeginRenameSyncSuppression();
         VecForeachPtr (&functions, function, {
             u64                 addr = function->symbol.value.addr + base_addr;
             RzAnalysisFunction *fn   = rz_analysis_get_function_at (core->analysis, addr);
@@ -286,6 +956,7 @@ void rzApplyAnalysis (RzCore *core, BinaryId binary_id) {
             }
             rz_analysis_function_force_rename (fn, function->symbol.name.data);
         });
+        EndRenameSyncSuppression();
 
         if (!failed) {
             DISPLAY_INFO ("All functions renamed successfully");
@@ -300,14 +971,65 @@ void rzApplyAnalysis (RzCore *core, BinaryId binary_id) {
     }
 }
 
-FunctionId rizinFunctionToId (FunctionInfos *functions, RzAnalysisFunction *fn, u64 base_addr) {
-    VecForeach (functions, function, {
-        if (function.symbol.value.addr + base_addr == fn->addr) {
-            return function.id;
+FunctionId rizinFunctionToId (BinaryId binary_id, RzAnalysisFunction *fn, u64 base_addr) {
+    return GetFunctionIdForOffset (binary_id, fn->addr - base_addr);
+}
+
+void FunctionRenameDeinit (FunctionRename *rename) {
+    if (!rename) {
+        LOG_FATAL ("Invalid argument");
+    }
+    StrDeinit (&rename->new_name);
+    memset (rename, 0, sizeof (FunctionRename));
+}
+
+static void *renameTask (void *user) {
+    FunctionRename *r = user;
+
+    r->synced = RenameFunction (GetConnection(), r->function_id, r->new_name);
+    if (r->synced) {
+        LOG_INFO ("Synced function rename with RevEngAI: '%s' (ID: %llu)", r->new_name.data, r->function_id);
+    } else {
+        LOG_ERROR ("Failed to sync function rename with RevEngAI: '%s' (ID: %llu)", r->new_name.data, r->function_id);
+    }
+
+    return NULL;
+}
+
+size BatchRenameFunctions (FunctionRenames *renames) {
+    if (!renames) {
+        LOG_FATAL ("Invalid argument");
+    }
+
+    if (!renames->length) {
+        return 0;
+    }
+
+    TaskGroup *group = TaskGroupNew (GetMaxParallelRequests());
+    if (group) {
+        VecForeachPtr (renames, r, {
+            if (!TaskGroupSubmit (group, renameTask, r)) {
+                renameTask (r);
+            }
+        });
+
+        u64   task   = 0;
+        void *result = NULL;
+        while (TaskGroupWaitNext (group, &task, &result)) {}
+        TaskGroupFree (group, NULL);
+    } else {
+        LOG_ERROR ("Failed to create task group, renaming functions serially");
+        VecForeachPtr (renames, r, { renameTask (r); });
+    }
+
+    size synced = 0;
+    VecForeachPtr (renames, r, {
+        if (r->synced) {
+            synced++;
         }
     });
 
-    return 0;
+    return synced;
 }
 
 void rzAutoRenameFunctions (RzCore *core, size max_results_per_function, u32 min_similarity, bool debug_symbols_only) {
@@ -331,13 +1053,20 @@ void rzAutoRenameFunctions (RzCore *core, size max_results_per_function, u32 min
             return;
         }
 
-        u64           base_addr = rzGetCurrentBinaryBaseAddr (core);
-        FunctionInfos functions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), GetBinaryId());
+        AnnSymbolIndex best_matches;
+        AnnSymbolIndexInit (&best_matches, &map);
+
+        u64 base_addr = rzGetCurrentBinaryBaseAddr (core);
+
+        // Collect whole rename set first and send it in one go.
+        // renamed_fns[i] is the Rizin function for renames[i].
+        FunctionRenames renames     = VecInitWithDeepCopy_T (&renames, NULL, FunctionRenameDeinit);
+        RzList         *renamed_fns = rz_list_new();
 
         RzListIter         *it = NULL;
         RzAnalysisFunction *fn = NULL;
         rz_list_foreach (core->analysis->fcns, it, fn) {
-            FunctionId id = rizinFunctionToId (&functions, fn, base_addr);
+            FunctionId id = rizinFunctionToId (GetBinaryId(), fn, base_addr);
             if (!id) {
                 LOG_ERROR (
                     "Failed to get a function ID for function with name = '%s' at address = 0x%llx",
@@ -347,37 +1076,42 @@ void rzAutoRenameFunctions (RzCore *core, size max_results_per_function, u32 min
                 continue;
             }
 
-            AnnSymbol *best_match = rzGetMostSimilarFunctionSymbol (&map, id);
+            AnnSymbol *best_match = AnnSymbolIndexGetBest (&best_matches, id);
             if (best_match) {
-                // Sync with cloud
-                FunctionId fn_id = rzLookupFunctionId (core, fn);
-                if (fn_id) {
-                    if (RenameFunction (GetConnection(), fn_id, best_match->function_name)) {
-                        LOG_INFO ("Renamed '%s' to '%s'", fn->name, best_match->function_name.data);
-                        rz_analysis_function_force_rename (fn, best_match->function_name.data);
-                        LOG_INFO (
-                            "Successfully synced function rename with RevEngAI: '%s' (ID: %llu)",
-                            fn->name,
-                            fn_id
-                        );
-                    } else {
-                        LOG_ERROR (
-                            "Failed to sync function rename with RevEngAI for function '%s' (ID: %llu)",
-                            fn->name,
-                            fn_id
-                        );
-                    }
-                } else {
-                    LOG_ERROR (
-                        "Failed to get function ID for function with name = '%s' at address = 0x%llx",
-                        fn->name,
-                        fn->addr
-                    );
-                }
+                FunctionRename r = {.function_id = id, .new_name = StrDup (&best_match->function_name)};
+                VecPushBack (&renames, r);
+                rz_list_append (renamed_fns, fn);
             }
         }
 
-        VecDeinit (&functions);
+        size synced = BatchRenameFunctions (&renames);
+        if (synced) {
+            InvalidateFunctionInfosCache (GetBinaryId());
+        }
+
+        // Already synced above, don't send these again through the rename hook
+        BeginRenameSyncSuppression();
+        size idx = 0;
+        rz_list_foreach (renamed_fns, it, fn) {
+            FunctionRename *r = VecPtrAt (&renames, idx++);
+            if (r->synced) {
+                LOG_INFO ("Renamed '%s' to '%s'", fn->name, r->new_name.data);
+                rz_analysis_function_force_rename (fn, r->new_name.data);
+            } else {
+                APPEND_ERROR ("Failed to rename '%s' to '%s'", fn->name, r->new_name.data);
+            }
+        }
+        EndRenameSyncSuppression();
+
+        if (synced == renames.length) {
+            DISPLAY_INFO ("Renamed %zu functions.", synced);
+        } else {
+            DISPLAY_ERROR ("Renamed %zu functions, %zu failed.", synced, renames.length - synced);
+        }
+
+        rz_list_free (renamed_fns);
+        VecDeinit (&renames);
+        AnnSymbolIndexDeinit (&best_matches);
         VecDeinit (&map);
     } else {
         DISPLAY_ERROR (
@@ -389,13 +1123,113 @@ void rzAutoRenameFunctions (RzCore *core, size max_results_per_function, u32 min
     // TODO: upload renamed functions name to reveng.ai as well
 }
 
+FunctionInfos GetFunctionInfosCached (BinaryId binary_id, bool force_refresh) {
+    FunctionInfos functions = VecInitWithDeepCopy_T (&functions, NULL, FunctionInfoDeinit);
+    if (!binary_id) {
+        return functions;
+    }
+
+    if (!force_refresh && CacheGetFunctionInfos (binary_id, &functions)) {
+        return functions;
+    }
+
+    functions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), binary_id);
+    if (functions.length) {
+        CachePutFunctionInfos (binary_id, &functions);
+    }
+
+    return functions;
+}
+
+void InvalidateFunctionInfosCache (BinaryId binary_id) {
+    if (binary_id) {
+        CacheInvalidate (CACHE_KIND_FUNCTION_INFOS, binary_id, NULL);
+    }
+}
+
+SimilarFunctions GetSimilarFunctionsCached (SimilarFunctionsRequest *search) {
+    SimilarFunctions functions = {0};
+    if (!search) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (CacheGetSimilarFunctions (search, &functions)) {
+        return functions;
+    }
+
+    // Failed requests also return nothing, so empty results are not cached
+    functions = GetSimilarFunctions (GetConnection(), search);
+    if (functions.length) {
+        CachePutSimilarFunctions (search, &functions);
+    }
+
+    return functions;
+}
+
+Status GetAnalysisStatusCached (BinaryId binary_id, bool force_refresh) {
+    if (!binary_id) {
+        return 0;
+    }
+
+    // Archives are exported only from complete analyses
+    if (binary_id == ArchiveGetBinaryId (NULL)) {
+        return STATUS_COMPLETE;
+    }
+
+    u64 now = rz_time_now_mono();
+
+    if (!force_refresh) {
+        Status status = 0;
+        rz_th_lock_enter (analysisStatusLock());
+        for (size i = 0; i < ANALYSIS_STATUS_CACHE_SIZE; i++) {
+            AnalysisStatusEntry *e = &analysis_status_cache[i];
+            if (e->binary_id == binary_id &&
+                (isTerminalAnalysisStatus (e->status) || now - e->fetched_at < ANALYSIS_STATUS_TTL_US)) {
+                status = e->status;
+                break;
+            }
+        }
+        rz_th_lock_leave (analysisStatusLock());
+
+        if (status) {
+            return status;
+        }
+    }
+
+    Status status = GetAnalysisStatus (GetConnection(), binary_id);
+    if (!(status & STATUS_MASK)) {
+        // Don't remember failed requests
+        return status;
+    }
+
+    // Update existing entry, or replace the least recently fetched one
+    rz_th_lock_enter (analysisStatusLock());
+    AnalysisStatusEntry *slot = &analysis_status_cache[0];
+    for (size i = 0; i < ANALYSIS_STATUS_CACHE_SIZE; i++) {
+        AnalysisStatusEntry *e = &analysis_status_cache[i];
+        if (e->binary_id == binary_id) {
+            slot = e;
+            break;
+        }
+        if (e->fetched_at < slot->fetched_at) {
+            slot = e;
+        }
+    }
+    slot->binary_id  = binary_id;
+    slot->status     = status;
+    slot->fetched_at = now;
+    rz_th_lock_leave (analysisStatusLock());
+
+    return status;
+}
+
 bool rzCanWorkWithAnalysis (BinaryId binary_id, bool display_messages) {
     if (!binary_id) {
         APPEND_ERROR ("Invalid arguments: Invalid binary ID");
         return false;
     }
 
-    Status status = GetAnalysisStatus (GetConnection(), binary_id);
+    Status status = GetAnalysisStatusCached (binary_id, false);
     if (!display_messages) {
         return ((status & STATUS_MASK) == STATUS_COMPLETE);
     } else {
@@ -457,31 +1291,16 @@ FunctionId rzLookupFunctionId (RzCore *core, RzAnalysisFunction *rz_fn) {
         return 0;
     }
 
-    FunctionInfos functions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), binary_id);
-    if (!functions.length) {
+    if (!LoadFunctionIndex (binary_id, false)) {
         APPEND_ERROR ("Failed to get function info list for opened binary file from RevEng.AI servers.");
         return 0;
     }
 
-    u64 base_addr = rzGetCurrentBinaryBaseAddr (core);
-
-    FunctionId id = 0;
-    VecForeachPtr (&functions, fn, {
-        if (rz_fn->addr == fn->symbol.value.addr + base_addr) {
-            LOG_INFO (
-                "RizinFunction -> [FunctionName, FunctionID] :: \"%s\" -> [\"%s\", %llu]",
-                rz_fn->name,
-                fn->symbol.name.data,
-                fn->id
-            );
-            id = fn->id;
-            break;
-        }
-    });
-
-    VecDeinit (&functions);
-
-    if (!id) {
+    u64        base_addr = rzGetCurrentBinaryBaseAddr (core);
+    FunctionId id        = GetFunctionIdForOffset (binary_id, rz_fn->addr - base_addr);
+    if (id) {
+        LOG_INFO ("RizinFunction -> FunctionID :: \"%s\" -> %llu", rz_fn->name, id);
+    } else {
         APPEND_ERROR ("Function ID not found\"%s\"", rz_fn->name);
     }
 
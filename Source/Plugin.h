@@ -27,12 +27,49 @@
 extern "C" {
 #endif
 
+    ///
+    /// A function rename to be sent to RevEngAI, along with it's result.
+    ///
+    typedef struct FunctionRename {
+        FunctionId function_id;
+        Str        new_name;
+        bool       synced; ///< Set after `BatchRenameFunctions` returns.
+    } FunctionRename;
+
+    typedef Vec (FunctionRename) FunctionRenames;
+
+    void FunctionRenameDeinit (FunctionRename* rename);
+
+    ///
+    /// Matches in an `AnnSymbols` vector grouped by source function ID, each group ordered
+    /// from most to least similar. Build once after `GetBatchAnnSymbols` returns, and then
+    /// query matches of any source function in O(1).
+    ///
+    /// Index only refers to symbols in the vector it was built from. That vector must not
+    /// be modified or deinited while index is in use.
+    ///
+    typedef struct AnnSymbolIndex {
+        AnnSymbols* symbols;
+        u64*        order;       ///< Symbol indices, grouped by source function, best match first.
+        u64*        group_start; ///< Group `g` is `order[group_start[g]..group_start[g + 1])`.
+        FunctionId* group_keys;  ///< Source function ID of each group.
+        u64*        slots;       ///< Open addressing table of (group index + 1), zero means empty.
+        u64         capacity;    ///< Number of slots, always a power of two.
+        u64         group_count;
+    } AnnSymbolIndex;
+
 
     ///
     /// Reinit plugin by deiniting current internal state and reloading config
     ///
     void ReloadPluginData();
 
+    ///
+    /// Wait for background work of plugin to finish and save persistent state to disk.
+    /// Must be called from main thread when plugin is unloaded.
+    ///
+    void PluginShutdown();
+
     ///
     /// Get loaded config.
     /// Don't ever deinit returned `Config`.
@@ -60,6 +97,15 @@ extern "C" {
     BinaryId GetBinaryId();
     void     SetBinaryId (BinaryId binary_id);
 
+    ///
+    /// Get maximum number of requests that multi-function operations may have in flight at
+    /// once, as set by `max_parallel_requests` in config.
+    ///
+    /// SUCCESS : Value in range [1, 64].
+    /// FAILURE : 1 if plugin is not loaded.
+    ///
+    u32 GetMaxParallelRequests();
+
     ///
     /// Get binary ID with RzCore fallback for cross-context access.
     ///
@@ -71,15 +117,126 @@ extern "C" {
     BinaryId GetBinaryIdFromCore (RzCore* core);
     void     SetBinaryIdInCore (RzCore* core, BinaryId binary_id);
 
+    ///
+    /// Build function ID index for given binary ID. Index is built on first lookup after binary ID
+    /// is set, and reused for every lookup after that, until binary ID changes or a refresh is forced.
+    /// Makes a network request when index isn't built yet, so don't call this from GUI thread.
+    ///
+    /// binary_id[in]     : Binary ID to build index for.
+    /// force_refresh[in] : Refetch function list even if index is already built for this binary ID.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages, previous index is kept.
+    ///
+    bool LoadFunctionIndex (BinaryId binary_id, bool force_refresh);
+
+    ///
+    /// Get function ID from function ID index in O(1).
+    /// Index is built on first use if not already built for given binary ID.
+    ///
+    /// binary_id[in] : Binary ID function belongs to.
+    /// offset[in]    : Function address without binary base address (as stored by RevEngAI).
+    ///
+    /// SUCCESS : Non-zero function ID.
+    /// FAILURE : Zero.
+    ///
+    FunctionId GetFunctionIdForOffset (BinaryId binary_id, u64 offset);
+
 
     ///
-    /// Get all available AI models.
+    /// Suppress pushing function renames to RevEngAI from the function rename hook.
+    /// Wrap renames that the plugin applies itself (names fetched from RevEngAI, or names
+    /// already sent with `RenameFunction`) between begin and end calls. Calls can be nested.
+    ///
+    void BeginRenameSyncSuppression();
+    void EndRenameSyncSuppression();
+    bool IsRenameSyncSuppressed();
+
+    ///
+    /// Send all given function renames to RevEngAI at once.
+    /// RevEngAI only has a single function rename endpoint, so renames are sent over at most
+    /// `GetMaxParallelRequests()` parallel connections. Result of each rename is stored in it's `synced` field.
+    /// This does not rename anything in Rizin.
+    ///
+    /// renames[in,out] : Renames to send.
+    ///
+    /// SUCCESS : Number of renames that were synced.
+    /// FAILURE : Less than `renames->length`, failed renames have `synced = false`.
+    ///
+    size BatchRenameFunctions (FunctionRenames* renames);
+
+    ///
+    /// Get all available AI models. Served from last known list (persisted on disk), which is
+    /// refreshed in background once it's a day old. Never waits for RevEngAI : when no list is
+    /// known yet, this returns an empty vector while it's being fetched (see `IsModelsRefreshPending`).
+    /// If that fetch fails, next one is started only a minute later, however often this is called.
+    /// Must be called from main thread.
     ///
     /// SUCCESS : Vector of ModelInfo objects filled with valid data.
     /// FAILURE : Empty vector otherwise.
     ///
     ModelInfos* GetModels();
 
+    ///
+    /// Same as `GetModels`, but when no list is known yet, waits for the fetch to complete.
+    /// Meant for commands, GUI code must use `GetModels` instead. Must be called from main thread.
+    ///
+    /// SUCCESS : Vector of ModelInfo objects filled with valid data.
+    /// FAILURE : Empty vector with error message displayed.
+    ///
+    ModelInfos* WaitForModels();
+
+    ///
+    /// Check whether AI models list is being fetched in background.
+    /// GUI shows a loading state and calls `GetModels` again later while this is `true`.
+    /// Must be called from main thread, same as `GetModels` and `WaitForModels`. Refresh thread
+    /// is started and joined only by those two on main thread, so this takes no lock.
+    ///
+    bool IsModelsRefreshPending();
+
+    ///
+    /// Get analysis status for given binary ID, served from cache when possible.
+    /// Terminal states (COMPLETE, ERROR) are cached permanently, others for a few seconds.
+    ///
+    /// binary_id[in]     : Binary ID to get analysis status for.
+    /// force_refresh[in] : Ignore cached value and fetch status from RevEngAI.
+    ///
+    /// SUCCESS : Analysis status.
+    /// FAILURE : Zero, failures are not cached.
+    ///
+    Status GetAnalysisStatusCached (BinaryId binary_id, bool force_refresh);
+
+    ///
+    /// Get basic function information of a binary, served from on-disk cache when possible.
+    /// Fetched lists are always written back to cache.
+    ///
+    /// binary_id[in]     : Binary ID to get function list for.
+    /// force_refresh[in] : Ignore cached list and fetch it from RevEngAI.
+    ///
+    /// SUCCESS : Non-empty vector of function information.
+    /// FAILURE : Empty vector.
+    ///
+    FunctionInfos GetFunctionInfosCached (BinaryId binary_id, bool force_refresh);
+
+    ///
+    /// Drop cached function list of a binary, so next `GetFunctionInfosCached` fetches it again.
+    /// Call after functions of that binary were renamed on RevEngAI.
+    ///
+    /// binary_id[in] : Binary ID whose function list is out of date.
+    ///
+    void InvalidateFunctionInfosCache (BinaryId binary_id);
+
+    ///
+    /// Search for similar functions, served from on-disk cache when the same search was
+    /// made recently.
+    ///
+    /// search[in] : Search request, all it's parameters are part of cache key.
+    ///
+    /// SUCCESS : Vector of similar functions.
+    /// FAILURE : Empty vector.
+    ///
+    SimilarFunctions GetSimilarFunctionsCached (SimilarFunctionsRequest* search);
+
     ///
     /// Check whether or not we can work with analysis associated with given binary ID.
     ///
@@ -126,6 +283,19 @@ extern "C" {
     /// FAILURE : Zero.
     ///
     FunctionId rzLookupFunctionId (RzCore* core, RzAnalysisFunction* fn);
+
+    ///
+    /// Search for function ID of rizin function with given name.
+    /// Name is resolved through Rizin's own name table, and resulting address through function
+    /// ID index, so both steps are O(1). Names aren't looked up in names returned by RevEngAI
+    /// servers, because those go stale after a local rename, and could map to another function.
+    ///
+    /// core[in] : Rizin core.
+    /// name[in] : Current name of function in Rizin.
+    ///
+    /// SUCCESS : Non-zero function ID.
+    /// FAILURE : Zero.
+    ///
     FunctionId rzLookupFunctionIdForFunctionWithName (RzCore* core, const char* name);
     FunctionId rzLookupFunctionIdForFunctionAtAddr (RzCore* core, u64 addr);
 
@@ -158,6 +328,36 @@ extern "C" {
     ///
     AnnSymbol* rzGetMostSimilarFunctionSymbol (AnnSymbols* symbols, FunctionId origin_fn_id);
 
+    ///
+    /// Build index over given symbols in two linear passes.
+    ///
+    /// index[out]  : Index to be initialized.
+    /// symbols[in] : Symbols to index. Must outlive the index.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages, `index` is left empty (all lookups fail).
+    ///
+    bool AnnSymbolIndexInit (AnnSymbolIndex* index, AnnSymbols* symbols);
+    void AnnSymbolIndexDeinit (AnnSymbolIndex* index);
+
+    ///
+    /// Get most similar symbol for given origin function ID.
+    ///
+    /// SUCCESS : Pointer into indexed `AnnSymbols` vector.
+    /// FAILURE : `NULL` if there's no match for given function.
+    ///
+    AnnSymbol* AnnSymbolIndexGetBest (AnnSymbolIndex* index, FunctionId origin_fn_id);
+
+    ///
+    /// Get up to `k` most similar symbols for given origin function ID, most similar first.
+    ///
+    /// matches[out] : Array of at least `k` pointers, filled with pointers into indexed vector.
+    ///
+    /// SUCCESS : Number of matches stored in `matches`.
+    /// FAILURE : Zero.
+    ///
+    size AnnSymbolIndexGetTopK (AnnSymbolIndex* index, FunctionId origin_fn_id, AnnSymbol** matches, size k);
+
     void rzDisplayMsg (LogLevel level, Str* msg);
     void rzAppendMsg (LogLevel level, Str* msg);
     void rzClearMsg();
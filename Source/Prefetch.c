@@ -0,0 +1,397 @@
+/**
+ * @file : Prefetch.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_analysis.h>
+#include <rz_core.h>
+#include <rz_th.h>
+#include <rz_types.h>
+#include <rz_util/rz_annotated_code.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Cache.h>
+#include <DecompilationRender.h>
+#include <JobWaiter.h>
+#include <Plugin.h>
+#include <Prefetch.h>
+#include <TaskGroup.h>
+#include <Util.h>
+
+// Prefetched decompilations are only a guess, don't keep a slot busy with a stuck one
+#define PREFETCH_DEADLINE_MS (5ULL * 60 * 1000)
+
+// Upper limit on callee offsets remembered for one binary, including already prefetched ones
+#define PREFETCH_MAX_TRACKED 4096
+
+typedef struct PrefetchJob {
+    BinaryId binary_id;
+    u64      offset; ///< Function address without binary base address.
+} PrefetchJob;
+
+typedef struct CalleeRank {
+    u64 addr;
+    u64 refs; ///< Number of references to callee from anywhere in binary.
+} CalleeRank;
+
+static struct {
+    RzThreadLock *lock;
+    RzThreadCond *wake;
+    RzThread     *worker;
+    bool          enabled;
+    bool          stop;
+    u32           budget;
+    u32           max_parallel;
+    u32           started;   // decompilations started for `binary_id`
+    BinaryId      binary_id; // binary that queued offsets belong to
+    u64          *offsets;   // every offset ever queued for `binary_id`, [next, count) are pending
+    u32           count;
+    u32           capacity;
+    u32           next;
+} prefetch;
+
+void PrefetchInit() {
+    if (prefetch.lock) {
+        return;
+    }
+
+    RzThreadCond **conds[] = {&prefetch.wake};
+    if (!ThreadSyncNew (&prefetch.lock, conds, 1)) {
+        LOG_ERROR ("Failed to create prefetcher synchronization primitives, prefetching is disabled");
+    }
+}
+
+void PrefetchConfigure (bool enabled, u32 budget, u32 max_parallel) {
+    if (!prefetch.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (prefetch.lock);
+    prefetch.enabled      = enabled;
+    prefetch.budget       = budget;
+    prefetch.max_parallel = max_parallel ? max_parallel : 1;
+    rz_th_cond_signal_all (prefetch.wake);
+    rz_th_lock_leave (prefetch.lock);
+}
+
+static bool prefetchCancelled (void *user) {
+    (void)user;
+
+    rz_th_lock_enter (prefetch.lock);
+    bool cancelled = prefetch.stop || !prefetch.enabled;
+    rz_th_lock_leave (prefetch.lock);
+
+    return cancelled;
+}
+
+// Count a prefetched decompilation against budget of it's binary
+static bool prefetchTakeBudget (BinaryId binary_id) {
+    rz_th_lock_enter (prefetch.lock);
+    bool ok = prefetch.binary_id == binary_id && prefetch.started < prefetch.budget;
+    if (ok) {
+        prefetch.started++;
+    }
+    rz_th_lock_leave (prefetch.lock);
+
+    return ok;
+}
+
+static void *prefetchTask (void *user) {
+    PrefetchJob *job = user;
+
+    FunctionId fn_id = GetFunctionIdForOffset (job->binary_id, job->offset);
+    if (!fn_id) {
+        // Imports and functions RevEngAI did not analyse have nothing to decompile
+        return NULL;
+    }
+
+    RzAnnotatedCode *cached = CacheGetAnnotatedCode (fn_id);
+    if (cached) {
+        rz_annotated_code_free (cached);
+        return NULL;
+    }
+
+    if (!prefetchTakeBudget (job->binary_id)) {
+        return NULL;
+    }
+
+    JobWaiter waiter    = JobWaiterInit (PREFETCH_DEADLINE_MS);
+    waiter.is_cancelled = prefetchCancelled;
+    if (WaitForAiDecompilation (&waiter, fn_id) != JOB_WAIT_SUCCESS) {
+        return NULL;
+    }
+
+    AiDecompilation  aidec = GetAiDecompilation (GetConnection(), fn_id, true);
+    RzAnnotatedCode *code  = AnnotatedCodeFromAiDecompilation (&aidec);
+    if (code) {
+        CachePutAnnotatedCode (fn_id, code);
+        rz_annotated_code_free (code);
+        LOG_INFO ("Prefetched AI decompilation of function ID %llu", fn_id);
+    }
+    if (aidec.decompilation.length) {
+        CachePutStr (CACHE_KIND_DECOMPILATION, fn_id, NULL, &aidec.decompilation);
+    }
+    AiDecompilationDeinit (&aidec);
+
+    return NULL;
+}
+
+static void *prefetchWorker (void *user) {
+    (void)user;
+
+    rz_th_lock_enter (prefetch.lock);
+    while (!prefetch.stop) {
+        if (prefetch.next == prefetch.count || !prefetch.enabled) {
+            rz_th_cond_wait (prefetch.wake, prefetch.lock);
+            continue;
+        }
+
+        u32          batch = MIN2 (prefetch.count - prefetch.next, prefetch.max_parallel);
+        PrefetchJob *jobs  = calloc (batch, sizeof (PrefetchJob));
+        if (!jobs) {
+            LOG_ERROR ("Failed to allocate memory for prefetch jobs, dropping queued callees");
+            prefetch.next = prefetch.count;
+            continue;
+        }
+
+        for (u32 i = 0; i < batch; i++) {
+            jobs[i] = (PrefetchJob) {.binary_id = prefetch.binary_id, .offset = prefetch.offsets[prefetch.next++]};
+        }
+        rz_th_lock_leave (prefetch.lock);
+
+        TaskGroup *group = TaskGroupNew (batch);
+        if (group) {
+            for (u32 i = 0; i < batch; i++) {
+                TaskGroupSubmit (group, prefetchTask, &jobs[i]);
+            }
+
+            u64   task   = 0;
+            void *result = NULL;
+            while (TaskGroupWaitNext (group, &task, &result)) {}
+            TaskGroupFree (group, NULL);
+        } else {
+            for (u32 i = 0; i < batch; i++) {
+                prefetchTask (&jobs[i]);
+            }
+        }
+        free (jobs);
+
+        rz_th_lock_enter (prefetch.lock);
+    }
+    rz_th_lock_leave (prefetch.lock);
+
+    return NULL;
+}
+
+static int compareCalleeRank (const void *a, const void *b) {
+    const CalleeRank *x = a;
+    const CalleeRank *y = b;
+
+    // Most referenced first, ties in address order
+    if (x->refs != y->refs) {
+        return x->refs > y->refs ? -1 : 1;
+    }
+    return x->addr < y->addr ? -1 : x->addr > y->addr;
+}
+
+// Get unique direct callees of a function, most referenced first
+static CalleeRank *rankCallees (RzCore *core, RzAnalysisFunction *fn, u32 *count) {
+    CalleeRank *callees  = NULL;
+    u32         capacity = 0;
+    *count               = 0;
+
+    RzList *xrefs = rz_analysis_function_get_xrefs_from (fn);
+    if (!xrefs) {
+        return NULL;
+    }
+
+    RzListIter     *it;
+    RzAnalysisXRef *xref;
+    rz_list_foreach (xrefs, it, xref) {
+        if (xref->type != RZ_ANALYSIS_XREF_TYPE_CALL) {
+            continue;
+        }
+
+        RzAnalysisFunction *callee = rz_analysis_get_function_at (core->analysis, xref->to);
+        if (!callee || callee == fn) {
+            continue;
+        }
+
+        bool is_known = false;
+        for (u32 i = 0; i < *count && !is_known; i++) {
+            is_known = callees[i].addr == callee->addr;
+        }
+        if (is_known) {
+            continue;
+        }
+
+        if (*count == capacity) {
+            u32         new_capacity = capacity ? capacity * 2 : 16;
+            CalleeRank *grown        = realloc (callees, new_capacity * sizeof (CalleeRank));
+            if (!grown) {
+                LOG_ERROR ("Failed to allocate memory for callee list");
+                break;
+            }
+            callees  = grown;
+            capacity = new_capacity;
+        }
+        callees[(*count)++] = (CalleeRank) {.addr = callee->addr};
+    }
+    rz_list_free (xrefs);
+
+    for (u32 i = 0; i < *count; i++) {
+        RzList *refs    = rz_analysis_xrefs_get_to (core->analysis, callees[i].addr);
+        callees[i].refs = refs ? rz_list_length (refs) : 0;
+        rz_list_free (refs);
+    }
+
+    if (*count) {
+        qsort (callees, *count, sizeof (CalleeRank), compareCalleeRank);
+    }
+    return callees;
+}
+
+static bool prefetchIsTracked (u64 offset) {
+    for (u32 i = 0; i < prefetch.count; i++) {
+        if (prefetch.offsets[i] == offset) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool prefetchTrack (u64 offset) {
+    if (prefetch.count == prefetch.capacity) {
+        if (prefetch.capacity >= PREFETCH_MAX_TRACKED) {
+            return false;
+        }
+
+        u32  capacity = prefetch.capacity ? prefetch.capacity * 2 : 64;
+        u64 *offsets  = realloc (prefetch.offsets, capacity * sizeof (u64));
+        if (!offsets) {
+            LOG_ERROR ("Failed to allocate memory for prefetch queue");
+            return false;
+        }
+        prefetch.offsets  = offsets;
+        prefetch.capacity = capacity;
+    }
+
+    prefetch.offsets[prefetch.count++] = offset;
+    return true;
+}
+
+u32 PrefetchCallees (RzCore *core, u64 fn_addr) {
+    if (!core) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!prefetch.lock) {
+        return 0;
+    }
+
+    rz_th_lock_enter (prefetch.lock);
+    bool enabled = prefetch.enabled && prefetch.budget;
+    rz_th_lock_leave (prefetch.lock);
+    if (!enabled) {
+        return 0;
+    }
+
+    BinaryId            binary_id = GetBinaryIdFromCore (core);
+    RzAnalysisFunction *fn        = rz_analysis_get_function_at (core->analysis, fn_addr);
+    if (!binary_id || !fn) {
+        return 0;
+    }
+
+    u32         count     = 0;
+    CalleeRank *callees   = rankCallees (core, fn, &count);
+    u64         base_addr = rzGetCurrentBinaryBaseAddr (core);
+    u32         queued    = 0;
+
+    rz_th_lock_enter (prefetch.lock);
+
+    if (prefetch.binary_id != binary_id) {
+        // Budget and queue belong to one binary, start over for a new one
+        prefetch.binary_id = binary_id;
+        prefetch.started   = 0;
+        prefetch.count     = 0;
+        prefetch.next      = 0;
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        // Don't queue more than what's left of budget
+        if (prefetch.started + (prefetch.count - prefetch.next) >= prefetch.budget) {
+            break;
+        }
+
+        u64 offset = callees[i].addr - base_addr;
+        if (prefetchIsTracked (offset)) {
+            continue;
+        }
+        if (!prefetchTrack (offset)) {
+            break;
+        }
+        queued++;
+    }
+
+    if (queued && !prefetch.worker && !prefetch.stop) {
+        prefetch.worker = rz_th_new (prefetchWorker, NULL);
+        if (!prefetch.worker) {
+            LOG_ERROR ("Failed to create prefetch worker thread");
+            prefetch.next = prefetch.count;
+            queued        = 0;
+        }
+    }
+    if (queued) {
+        rz_th_cond_signal (prefetch.wake);
+    }
+
+    rz_th_lock_leave (prefetch.lock);
+
+    free (callees);
+
+    if (queued) {
+        LOG_INFO ("Queued %u of %u callees of function at 0x%llx for prefetching", queued, count, fn_addr);
+    }
+    return queued;
+}
+
+void PrefetchShutdown() {
+    if (!prefetch.lock) {
+        return;
+    }
+
+    rz_th_lock_enter (prefetch.lock);
+    prefetch.stop   = true;
+    RzThread *th    = prefetch.worker;
+    prefetch.worker = NULL;
+    rz_th_cond_signal_all (prefetch.wake);
+    rz_th_lock_leave (prefetch.lock);
+
+    // Running prefetches notice `stop` while waiting, and finish soon
+    if (th) {
+        rz_th_wait (th);
+        rz_th_free (th);
+    }
+
+    rz_th_lock_enter (prefetch.lock);
+    free (prefetch.offsets);
+    prefetch.offsets   = NULL;
+    prefetch.count     = 0;
+    prefetch.capacity  = 0;
+    prefetch.next      = 0;
+    prefetch.started   = 0;
+    prefetch.binary_id = 0;
+    prefetch.stop      = false;
+    rz_th_lock_leave (prefetch.lock);
+}
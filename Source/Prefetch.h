@@ -0,0 +1,65 @@
+/**
+ * @file : Prefetch.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Background AI decompilation of functions user is likely to visit next.
+ * After a function is decompiled, it's direct callees are queued, most referenced first,
+ * and a background worker starts their AI decompilation and stores completed results in
+ * the response cache. Following a call from decompiler view then needs no waiting.
+ *
+ * Disabled unless `prefetch_callees` is set in config. Number of decompilations started
+ * for a binary is limited by `prefetch_budget`.
+ * */
+
+#ifndef REAI_PLUGIN_PREFETCH
+#define REAI_PLUGIN_PREFETCH
+
+/* rizin */
+#include <rz_core.h>
+
+/* revenai */
+#include <Reai/Api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Create prefetcher state. Must be called on main thread before any other prefetch function.
+    ///
+    void PrefetchInit();
+
+    ///
+    /// Apply prefetch settings from config.
+    ///
+    /// enabled[in]      : Queue callees of decompiled functions or not.
+    /// budget[in]       : Maximum number of decompilations prefetched for one binary.
+    /// max_parallel[in] : Maximum number of decompilations prefetched at once.
+    ///
+    void PrefetchConfigure (bool enabled, u32 budget, u32 max_parallel);
+
+    ///
+    /// Queue direct callees of a function for prefetching, ranked by their number of
+    /// references. Only reads Rizin state, all requests are made by the background worker.
+    /// Does nothing if prefetching is disabled or budget for binary is used up.
+    ///
+    /// core[in]    : RzCore. Caller must have exclusive access to it.
+    /// fn_addr[in] : Address of function that was just decompiled.
+    ///
+    /// SUCCESS : Number of callees queued.
+    /// FAILURE : Zero.
+    ///
+    u32 PrefetchCallees (RzCore* core, u64 fn_addr);
+
+    ///
+    /// Drop queued callees, cancel waits of running prefetches and stop background worker.
+    ///
+    void PrefetchShutdown();
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_PREFETCH
@@ -0,0 +1,389 @@
+/**
+ * @file : ArchiveExport.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_cons.h>
+#include <rz_util/rz_annotated_code.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Archive.h>
+#include <Cache.h>
+#include <DecompilationRender.h>
+#include <Plugin.h>
+#include <Rizin/ArchiveExport.h>
+#include <TaskGroup.h>
+
+typedef struct ExportJob {
+    FunctionId      fn_id;
+    ArchiveDisasmFn get_disasm;
+
+    // Filled by `exportFetchTask`, written to archive and freed by `exportWriteJob`
+    RzAnnotatedCode *code;
+    Str              decompilation;
+    Str              disasm;
+    bool             fetched;
+    bool             failed; ///< Something RevEngAI has could not be fetched.
+} ExportJob;
+
+typedef struct ExportIds {
+    u64 *ids;
+    u64  count;
+    u64  capacity;
+} ExportIds;
+
+typedef struct ExportWalk {
+    ArchiveWriter        *writer;
+    BinaryId              binary_id;
+    ExportIds             own;         ///< Function IDs of current binary, sorted.
+    bool                 *own_written; ///< Decompilation and disassembly of `own.ids[i]` are in archive.
+    ExportIds             targets;     ///< Function IDs found in exported searches.
+    bool                 *target_found;
+    bool                  is_targets_pass;
+    ArchiveExportSummary *summary;
+} ExportWalk;
+
+static int compareU64 (const void *a, const void *b) {
+    u64 x = *(const u64 *)a;
+    u64 y = *(const u64 *)b;
+    return x < y ? -1 : x > y;
+}
+
+static bool exportIdsPush (ExportIds *set, u64 id) {
+    if (set->count == set->capacity) {
+        u64  capacity = set->capacity ? set->capacity * 2 : 256;
+        u64 *ids      = realloc (set->ids, capacity * sizeof (u64));
+        if (!ids) {
+            LOG_ERROR ("Failed to allocate memory for function IDs");
+            return false;
+        }
+        set->ids      = ids;
+        set->capacity = capacity;
+    }
+    set->ids[set->count++] = id;
+    return true;
+}
+
+// Sort and drop duplicates, so set can be binary searched
+static void exportIdsSort (ExportIds *set) {
+    if (!set->count) {
+        return;
+    }
+
+    qsort (set->ids, set->count, sizeof (u64), compareU64);
+    u64 n = 1;
+    for (u64 i = 1; i < set->count; i++) {
+        if (set->ids[i] != set->ids[n - 1]) {
+            set->ids[n++] = set->ids[i];
+        }
+    }
+    set->count = n;
+}
+
+static u64 *exportIdsFind (const ExportIds *set, u64 id) {
+    return set->count ? bsearch (&id, set->ids, set->count, sizeof (u64), compareU64) : NULL;
+}
+
+// Get completed decompilation and disassembly of a function, from cache or from RevEngAI.
+// Decompilations are never started, export takes only what RevEngAI already has.
+static void *exportFetchTask (void *user) {
+    ExportJob *job = user;
+
+    job->code              = CacheGetAnnotatedCode (job->fn_id);
+    job->decompilation     = StrInit();
+    bool has_decompilation = CacheGetStr (CACHE_KIND_DECOMPILATION, job->fn_id, NULL, &job->decompilation);
+    if (!job->code || !has_decompilation) {
+        Status status = GetAiDecompilationStatus (GetConnection(), job->fn_id);
+        switch (status & STATUS_MASK) {
+            case STATUS_SUCCESS :
+            case STATUS_COMPLETE : {
+                AiDecompilation aidec = GetAiDecompilation (GetConnection(), job->fn_id, true);
+                if (!job->code && (job->code = AnnotatedCodeFromAiDecompilation (&aidec))) {
+                    CachePutAnnotatedCode (job->fn_id, job->code);
+                }
+                if (!has_decompilation && aidec.decompilation.length) {
+                    StrDeinit (&job->decompilation);
+                    job->decompilation = StrInitFromStr (&aidec.decompilation);
+                    CachePutStr (CACHE_KIND_DECOMPILATION, job->fn_id, NULL, &job->decompilation);
+                }
+                job->failed = !job->code;
+                AiDecompilationDeinit (&aidec);
+                break;
+            }
+            default :
+                // Status request failed, there may be a decompilation we don't know of
+                job->failed = !(status & STATUS_MASK);
+                break;
+        }
+    }
+
+    job->disasm   = job->get_disasm (job->fn_id);
+    job->failed  |= !job->disasm.length;
+    job->fetched  = true;
+
+    return job;
+}
+
+static void exportJobDeinit (ExportJob *job) {
+    if (!job->fetched) {
+        return;
+    }
+
+    if (job->code) {
+        rz_annotated_code_free (job->code);
+    }
+    StrDeinit (&job->decompilation);
+    StrDeinit (&job->disasm);
+    job->code    = NULL;
+    job->fetched = false;
+}
+
+static bool exportAddStr (ExportWalk *w, CacheKind kind, u64 id, const Str *str) {
+    CacheBuffer buf = {0};
+    CacheBufferWriteStr (&buf, str);
+    bool ok = ArchiveWriterAdd (w->writer, kind, id, NULL, &buf);
+    CacheBufferDeinit (&buf);
+    return ok;
+}
+
+// Write what was fetched for a function straight into archive, so nothing depends on it staying
+// in cache until export is done.
+static bool exportWriteJob (ExportWalk *w, ExportJob *job) {
+    bool ok = true;
+
+    if (job->code) {
+        CacheBuffer buf = {0};
+        CacheBufferWriteAnnotatedCode (&buf, job->code);
+        ok = ArchiveWriterAdd (w->writer, CACHE_KIND_ANNOTATED_DECOMPILATION, job->fn_id, NULL, &buf);
+        CacheBufferDeinit (&buf);
+        w->summary->decompilations += ok ? 1 : 0;
+    }
+    if (ok && job->decompilation.length) {
+        ok = exportAddStr (w, CACHE_KIND_DECOMPILATION, job->fn_id, &job->decompilation);
+    }
+    if (ok && job->disasm.length) {
+        ok                         = exportAddStr (w, CACHE_KIND_LINEAR_DISASM, job->fn_id, &job->disasm);
+        w->summary->disassemblies += ok ? 1 : 0;
+    }
+
+    if (job->failed) {
+        LOG_ERROR ("Data of function ID %llu could not be fetched completely, it's partly left out", job->fn_id);
+        w->summary->left_out++;
+    }
+
+    u64 *own = exportIdsFind (&w->own, job->fn_id);
+    if (own) {
+        w->own_written[own - w->own.ids] = true;
+    }
+
+    exportJobDeinit (job);
+    return ok;
+}
+
+// Fetch and write data of every function, in order of completion. Fails only if archive can't
+// be written, user interrupting it is reported in summary.
+static bool exportFunctions (ExportWalk *w, ExportJob *jobs, u32 count) {
+    TaskGroup *group = TaskGroupNew (GetMaxParallelRequests());
+    u32        done  = 0;
+    bool       ok    = true;
+    if (!group) {
+        for (u32 i = 0; i < count && ok && !rz_cons_is_breaked(); i++) {
+            ok = exportWriteJob (w, exportFetchTask (&jobs[i]));
+            rz_cons_printf ("\rExported %u/%u functions", ++done, count);
+            rz_cons_flush();
+        }
+    } else {
+        for (u32 i = 0; i < count; i++) {
+            TaskGroupSubmit (group, exportFetchTask, &jobs[i]);
+        }
+
+        u64   task   = 0;
+        void *result = NULL;
+        while (ok && !rz_cons_is_breaked() && TaskGroupWaitNext (group, &task, &result)) {
+            ok = exportWriteJob (w, result);
+            rz_cons_printf ("\rExported %u/%u functions", ++done, count);
+            rz_cons_flush();
+        }
+        TaskGroupFree (group, NULL);
+    }
+
+    rz_cons_newline();
+    rz_cons_flush();
+
+    // Fetched after interrupt, or never written
+    for (u32 i = 0; i < count; i++) {
+        exportJobDeinit (&jobs[i]);
+    }
+
+    w->summary->left_out  += count - done;
+    w->summary->cancelled  = ok && done < count;
+    return ok;
+}
+
+// Search results are kept in cache entry layout, see `CachePutSimilarFunctions`
+static bool exportCollectTargets (ExportWalk *w, const CacheBuffer *data) {
+    CacheBuffer buf   = *data;
+    u64         count = CacheBufferReadU64 (&buf);
+    for (u64 i = 0; i < count && !buf.failed; i++) {
+        u64 fn_id = CacheBufferReadU64 (&buf);
+        CacheBufferReadU64 (&buf); // binary ID
+        CacheBufferReadF64 (&buf); // distance
+        Str name        = CacheBufferReadStr (&buf);
+        Str binary_name = CacheBufferReadStr (&buf);
+        StrDeinit (&name);
+        StrDeinit (&binary_name);
+
+        if (!buf.failed && !exportIdsFind (&w->own, fn_id) && !exportIdsPush (&w->targets, fn_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool exportEntry (void *user, CacheKind kind, u64 id, const char *params, CacheBuffer *data) {
+    ExportWalk *w = user;
+
+    bool is_content = kind == CACHE_KIND_DECOMPILATION || kind == CACHE_KIND_ANNOTATED_DECOMPILATION ||
+                      kind == CACHE_KIND_LINEAR_DISASM;
+
+    // Second pass picks up decompilation and disassembly of search results
+    if (w->is_targets_pass) {
+        u64 *target = is_content ? exportIdsFind (&w->targets, id) : NULL;
+        if (!target) {
+            return true;
+        }
+        w->target_found[target - w->targets.ids] = true;
+        return ArchiveWriterAdd (w->writer, kind, id, params, data);
+    }
+
+    // Function list is written from fetched list
+    u64 *own = kind == CACHE_KIND_FUNCTION_INFOS ? NULL : exportIdsFind (&w->own, id);
+    if (!own) {
+        return true;
+    }
+
+    if (kind == CACHE_KIND_SIMILAR_FUNCTIONS) {
+        w->summary->searches++;
+        return exportCollectTargets (w, data) && ArchiveWriterAdd (w->writer, kind, id, params, data);
+    }
+
+    if (!is_content) {
+        return true;
+    }
+
+    // Written already by `exportWriteJob`. Functions it didn't get to keep what cache has.
+    bool is_fetched_kind = kind != CACHE_KIND_LINEAR_DISASM || !params;
+    if (is_fetched_kind && w->own_written[own - w->own.ids]) {
+        return true;
+    }
+
+    if (kind == CACHE_KIND_ANNOTATED_DECOMPILATION) {
+        w->summary->decompilations++;
+    } else if (kind == CACHE_KIND_LINEAR_DISASM && !params) {
+        w->summary->disassemblies++;
+    }
+    return ArchiveWriterAdd (w->writer, kind, id, params, data);
+}
+
+bool rzExportArchive (const char *path, ArchiveDisasmFn get_disasm, ArchiveExportSummary *summary) {
+    if (!path || !get_disasm || !summary) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    memset (summary, 0, sizeof (ArchiveExportSummary));
+
+    BinaryId      binary_id = GetBinaryId();
+    FunctionInfos functions = GetFunctionInfosCached (binary_id, false);
+    if (!functions.length) {
+        DISPLAY_ERROR ("Failed to get function info list for opened binary file from RevEng.AI servers.");
+        VecDeinit (&functions);
+        return false;
+    }
+
+    ExportWalk walk = {.binary_id = binary_id, .summary = summary};
+    bool       ok   = true;
+    VecForeachPtr (&functions, fi, {
+        if (ok && fi->id) {
+            ok = exportIdsPush (&walk.own, fi->id);
+        }
+    });
+    exportIdsSort (&walk.own);
+
+    // One job for each function ID, archive can't have an entry twice
+    ExportJob *jobs  = ok ? calloc (walk.own.count ? walk.own.count : 1, sizeof (ExportJob)) : NULL;
+    walk.own_written = ok ? calloc (walk.own.count ? walk.own.count : 1, sizeof (bool)) : NULL;
+    if (!jobs || !walk.own_written) {
+        LOG_ERROR ("Failed to allocate memory for export");
+        VecDeinit (&functions);
+        free (jobs);
+        free (walk.own_written);
+        free (walk.own.ids);
+        return false;
+    }
+    for (u64 i = 0; i < walk.own.count; i++) {
+        jobs[i] = (ExportJob) {.fn_id = walk.own.ids[i], .get_disasm = get_disasm};
+    }
+    summary->functions = (u32)walk.own.count;
+
+    walk.writer = ArchiveWriterOpen (path, binary_id);
+    if (!walk.writer) {
+        DISPLAY_ERROR ("Failed to create archive '%s'", path);
+        VecDeinit (&functions);
+        free (jobs);
+        free (walk.own_written);
+        free (walk.own.ids);
+        return false;
+    }
+
+    // Function list is required to find function IDs offline
+    CacheBuffer function_infos = {0};
+    CacheBufferWriteFunctionInfos (&function_infos, &functions);
+    ok = ArchiveWriterAdd (walk.writer, CACHE_KIND_FUNCTION_INFOS, binary_id, NULL, &function_infos);
+    CacheBufferDeinit (&function_infos);
+    VecDeinit (&functions);
+
+    if (ok) {
+        rz_cons_break_push (NULL, NULL);
+        ok = exportFunctions (&walk, jobs, (u32)walk.own.count);
+        rz_cons_break_pop();
+    }
+    free (jobs);
+
+    // Searches, and whatever cache still has of functions that were not reached
+    if (ok) {
+        CacheForEach (exportEntry, &walk);
+
+        exportIdsSort (&walk.targets);
+        walk.target_found = walk.targets.count ? calloc (walk.targets.count, sizeof (bool)) : NULL;
+        if (walk.target_found) {
+            walk.is_targets_pass = true;
+            CacheForEach (exportEntry, &walk);
+            for (u64 i = 0; i < walk.targets.count; i++) {
+                summary->targets += walk.target_found[i] ? 1 : 0;
+            }
+        }
+    }
+
+    summary->entries = ArchiveWriterCount (walk.writer);
+    if (!ArchiveWriterClose (walk.writer, ok)) {
+        DISPLAY_ERROR ("Failed to write archive '%s'", path);
+        ok = false;
+    }
+
+    free (walk.target_found);
+    free (walk.targets.ids);
+    free (walk.own_written);
+    free (walk.own.ids);
+    return ok;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file : ArchiveExport.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Export of everything known about current binary into an offline archive.
+ * AI decompilation and disassembly of every function are taken from response cache, or fetched
+ * from RevEngAI, and written straight into archive, so cache size never limits what is exported.
+ * Similar function searches made earlier, and decompilation and disassembly of their results,
+ * are then copied from cache, so that diff viewers work offline for functions already looked at.
+ * */
+
+#ifndef REAI_RIZIN_ARCHIVE_EXPORT
+#define REAI_RIZIN_ARCHIVE_EXPORT
+
+/* revenai */
+#include <Reai/Api.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Get linear disassembly of a function, from cache or from RevEngAI.
+    ///
+    typedef Str (*ArchiveDisasmFn) (FunctionId function_id);
+
+    typedef struct ArchiveExportSummary {
+        u32  functions;      ///< Functions in RevEngAI analysis of binary.
+        u32  decompilations; ///< Functions with AI decompilation in archive.
+        u32  disassemblies;  ///< Functions with disassembly in archive.
+        u32  searches;       ///< Similar function searches in archive.
+        u32  targets;        ///< Search results with decompilation or disassembly in archive.
+        u32  left_out;       ///< Functions whose data could not be fetched completely.
+        u64  entries;        ///< Total entries in archive.
+        bool cancelled;      ///< User interrupted fetching missing data.
+    } ArchiveExportSummary;
+
+    ///
+    /// Export AI decompilation, summary and disassembly of every function of current binary
+    /// into an archive at `path`, to be mounted with `ArchiveMount` on another machine.
+    /// Decompilations are never started here, only completed ones are exported.
+    ///
+    /// path[in]       : Archive to create, replaced if it exists.
+    /// get_disasm[in] : Fetches disassembly missing from cache.
+    /// summary[out]   : What was exported.
+    ///
+    /// SUCCESS : `true` once archive is written, even if user interrupted fetching or some
+    ///           functions were left out.
+    /// FAILURE : `false` with log messages.
+    ///
+    bool rzExportArchive (const char* path, ArchiveDisasmFn get_disasm, ArchiveExportSummary* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_RIZIN_ARCHIVE_EXPORT
@@ -0,0 +1,541 @@
+/**
+ * @file : BatchDecompile.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_analysis.h>
+#include <rz_cons.h>
+#include <rz_core.h>
+#include <rz_th.h>
+#include <rz_util/rz_annotated_code.h>
+#include <rz_util/rz_file.h>
+#include <rz_util/rz_path.h>
+#include <rz_util/rz_regex.h>
+#include <rz_util/rz_str.h>
+#include <rz_util/rz_sys.h>
+#include <rz_util/rz_time.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Cache.h>
+#include <DecompilationRender.h>
+#include <DecompilationTracker.h>
+#include <JobWaiter.h>
+#include <Plugin.h>
+#include <Rizin/BatchDecompile.h>
+#include <Rizin/Glob.h>
+#include <TaskGroup.h>
+
+// Progress is updated at least this often while waiting
+#define BATCH_PROGRESS_INTERVAL_MS 250
+
+#define BATCH_INDEX_FILE_NAME "index.tsv"
+
+typedef enum BatchJobState {
+    BATCH_JOB_PENDING = 0,
+    BATCH_JOB_DONE,
+    BATCH_JOB_FAILED,
+} BatchJobState;
+
+typedef struct BatchDecompile BatchDecompile;
+
+typedef struct BatchJob {
+    FunctionId       fn_id;
+    u64              addr;
+    char            *name;
+    BatchDecompile  *batch;
+    u64              watch_id;     // tracker watch, zero if not watched
+    Status           final_status; // set by tracker when decompilation finishes
+    BatchJobState    state;
+    bool             emitted;
+    bool             from_cache;
+    RzAnnotatedCode *code;
+} BatchJob;
+
+struct BatchDecompile {
+    BatchJob              *jobs;
+    u32                    count;
+    u32                    remaining; // jobs not emitted yet
+    const char            *output_dir;
+    BatchDecompileSummary *summary;
+
+    // Filled by tracker as decompilations finish, holds indices into `jobs`
+    RzThreadLock *lock;
+    u32          *finished;
+    u32           finished_count;
+    bool          stop_polling; // stops waits of `batchPoll`, guarded by `lock`
+};
+
+typedef enum SelectorKind {
+    SELECT_ALL = 0,
+    SELECT_REGEX,
+    SELECT_GLOB,
+    SELECT_LIST,
+} SelectorKind;
+
+typedef struct Selector {
+    SelectorKind kind;
+    const char  *pattern;
+    RzRegex     *regex;
+    RzList      *names;
+} Selector;
+
+static bool selectorInit (Selector *sel, const char *selector) {
+    memset (sel, 0, sizeof (Selector));
+    sel->pattern = selector;
+
+    size len = strlen (selector);
+    if (!strcmp (selector, "all")) {
+        sel->kind = SELECT_ALL;
+    } else if (len > 2 && selector[0] == '/' && selector[len - 1] == '/') {
+        char *pattern = rz_str_ndup (selector + 1, len - 2);
+        sel->kind     = SELECT_REGEX;
+        sel->regex    = pattern ? rz_regex_new (pattern, RZ_REGEX_DEFAULT, 0) : NULL;
+        free (pattern);
+        if (!sel->regex) {
+            DISPLAY_ERROR ("Invalid regular expression '%s'", selector);
+            return false;
+        }
+    } else if (strpbrk (selector, "*?")) {
+        sel->kind = SELECT_GLOB;
+    } else {
+        sel->kind  = SELECT_LIST;
+        sel->names = rz_str_split_duplist (selector, ",", true);
+        if (!sel->names) {
+            LOG_ERROR ("Failed to split list of function names");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void selectorDeinit (Selector *sel) {
+    rz_regex_free (sel->regex);
+    rz_list_free (sel->names);
+    memset (sel, 0, sizeof (Selector));
+}
+
+static bool selectorMatch (const Selector *sel, const char *name) {
+    switch (sel->kind) {
+        case SELECT_ALL :
+            return true;
+        case SELECT_REGEX : {
+            RzPVector *matches = rz_regex_match_first (sel->regex, name, RZ_REGEX_ZERO_TERMINATED, 0, RZ_REGEX_DEFAULT);
+            bool       is_hit  = matches && !rz_pvector_empty (matches);
+            rz_pvector_free (matches);
+            return is_hit;
+        }
+        case SELECT_GLOB :
+            return GlobMatch (sel->pattern, name);
+        case SELECT_LIST : {
+            RzListIter *it;
+            const char *listed;
+            rz_list_foreach (sel->names, it, listed) {
+                if (!strcmp (listed, name)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+    }
+    return false;
+}
+
+static bool batchAddJob (BatchDecompile *b, u32 *capacity, FunctionId fn_id, RzAnalysisFunction *fn) {
+    if (b->count == *capacity) {
+        u32       new_capacity = *capacity ? *capacity * 2 : 64;
+        BatchJob *jobs         = realloc (b->jobs, new_capacity * sizeof (BatchJob));
+        if (!jobs) {
+            LOG_ERROR ("Failed to allocate memory for batch decompilation");
+            return false;
+        }
+        b->jobs   = jobs;
+        *capacity = new_capacity;
+    }
+
+    b->jobs[b->count++] = (BatchJob) {
+        .fn_id = fn_id,
+        .addr  = fn->addr,
+        .name  = strdup (fn->name),
+    };
+    return true;
+}
+
+// Find selected functions and their function IDs. Only this part needs Rizin.
+static bool batchSelect (BatchDecompile *b, RzCore *core, const Selector *sel) {
+    BinaryId binary_id = GetBinaryIdFromCore (core);
+    if (!LoadFunctionIndex (binary_id, false)) {
+        DISPLAY_ERROR ("Failed to get function info list for opened binary file from RevEng.AI servers.");
+        return false;
+    }
+
+    u64 base_addr = rzGetCurrentBinaryBaseAddr (core);
+    u32 capacity  = 0;
+
+    RzListIter         *it;
+    RzAnalysisFunction *fn;
+    rz_list_foreach (core->analysis->fcns, it, fn) {
+        if (!fn->name || !selectorMatch (sel, fn->name)) {
+            continue;
+        }
+
+        FunctionId fn_id = GetFunctionIdForOffset (binary_id, fn->addr - base_addr);
+        if (!fn_id) {
+            LOG_INFO ("Skipping '%s', RevEngAI has no function ID for it", fn->name);
+            b->summary->unknown++;
+            continue;
+        }
+
+        if (!batchAddJob (b, &capacity, fn_id, fn)) {
+            return false;
+        }
+    }
+
+    if (sel->kind == SELECT_LIST) {
+        RzListIter *name_it;
+        const char *name;
+        rz_list_foreach (sel->names, name_it, name) {
+            if (!rz_analysis_get_function_byname (core->analysis, name)) {
+                DISPLAY_ERROR ("A function with name '%s' does not exist in Rizin.", name);
+            }
+        }
+    }
+
+    // Jobs don't move from here on, tracker callbacks point into them
+    for (u32 i = 0; i < b->count; i++) {
+        b->jobs[i].batch = b;
+    }
+
+    b->lock     = rz_th_lock_new (false);
+    b->finished = calloc (b->count ? b->count : 1, sizeof (u32));
+    if (!b->lock || !b->finished) {
+        LOG_ERROR ("Failed to allocate batch decompilation state");
+        return false;
+    }
+
+    b->summary->selected = b->count;
+    b->remaining         = b->count;
+    return true;
+}
+
+// Function names may contain characters that are not allowed in file names. Address keeps apart
+// names that only differ in those characters, like `operator<` and `operator>`.
+static char *batchFileName (const BatchJob *job) {
+    char *file = rz_str_newf ("%s_%llx.c", job->name, job->addr);
+    for (char *c = file; c && *c; c++) {
+        if (!isalnum ((unsigned char)*c) && *c != '_' && *c != '-' && *c != '.') {
+            *c = '_';
+        }
+    }
+    return file;
+}
+
+static void batchAppendIndex (BatchDecompile *b, const BatchJob *job, const char *file, const char *status) {
+    char *line       = rz_str_newf ("0x%llx\t%llu\t%s\t%s\t%s\n", job->addr, job->fn_id, job->name, file, status);
+    char *index_path = rz_str_newf ("%s" RZ_SYS_DIR BATCH_INDEX_FILE_NAME, b->output_dir);
+    if (!line || !index_path || !rz_file_dump (index_path, (const ut8 *)line, strlen (line), true)) {
+        LOG_ERROR ("Failed to append '%s' to decompilation index", job->name);
+    }
+    free (index_path);
+    free (line);
+}
+
+// Write out a finished job. Always called on main thread, in order of completion.
+static void batchEmit (BatchDecompile *b, BatchJob *job) {
+    job->emitted = true;
+    b->remaining--;
+
+    if (job->state != BATCH_JOB_DONE) {
+        b->summary->failed++;
+        if (b->output_dir) {
+            batchAppendIndex (b, job, "-", "failed");
+        }
+        return;
+    }
+
+    if (job->from_cache) {
+        b->summary->from_cache++;
+    } else {
+        b->summary->decompiled++;
+    }
+
+    if (b->output_dir) {
+        char *file = batchFileName (job);
+        char *path = file ? rz_str_newf ("%s" RZ_SYS_DIR "%s", b->output_dir, file) : NULL;
+        if (path && rz_file_dump (path, (const ut8 *)job->code->code, strlen (job->code->code), false)) {
+            batchAppendIndex (b, job, file, job->from_cache ? "cached" : "decompiled");
+        } else {
+            DISPLAY_ERROR ("Failed to write decompilation of '%s'", job->name);
+        }
+        free (path);
+        free (file);
+    }
+
+    // Output is written, don't keep code of whole binary in memory
+    rz_annotated_code_free (job->code);
+    job->code = NULL;
+}
+
+// Called by decompilation tracker with tracker locked, or by `batchPoll`
+static void batchJobFinished (void *user, FunctionId fn_id, Status status) {
+    (void)fn_id;
+    BatchJob       *job = user;
+    BatchDecompile *b   = job->batch;
+
+    rz_th_lock_enter (b->lock);
+    job->final_status                = status;
+    b->finished[b->finished_count++] = job - b->jobs;
+    rz_th_lock_leave (b->lock);
+}
+
+static bool batchIsPollingStopped (void *user) {
+    BatchDecompile *b = user;
+
+    rz_th_lock_enter (b->lock);
+    bool is_stopped = b->stop_polling;
+    rz_th_lock_leave (b->lock);
+
+    return is_stopped;
+}
+
+// Wait for a decompilation that tracker could not take. Runs on worker threads.
+static void *batchPoll (void *user) {
+    BatchJob           *job    = user;
+    JobWaiter           waiter = JobWaiterInit (0);
+    AiDecompilationPoll poll   = AiDecompilationPollInit (job->fn_id);
+    Status              status = 0;
+
+    waiter.is_cancelled = batchIsPollingStopped;
+    waiter.user         = job->batch;
+    if (JobWait (&waiter, PollAiDecompilation, &poll, &status) != JOB_WAIT_CANCELLED) {
+        batchJobFinished (job, job->fn_id, status);
+    }
+
+    return job;
+}
+
+// Fetch a completed decompilation. Runs on worker threads, must not touch Rizin or other jobs.
+static void *batchFetch (void *user) {
+    BatchJob *job = user;
+
+    switch (job->final_status & STATUS_MASK) {
+        case STATUS_SUCCESS :
+        case STATUS_COMPLETE :
+            break;
+        default :
+            LOG_ERROR ("AI decompilation of '%s' failed", job->name);
+            job->state = BATCH_JOB_FAILED;
+            return job;
+    }
+
+    AiDecompilation aidec = GetAiDecompilation (GetConnection(), job->fn_id, true);
+    job->code             = AnnotatedCodeFromAiDecompilation (&aidec);
+    if (job->code) {
+        CachePutAnnotatedCode (job->fn_id, job->code);
+        CachePutStr (CACHE_KIND_DECOMPILATION, job->fn_id, NULL, &aidec.decompilation);
+        job->state = BATCH_JOB_DONE;
+    } else {
+        LOG_ERROR ("AI decompilation of '%s' is empty", job->name);
+        job->state = BATCH_JOB_FAILED;
+    }
+    AiDecompilationDeinit (&aidec);
+
+    return job;
+}
+
+// Fetch finished decompilations in parallel, writing out each one as soon as it arrives
+static void batchFetchFinished (BatchDecompile *b, const u32 *finished, u32 count) {
+    TaskGroup *group = TaskGroupNew (GetMaxParallelRequests());
+    if (!group) {
+        for (u32 i = 0; i < count && !rz_cons_is_breaked(); i++) {
+            batchEmit (b, batchFetch (&b->jobs[finished[i]]));
+        }
+        return;
+    }
+
+    for (u32 i = 0; i < count; i++) {
+        TaskGroupSubmit (group, batchFetch, &b->jobs[finished[i]]);
+    }
+
+    u64   task   = 0;
+    void *result = NULL;
+    while (!rz_cons_is_breaked() && TaskGroupWaitNext (group, &task, &result)) {
+        batchEmit (b, result);
+    }
+    TaskGroupFree (group, NULL);
+
+    // Fetches that completed after an interrupt
+    for (u32 i = 0; i < count; i++) {
+        BatchJob *job = &b->jobs[finished[i]];
+        if (job->state != BATCH_JOB_PENDING && !job->emitted) {
+            batchEmit (b, job);
+        }
+    }
+}
+
+static void batchPrintProgress (BatchDecompile *b, u64 start_us) {
+    rz_cons_printf (
+        "\rAI decompiled %u/%u functions (%u failed, %llu s elapsed)",
+        b->count - b->remaining - b->summary->failed,
+        b->count,
+        b->summary->failed,
+        (rz_time_now_mono() - start_us) / 1000000
+    );
+    rz_cons_flush();
+}
+
+// Hand all pending decompilations to tracker, which starts them right away and checks all
+// of them together. Ones tracker can't take are checked one by one on worker threads instead.
+// Finished ones are fetched here as they come in.
+static bool batchWait (BatchDecompile *b) {
+    TaskGroup *pollers = NULL;
+    for (u32 i = 0; i < b->count; i++) {
+        BatchJob *job = &b->jobs[i];
+        if (job->state == BATCH_JOB_PENDING) {
+            job->watch_id = DecompilationTrackerWatch (job->fn_id, batchJobFinished, job);
+            if (job->watch_id) {
+                continue;
+            }
+
+            if (!pollers) {
+                pollers = TaskGroupNew (GetMaxParallelRequests());
+            }
+            if (!pollers || !TaskGroupSubmit (pollers, batchPoll, job)) {
+                job->state = BATCH_JOB_FAILED;
+                batchEmit (b, job);
+            }
+        }
+    }
+
+    u64 start_us = rz_time_now_mono();
+    u32 drained  = 0;
+    while (b->remaining && !rz_cons_is_breaked()) {
+        rz_th_lock_enter (b->lock);
+        u32 finished_count = b->finished_count;
+        rz_th_lock_leave (b->lock);
+
+        if (drained < finished_count) {
+            batchFetchFinished (b, b->finished + drained, finished_count - drained);
+            drained = finished_count;
+        } else {
+            rz_sys_usleep (BATCH_PROGRESS_INTERVAL_MS * 1000);
+        }
+
+        // Starts pollers on first call, finished ones report through `finished` like tracker does
+        if (pollers) {
+            u64   task   = 0;
+            void *result = NULL;
+            TaskGroupTryNext (pollers, &task, &result);
+        }
+
+        batchPrintProgress (b, start_us);
+    }
+    rz_cons_newline();
+
+    if (pollers) {
+        rz_th_lock_enter (b->lock);
+        b->stop_polling = true;
+        rz_th_lock_leave (b->lock);
+        TaskGroupFree (pollers, NULL);
+    }
+
+    bool is_cancelled = b->remaining && rz_cons_is_breaked();
+    for (u32 i = 0; i < b->count; i++) {
+        if (b->jobs[i].watch_id) {
+            DecompilationTrackerUnwatch (b->jobs[i].watch_id);
+        }
+    }
+
+    return !is_cancelled;
+}
+
+bool rzBatchDecompile (RzCore *core, const char *selector, const char *output_dir, BatchDecompileSummary *summary) {
+    if (!core || !selector || !summary) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    memset (summary, 0, sizeof (BatchDecompileSummary));
+
+    Selector sel = {0};
+    if (!selectorInit (&sel, selector)) {
+        return false;
+    }
+
+    BatchDecompile b       = {.summary = summary};
+    char          *out_dir = NULL;
+    bool           ok      = batchSelect (&b, core, &sel);
+    selectorDeinit (&sel);
+
+    if (ok && output_dir && *output_dir) {
+        out_dir = rz_path_home_expand (output_dir);
+        if (!out_dir || !rz_sys_mkdirp (out_dir) || !rz_file_is_directory (out_dir)) {
+            DISPLAY_ERROR ("Failed to create output directory '%s'", output_dir);
+            ok = false;
+        } else {
+            // Index describes this run only
+            char *index_path = rz_str_newf ("%s" RZ_SYS_DIR BATCH_INDEX_FILE_NAME, out_dir);
+            const char *header = "address\tfunction_id\tname\tfile\tstatus\n";
+            if (!index_path || !rz_file_dump (index_path, (const ut8 *)header, strlen (header), false)) {
+                DISPLAY_ERROR ("Failed to create decompilation index in '%s'", out_dir);
+                ok = false;
+            }
+            free (index_path);
+            b.output_dir = out_dir;
+        }
+    }
+
+    if (ok && b.count) {
+        // Completed decompilations don't change, cached ones are written out right away
+        for (u32 i = 0; i < b.count; i++) {
+            BatchJob *job = &b.jobs[i];
+            if ((job->code = CacheGetAnnotatedCode (job->fn_id))) {
+                job->state      = BATCH_JOB_DONE;
+                job->from_cache = true;
+                batchEmit (&b, job);
+            }
+        }
+
+        if (b.remaining) {
+            rz_cons_break_push (NULL, NULL);
+            summary->cancelled = !batchWait (&b);
+            rz_cons_break_pop();
+
+            if (summary->cancelled) {
+                LOG_ERROR ("Stopped waiting for %u AI decompilations", b.remaining);
+            }
+        }
+
+        // Anything not finished by now is not waited for
+        for (u32 i = 0; i < b.count; i++) {
+            if (!b.jobs[i].emitted) {
+                b.jobs[i].state = BATCH_JOB_FAILED;
+                batchEmit (&b, &b.jobs[i]);
+            }
+        }
+    }
+
+    for (u32 i = 0; i < b.count; i++) {
+        rz_annotated_code_free (b.jobs[i].code);
+        free (b.jobs[i].name);
+    }
+    free (b.jobs);
+    free (b.finished);
+    if (b.lock) {
+        rz_th_lock_free (b.lock);
+    }
+    free (out_dir);
+
+    return ok;
+}
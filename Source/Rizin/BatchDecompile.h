@@ -0,0 +1,61 @@
+/**
+ * @file : BatchDecompile.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b AI decompilation of many functions at once.
+ * AI decompilation of every selected function is handed to decompilation tracker up front,
+ * which starts them and checks all of them together over at most `GetMaxParallelRequests()`
+ * connections. Each result is fetched and written out as soon as it completes.
+ * */
+
+#ifndef REAI_RIZIN_BATCH_DECOMPILE
+#define REAI_RIZIN_BATCH_DECOMPILE
+
+/* rizin */
+#include <rz_core.h>
+
+/* revenai */
+#include <Reai/Types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct BatchDecompileSummary {
+        u32  selected;   ///< Functions selected that RevEngAI knows about.
+        u32  unknown;    ///< Functions selected that RevEngAI has no function ID for.
+        u32  from_cache; ///< Decompilations already present in cache.
+        u32  decompiled; ///< Decompilations completed in this run.
+        u32  failed;     ///< Decompilations that failed, or were not waited for.
+        bool cancelled;  ///< User interrupted waiting.
+    } BatchDecompileSummary;
+
+    ///
+    /// AI decompile all functions selected by `selector`, and store every result in cache.
+    ///
+    /// Selector is one of :
+    ///   - `all`              : Every function known to Rizin.
+    ///   - `/regex/`          : Functions with names matching regex.
+    ///   - glob with * and ?  : Functions with names matching glob (`sym.parse_*`).
+    ///   - `name1,name2,...`  : Comma separated list of function names.
+    ///
+    /// If `output_dir` is given, each decompilation is also written to `<name>_<addr>.c` in it as soon
+    /// as it completes, and a line describing it is appended to `index.tsv` in same directory.
+    ///
+    /// core[in]       : RzCore.
+    /// selector[in]   : Selects functions to decompile.
+    /// output_dir[in] : Directory to write results to, created if it does not exist. Can be `NULL`.
+    /// summary[out]   : What happened to selected functions.
+    ///
+    /// SUCCESS : `true` if waiting finished, even if some decompilations failed.
+    /// FAILURE : `false` with log messages if nothing could be decompiled.
+    ///
+    bool rzBatchDecompile (RzCore* core, const char* selector, const char* output_dir, BatchDecompileSummary* summary);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_RIZIN_BATCH_DECOMPILE
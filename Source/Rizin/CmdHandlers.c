@@ -28,7 +28,17 @@
 
 /* local includes */
 #include <Rizin/CmdGen/Output/CmdDescs.h>
+#include <Rizin/ArchiveExport.h>
+#include <Rizin/BatchDecompile.h>
+#include <Rizin/RenameQueue.h>
+#include <Archive.h>
+#include <Cache.h>
+#include <DecompilationRender.h>
+#include <DiffCache.h>
+#include <JobWaiter.h>
 #include <Plugin.h>
+#include <Prefetch.h>
+#include <TaskGroup.h>
 #include <Reai/Diff.h>
 
 #define ZSTR_ARG(vn, idx) (argc > (idx) ? (((vn) = argv[idx]), true) : false)
@@ -61,7 +71,7 @@ RZ_IPI RzCmdStatus rz_list_available_ai_models_handler (RzCore* core, int argc,
     (void)argc;
     (void)argv;
 
-    ModelInfos* models = GetModels();
+    ModelInfos* models = WaitForModels();
     VecForeach (models, model, { rz_cons_println (model.name.data); });
 
     return RZ_CMD_STATUS_OK;
@@ -86,6 +96,28 @@ RZ_IPI RzCmdStatus rz_health_check_handler (RzCore* core, int argc, const char**
     return RZ_CMD_STATUS_OK;
 }
 
+/**
+ * "REsync"
+ *
+ * @b Send all queued function renames to RevEngAI and wait until they're done.
+ * */
+RZ_IPI RzCmdStatus rz_sync_function_renames_handler (RzCore* core, int argc, const char** argv) {
+    (void)core;
+    (void)argc;
+    (void)argv;
+
+    u64 synced = 0, failed = 0;
+    RenameQueueFlush (&synced, &failed);
+
+    if (failed) {
+        DISPLAY_ERROR ("Synced %llu function renames with RevEngAI, %llu failed. Check logs.", synced, failed);
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    DISPLAY_INFO ("Synced %llu function renames with RevEngAI.", synced);
+    return RZ_CMD_STATUS_OK;
+}
+
 RzCmdStatus createAnalysis (RzCore* core, int argc, const char** argv, bool is_private) {
     NewAnalysisRequest new_analysis = NewAnalysisRequestInit();
     BinaryId           bin_id       = 0;
@@ -200,7 +232,7 @@ RZ_IPI RzCmdStatus rz_get_basic_function_info_handler (RzCore* core, int argc, c
     (void)argv;
 
     if (rzCanWorkWithAnalysis (GetBinaryId(), true)) {
-        FunctionInfos functions = GetBasicFunctionInfoUsingBinaryId (GetConnection(), GetBinaryId());
+        FunctionInfos functions = GetFunctionInfosCached (GetBinaryId(), true);
 
         if (!functions.length) {
             DISPLAY_ERROR ("Failed to get functions from RevEngAI analysis.");
@@ -256,11 +288,12 @@ RZ_IPI RzCmdStatus rz_rename_function_handler (RzCore* core, int argc, const cha
                 return RZ_CMD_STATUS_ERROR;
             }
 
-            if (RenameFunction (GetConnection(), rzLookupFunctionId (core, fn), new_name)) {
+            if (!RenameFunction (GetConnection(), rzLookupFunctionId (core, fn), new_name)) {
                 DISPLAY_ERROR ("Failed to rename function");
                 return RZ_CMD_STATUS_ERROR;
             }
 
+            InvalidateFunctionInfosCache (GetBinaryId());
             return RZ_CMD_STATUS_OK;
         }
     }
@@ -301,7 +334,7 @@ RzCmdStatus functionSimilaritySearch (RzCore* core, int argc, const char** argv,
         search.function_id = rzLookupFunctionIdForFunctionWithName (core, function_name);
 
         if (search.function_id) {
-            SimilarFunctions functions = GetSimilarFunctions (GetConnection(), &search);
+            SimilarFunctions functions = GetSimilarFunctionsCached (&search);
 
             if (functions.length) {
                 RzTable* table = rz_table_new();
@@ -359,6 +392,31 @@ RZ_IPI RzCmdStatus rz_function_similarity_search_debug_handler (RzCore* core, in
     return functionSimilaritySearch (core, argc, argv, true);
 }
 
+static bool aiDecompilationWaitCancelled (void* user) {
+    (void)user;
+    return rz_cons_is_breaked();
+}
+
+// Tell user about status changes only, not about every status check
+static void aiDecompilationWaitProgress (void* user, Status status, u32 attempt, u64 elapsed_ms) {
+    Status* last_status = user;
+    if ((status & STATUS_MASK) == (*last_status & STATUS_MASK)) {
+        return;
+    }
+    *last_status = status;
+
+    switch (status & STATUS_MASK) {
+        case STATUS_PENDING :
+            DISPLAY_INFO ("AI decompilation is queued and is pending. Should start soon!");
+            break;
+        case STATUS_SUCCESS :
+            break;
+        default :
+            LOG_INFO ("AI decompilation status %u after %u checks (%llu ms)", status, attempt, elapsed_ms);
+            break;
+    }
+}
+
 RZ_IPI RzCmdStatus rz_ai_decompile_handler (RzCore* core, int argc, const char** argv) {
     LOG_INFO ("[CMD] AI decompile");
     const char* fn_name = argc > 1 ? argv[1] : NULL;
@@ -377,149 +435,111 @@ RZ_IPI RzCmdStatus rz_ai_decompile_handler (RzCore* core, int argc, const char**
             return RZ_CMD_STATUS_ERROR;
         }
 
-        Status status = GetAiDecompilationStatus (GetConnection(), fn_id);
-        if ((status & STATUS_MASK) == STATUS_ERROR) {
-            if (!BeginAiDecompilation (GetConnection(), fn_id)) {
-                DISPLAY_ERROR ("Failed to start AI decompilation process.");
-                return RZ_CMD_STATUS_ERROR;
-            }
+        // Callees are likely to be looked at next, get them ready in background
+        RzAnalysisFunction* rzfn = rz_analysis_get_function_byname (core->analysis, fn_name);
+        if (rzfn) {
+            PrefetchCallees (core, rzfn->addr);
         }
 
-        while (true) {
-            DISPLAY_INFO ("Checking decompilation status...");
-
-            status = GetAiDecompilationStatus (GetConnection(), fn_id);
-            switch (status & STATUS_MASK) {
-                case STATUS_ERROR :
-                    DISPLAY_ERROR (
-                        "Failed to decompile '%s'\n"
-                        "Is this function from RevEngAI's analysis?\n"
-                        "What's the output of REfl?~'%s'",
-                        fn_name,
-                        fn_name
-                    );
-                    return RZ_CMD_STATUS_ERROR;
-
-                case STATUS_UNINITIALIZED :
-                    DISPLAY_INFO (
-                        "No decompilation exists for this function...\n"
-                        "Starting AI decompilation process!"
-                    );
-                    if (!BeginAiDecompilation (GetConnection(), fn_id)) {
-                        DISPLAY_ERROR ("Failed to start AI decompilation process.");
-                        return RZ_CMD_STATUS_ERROR;
-                    }
-                    break;
-
-                case STATUS_PENDING : {
-                    DISPLAY_INFO ("AI decompilation is queued and is pending. Should start soon!");
-                    break;
-                }
+        // Completed decompilations don't change, and may already be prefetched
+        RzAnnotatedCode* code = CacheGetAnnotatedCode (fn_id);
+        if (code) {
+            LOG_INFO ("Using cached AI decompilation of '%s'", fn_name);
+            rz_cons_println (code->code);
+            rz_annotated_code_free (code);
+            return RZ_CMD_STATUS_OK;
+        }
 
-                case STATUS_SUCCESS : {
-                    DISPLAY_INFO ("AI decompilation complete ;-)\n");
+        // Wait until decompilation completes, or user interrupts with Ctrl-C
+        Status    last_status = 0;
+        JobWaiter waiter      = JobWaiterInit (0);
+        waiter.is_cancelled   = aiDecompilationWaitCancelled;
+        waiter.on_progress    = aiDecompilationWaitProgress;
+        waiter.user           = &last_status;
 
-                    AiDecompilation aidec = GetAiDecompilation (GetConnection(), fn_id, true);
-                    Str*            smry  = &aidec.ai_summary;
-                    Str*            dec   = &aidec.raw_decompilation;
+        rz_cons_break_push (NULL, NULL);
+        JobWaitResult wait_result = WaitForAiDecompilation (&waiter, fn_id);
+        rz_cons_break_pop();
 
-                    Str code = StrInit();
+        switch (wait_result) {
+            case JOB_WAIT_SUCCESS :
+                break;
+            case JOB_WAIT_CANCELLED :
+                DISPLAY_ERROR ("Stopped waiting for AI decompilation of '%s'", fn_name);
+                return RZ_CMD_STATUS_ERROR;
+            default :
+                DISPLAY_ERROR (
+                    "Failed to decompile '%s'\n"
+                    "Is this function from RevEngAI's analysis?\n"
+                    "What's the output of REfl?~'%s'",
+                    fn_name,
+                    fn_name
+                );
+                return RZ_CMD_STATUS_ERROR;
+        }
 
-                    static i32 SOFT_LIMIT = 120;
+        DISPLAY_INFO ("AI decompilation complete ;-)\n");
 
-                    i32   l = smry->length;
-                    char* p = smry->data;
-                    while (l > SOFT_LIMIT) {
-                        char* p1 = strchr (p + SOFT_LIMIT, ' ');
-                        if (p1) {
-                            StrAppendf (&code, "// %.*s\n", (i32)(p1 - p), p);
-                            p1++;
-                            l -= (p1 - p);
-                            p  = p1;
-                        } else {
-                            break;
-                        }
-                    }
-                    StrAppendf (&code, "// %.*s\n\n", (i32)l, p);
-                    StrMerge (&code, dec);
-
-                    LOG_INFO ("aidec.functions.length = %zu", aidec.functions.length);
-                    VecForeachIdx (&aidec.functions, function, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<DISASM_FUNCTION_%llu>", idx);
-                        StrReplace (&code, &dname, &function.name, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.strings.length = %zu", aidec.strings.length);
-                    VecForeachIdx (&aidec.strings, string, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<DISASM_STRING_%llu>", idx);
-                        StrReplace (&code, &dname, &string.string, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.unmatched.functions.length = %zu", aidec.unmatched.functions.length);
-                    VecForeachIdx (&aidec.unmatched.functions, function, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<UNMATCHED_FUNCTION_%llu>", idx);
-                        StrReplace (&code, &dname, &function.name, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.unmatched.strings.length = %zu", aidec.unmatched.strings.length);
-                    VecForeachIdx (&aidec.unmatched.strings, string, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<UNMATCHED_STRING_%llu>", idx);
-                        StrReplace (&code, &dname, &string.value.str, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.unmatched.vars.length = %zu", aidec.unmatched.vars.length);
-                    VecForeachIdx (&aidec.unmatched.vars, var, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<VAR_%llu>", idx);
-                        StrReplace (&code, &dname, &var.value.str, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.unmatched.external_vars.length = %zu", aidec.unmatched.external_vars.length);
-                    VecForeachIdx (&aidec.unmatched.external_vars, var, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<EXTERNAL_VARIABLE_%llu>", idx);
-                        StrReplace (&code, &dname, &var.value.str, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    LOG_INFO ("aidec.unmatched.custom_types.length = %zu", aidec.unmatched.custom_types.length);
-                    VecForeachIdx (&aidec.unmatched.custom_types, var, idx, {
-                        Str dname = StrInit();
-                        StrPrintf (&dname, "<CUSTOM_TYPE_%llu>", idx);
-                        StrReplace (&code, &dname, &var.value.str, -1);
-                        StrDeinit (&dname);
-                    });
-
-                    // print decompiled code with summary
-                    rz_cons_println (code.data);
-
-                    StrDeinit (&code);
-                    AiDecompilationDeinit (&aidec);
-                    return RZ_CMD_STATUS_OK;
-                }
-                default :
-                    LOG_FATAL ("Unreachable code reached. Invalid decompilation status");
-                    return RZ_CMD_STATUS_ERROR;
-            }
+        AiDecompilation aidec = GetAiDecompilation (GetConnection(), fn_id, true);
+        code                  = AnnotatedCodeFromAiDecompilation (&aidec);
 
-            DISPLAY_INFO ("Going to sleep for two seconds...");
-            rz_sys_sleep (2);
+        // print decompiled code with summary
+        if (code) {
+            CachePutAnnotatedCode (fn_id, code);
+            rz_cons_println (code->code);
+            rz_annotated_code_free (code);
+        } else {
+            Str summary_only = RenderAiDecompilation (&aidec, true, NULL);
+            rz_cons_println (summary_only.data);
+            StrDeinit (&summary_only);
         }
+
+        AiDecompilationDeinit (&aidec);
+        return RZ_CMD_STATUS_OK;
     } else {
         DISPLAY_ERROR ("Failed to get AI decompilation.");
         return RZ_CMD_STATUS_ERROR;
     }
 }
 
+RZ_IPI RzCmdStatus rz_ai_decompile_batch_handler (RzCore* core, int argc, const char** argv) {
+    LOG_INFO ("[CMD] AI decompile batch");
+    const char* selector   = argc > 1 ? argv[1] : NULL;
+    const char* output_dir = argc > 2 ? argv[2] : NULL;
+    if (!selector || !*selector) {
+        return RZ_CMD_STATUS_INVALID;
+    }
+
+    if (!rzCanWorkWithAnalysis (GetBinaryId(), true)) {
+        DISPLAY_ERROR ("Failed to get AI decompilation.");
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    BatchDecompileSummary summary = {0};
+    if (!rzBatchDecompile (core, selector, output_dir, &summary)) {
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    if (!summary.selected) {
+        DISPLAY_ERROR ("No function known to RevEngAI matches '%s'", selector);
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    DISPLAY_INFO (
+        "AI decompiled %u of %u functions (%u from cache), %u failed, %u without function ID.",
+        summary.decompiled + summary.from_cache,
+        summary.selected,
+        summary.from_cache,
+        summary.failed,
+        summary.unknown
+    );
+    if (summary.cancelled) {
+        DISPLAY_ERROR ("Stopped waiting. Decompilations already started keep running on RevEngAI servers.");
+    }
+
+    return summary.failed ? RZ_CMD_STATUS_ERROR : RZ_CMD_STATUS_OK;
+}
+
 RzCmdStatus collectionSearch (SearchCollectionRequest* search) {
     CollectionInfos collections = SearchCollection (GetConnection(), search);
     SearchCollectionRequestDeinit (search);
@@ -1112,14 +1132,90 @@ Strs wrapText (const char* text, int width, int max_lines) {
     return wrapped_lines;
 }
 
+// Targets of diff viewers are loaded in background, list shows where each one is
+typedef enum DiffItemState {
+    DIFF_ITEM_LOADING,
+    DIFF_ITEM_READY,
+    DIFF_ITEM_FAILED,
+} DiffItemState;
+
 // Structure to hold list items and their corresponding target strings
 typedef struct {
-    Str name;           // Display name in the list
-    Str target_content; // Corresponding target string for diff
+    Str           name;           // Display name in the list
+    Str           target_content; // Corresponding target string for diff, a placeholder until ready
+    DiffItemState state;
 } DiffListItem;
 
 typedef Vec (DiffListItem) DiffListItems;
 
+// Scroll position of diff panels, and which panels must be drawn again.
+// Canvas is kept between draws, and only panels marked dirty are rebuilt on it.
+typedef struct DiffViewport {
+    u64  top;        // First diff line shown in both diff panels
+    u64  page;       // Diff lines shown in both diff panels on last draw
+    int  w;          // Terminal size on last draw, zero to rebuild whole canvas
+    int  h;
+    bool list_dirty; // Selection or state of an item changed
+    bool diff_dirty; // Diff or scroll position changed
+} DiffViewport;
+
+// Rebuild whole canvas on next draw, after something else was drawn over it
+static void diffViewportInvalidate (DiffViewport* vp) {
+    vp->w = 0;
+    vp->h = 0;
+}
+
+// Show a new diff from it's first line
+static void diffViewportReset (DiffViewport* vp) {
+    vp->top        = 0;
+    vp->diff_dirty = true;
+}
+
+static bool diffViewportScroll (DiffViewport* vp, DiffLines* diff, i64 delta) {
+    u64 last = diff->length ? diff->length - 1 : 0;
+    u64 top  = 0;
+    if (delta < 0) {
+        top = (u64)-delta > vp->top ? 0 : vp->top - (u64)-delta;
+    } else {
+        top = MIN2 (vp->top + (u64)delta, last);
+    }
+
+    if (top == vp->top) {
+        return false;
+    }
+    vp->top        = top;
+    vp->diff_dirty = true;
+    return true;
+}
+
+// Scroll by a page, keeping one line of previous page in view
+static bool diffViewportPage (DiffViewport* vp, DiffLines* diff, bool down) {
+    i64 step = vp->page > 1 ? (i64)vp->page - 1 : 1;
+    return diffViewportScroll (vp, diff, down ? step : -step);
+}
+
+// A hunk starts at a changed line right after an unchanged one
+static bool diffIsHunkStart (DiffLines* diff, u64 idx) {
+    return VecPtrAt (diff, idx)->type != DIFF_TYPE_SAM && (!idx || VecPtrAt (diff, idx - 1)->type == DIFF_TYPE_SAM);
+}
+
+static bool diffViewportJumpHunk (DiffViewport* vp, DiffLines* diff, bool forward) {
+    if (forward) {
+        for (u64 idx = vp->top + 1; idx < diff->length; idx++) {
+            if (diffIsHunkStart (diff, idx)) {
+                return diffViewportScroll (vp, diff, (i64)(idx - vp->top));
+            }
+        }
+    } else {
+        for (u64 idx = MIN2 (vp->top, diff->length); idx-- > 0;) {
+            if (diffIsHunkStart (diff, idx)) {
+                return diffViewportScroll (vp, diff, -(i64)(vp->top - idx));
+            }
+        }
+    }
+    return false;
+}
+
 bool drawInteractiveList (RzConsCanvas* c, const char* header, int w, int h, DiffListItems* items, int selected_idx) {
     int x          = sep / 2;
     int y          = sep / 2;
@@ -1130,6 +1226,9 @@ bool drawInteractiveList (RzConsCanvas* c, const char* header, int w, int h, Dif
         return false;
     }
 
+    // Panel may be drawn over it's previous content
+    rz_cons_canvas_fill (c, x, y, list_width, h, ' ');
+
     // Calculate header text positions with boundary checks
     const char* header_text = header;
     int         header_len  = strlen (header_text);
@@ -1183,7 +1282,15 @@ bool drawInteractiveList (RzConsCanvas* c, const char* header, int w, int h, Dif
             LOG_FATAL ("UI rendering failed: invalid display width or null item name");
         }
 
-        Strs wrapped_lines = wrapText (item.name.data, wrap_width, max_lines - current_display_line);
+        Str label = StrInitFromStr (&item.name);
+        if (item.state == DIFF_ITEM_LOADING) {
+            StrAppendf (&label, " [loading]");
+        } else if (item.state == DIFF_ITEM_FAILED) {
+            StrAppendf (&label, " [unavailable]");
+        }
+
+        Strs wrapped_lines = wrapText (label.data, wrap_width, max_lines - current_display_line);
+        StrDeinit (&label);
 
         VecForeachIdx (&wrapped_lines, wrapped_line, i, {
             if (current_display_line >= max_lines)
@@ -1236,12 +1343,31 @@ bool drawInteractiveList (RzConsCanvas* c, const char* header, int w, int h, Dif
     return true;
 }
 
+// Show which diff lines are in view, at right end of panel header
+static void drawDiffPosition (RzConsCanvas* c, int x, int y, int width, int header_end, u64 top, u64 length) {
+    char position[64];
+    snprintf (
+        position,
+        sizeof (position),
+        "(%llu/%llu)",
+        (unsigned long long)(length ? top + 1 : 0),
+        (unsigned long long)length
+    );
+
+    int position_x = x + width - (int)strlen (position) - 2;
+    if (position_x > header_end) {
+        rz_cons_canvas_write_at (c, position, position_x, y + 1);
+    }
+}
+
 bool drawInteractiveSourceDiff (
     RzConsCanvas* c,
     const char*   header,
     int           w,
     int           h,
     DiffLines*    diff,
+    u64           top,
+    u64*          shown,
     bool          show_line_numbers
 ) {
     int x          = (w * 2) / 8 + sep / 2;      // Start after the list panel (2/8)
@@ -1253,6 +1379,9 @@ bool drawInteractiveSourceDiff (
         return false;
     }
 
+    // Panel may be drawn over it's previous content
+    rz_cons_canvas_fill (c, x, y, diff_width, h, ' ');
+
     // Write header text first with boundary check
     const char* header_text = header;
     int         header_len  = strlen (header_text);
@@ -1264,6 +1393,7 @@ bool drawInteractiveSourceDiff (
     }
 
     rz_cons_canvas_write_at (c, header_text, header_x, y + 1);
+    drawDiffPosition (c, x, y, diff_width, header_x + header_len, top, diff->length);
 
     int line_y        = y + 3;
     int max_lines     = h - 5;
@@ -1274,10 +1404,12 @@ bool drawInteractiveSourceDiff (
         return false;
     }
 
-    VecForeachPtr (diff, diff_line, {
+    *shown = 0;
+    for (u64 idx = top; idx < diff->length; idx++) {
         if (current_line >= max_lines)
             break;
 
+        DiffLine*   diff_line    = VecPtrAt (diff, idx);
         const char* content_text = NULL;
         u64         line_number  = 0;
         bool        has_content  = true;
@@ -1376,7 +1508,8 @@ bool drawInteractiveSourceDiff (
             // Clean up wrapped lines
             VecDeinit (&wrapped_lines);
         }
-    });
+        (*shown)++;
+    }
 
     // Draw the box after all text content is written
     rz_cons_canvas_box (c, x, y, diff_width, h, Color_RESET);
@@ -1390,6 +1523,8 @@ bool drawInteractiveTargetDiff (
     int           w,
     int           h,
     DiffLines*    diff,
+    u64           top,
+    u64*          shown,
     bool          show_line_numbers
 ) {
     int x          = (w * 5) / 8 + sep / 2;      // Start after the source panel (2/8 + 3/8 = 5/8)
@@ -1401,6 +1536,9 @@ bool drawInteractiveTargetDiff (
         return false;
     }
 
+    // Panel may be drawn over it's previous content
+    rz_cons_canvas_fill (c, x, y, diff_width, h, ' ');
+
     // Write header text first with boundary check
     const char* header_text = header;
     int         header_len  = strlen (header_text);
@@ -1412,6 +1550,7 @@ bool drawInteractiveTargetDiff (
     }
 
     rz_cons_canvas_write_at (c, header_text, header_x, y + 1);
+    drawDiffPosition (c, x, y, diff_width, header_x + header_len, top, diff->length);
 
     int line_y        = y + 3;
     int max_lines     = h - 5;
@@ -1422,10 +1561,12 @@ bool drawInteractiveTargetDiff (
         return false;
     }
 
-    VecForeachPtr (diff, diff_line, {
+    *shown = 0;
+    for (u64 idx = top; idx < diff->length; idx++) {
         if (current_line >= max_lines)
             break;
 
+        DiffLine*   diff_line    = VecPtrAt (diff, idx);
         const char* content_text = NULL;
         u64         line_number  = 0;
         bool        has_content  = true;
@@ -1524,7 +1665,8 @@ bool drawInteractiveTargetDiff (
             // Clean up wrapped lines
             VecDeinit (&wrapped_lines);
         }
-    });
+        (*shown)++;
+    }
 
     // Draw the box after all text content is written
     rz_cons_canvas_box (c, x, y, diff_width, h, Color_RESET);
@@ -1549,7 +1691,7 @@ bool drawHelpArea (RzConsCanvas* c, int w, int h) {
     // Write help text
     rz_cons_canvas_write_at (
         c,
-        "k=Up j=Down q=Quit h=Help r=Rename (window re-renders on any key press)",
+        "k=Up j=Down K/PgUp J/PgDn=Scroll n/N=Next/Prev change q=Quit h=Help r=Rename",
         2,
         help_y + 1
     );
@@ -1756,6 +1898,7 @@ RzConsCanvas* drawInteractiveDiff (
     DiffListItems* items,
     int            selected_idx,
     DiffLines*     diff,
+    DiffViewport*  vp,
     bool           show_line_numbers
 ) {
     // get terminal size
@@ -1764,6 +1907,7 @@ RzConsCanvas* drawInteractiveDiff (
     // if canvas is not created then create
     if (c == NULL) {
         c = rz_cons_canvas_new (w, h);
+        diffViewportInvalidate (vp);
     }
 
     // resize canvas on windows resize
@@ -1771,23 +1915,37 @@ RzConsCanvas* drawInteractiveDiff (
         rz_cons_canvas_resize (c, w, h);
     }
 
-    // create canvas
-    rz_cons_canvas_clear (c);
-
-    if (!drawInteractiveList (c, list_header, w, h, items, selected_idx)) {
-        return NULL;
-    }
-    if (!drawInteractiveSourceDiff (c, source_header, w, h, diff, show_line_numbers)) {
-        return NULL;
+    // Whole canvas is rebuilt only when it's new, resized or drawn over, otherwise just dirty panels
+    bool full = vp->w != w || vp->h != h;
+    if (full) {
+        rz_cons_canvas_clear (c);
+        if (!drawHelpArea (c, w, h)) {
+            return NULL;
+        }
     }
-    if (!drawInteractiveTargetDiff (c, target_header, w, h, diff, show_line_numbers)) {
-        return NULL;
+
+    if (full || vp->list_dirty) {
+        if (!drawInteractiveList (c, list_header, w, h, items, selected_idx)) {
+            return NULL;
+        }
     }
 
-    if (!drawHelpArea (c, w, h)) {
-        return NULL;
+    if (full || vp->diff_dirty) {
+        u64 source_shown = 0, target_shown = 0;
+        if (!drawInteractiveSourceDiff (c, source_header, w, h, diff, vp->top, &source_shown, show_line_numbers)) {
+            return NULL;
+        }
+        if (!drawInteractiveTargetDiff (c, target_header, w, h, diff, vp->top, &target_shown, show_line_numbers)) {
+            return NULL;
+        }
+        vp->page = MIN2 (source_shown, target_shown);
     }
 
+    vp->w          = w;
+    vp->h          = h;
+    vp->list_dirty = false;
+    vp->diff_dirty = false;
+
     rz_cons_canvas_print (c);
     rz_cons_flush();
 
@@ -1808,6 +1966,10 @@ void DiffListItemDeinit (DiffListItem* item) {
 Str getFunctionLinearDisasm (FunctionId function_id) {
     Str linear_disasm = StrInit();
 
+    if (CacheGetStr (CACHE_KIND_LINEAR_DISASM, function_id, NULL, &linear_disasm)) {
+        return linear_disasm;
+    }
+
     // Get the control flow graph for this function
     ControlFlowGraph cfg = GetFunctionControlFlowGraph (GetConnection(), function_id);
 
@@ -1867,39 +2029,307 @@ Str getFunctionLinearDisasm (FunctionId function_id) {
     // Replace all tab characters with four spaces
     StrReplaceZstr (&linear_disasm, "\t", "    ", -1);
 
+    CachePutStr (CACHE_KIND_LINEAR_DISASM, function_id, NULL, &linear_disasm);
+
     return linear_disasm;
 }
 
-Str getFunctionDecompilation (FunctionId function_id) {
-    Str final_code = StrInit();
+// Maximum time to wait for AI decompilation of a function shown in a diff view
+#define DIFF_DECOMPILATION_DEADLINE_MS (60 * 1000)
 
-    // Check decompilation status
-    Status status = GetAiDecompilationStatus (GetConnection(), function_id);
+/**
+ * Get AI decompilation of a function, waiting for it to complete.
+ *
+ * @param function_id  : Function ID to get decompilation of
+ * @param is_cancelled : Stops waiting when it returns true. Can be NULL
+ * @param user         : Passed to `is_cancelled`
+ * @return Str : Decompilation, empty if it failed or wait was cancelled (caller must free)
+ */
+Str getFunctionDecompilation (FunctionId function_id, bool (*is_cancelled) (void* user), void* user) {
+    Str final_code = StrInit();
 
-    if ((status & STATUS_MASK) == STATUS_ERROR || (status & STATUS_MASK) == STATUS_UNINITIALIZED) {
-        // Try to begin decompilation
-        if (!BeginAiDecompilation (GetConnection(), function_id)) {
-            return final_code; // Return empty on failure
-        }
-        // Return empty for now - will be fetched in background
+    // Only completed decompilations are cached, anything else needs a status check
+    if (CacheGetStr (CACHE_KIND_DECOMPILATION, function_id, NULL, &final_code)) {
         return final_code;
     }
 
-    if ((status & STATUS_MASK) == STATUS_PENDING) {
-        // Still pending - return empty for now
-        return final_code;
+    // Runs on worker threads while other similar functions are fetched, so don't wait forever
+    JobWaiter waiter    = JobWaiterInit (DIFF_DECOMPILATION_DEADLINE_MS);
+    waiter.is_cancelled = is_cancelled;
+    waiter.user         = user;
+    if (WaitForAiDecompilation (&waiter, function_id) != JOB_WAIT_SUCCESS) {
+        return final_code; // Return empty on failure
     }
 
-    if ((status & STATUS_MASK) == STATUS_SUCCESS) {
-        // Get the decompilation - skip summary for diff purposes
-        AiDecompilation aidec = GetAiDecompilation (GetConnection(), function_id, true);
-        final_code            = StrDup (&aidec.decompilation);
-        AiDecompilationDeinit (&aidec);
+    // Get the decompilation - skip summary for diff purposes
+    AiDecompilation aidec = GetAiDecompilation (GetConnection(), function_id, true);
+    final_code            = StrDup (&aidec.decompilation);
+    AiDecompilationDeinit (&aidec);
+
+    if (final_code.length) {
+        CachePutStr (CACHE_KIND_DECOMPILATION, function_id, NULL, &final_code);
     }
 
     return final_code;
 }
 
+// Fetches content of a function, stops any waiting once `is_cancelled` returns true
+typedef Str (*FunctionContentFetcher) (FunctionId function_id, bool (*is_cancelled) (void* user), void* user);
+
+// Disassembly is a single request, nothing to cancel once it's started
+static Str fetchFunctionLinearDisasm (FunctionId function_id, bool (*is_cancelled) (void* user), void* user) {
+    if (is_cancelled && is_cancelled (user)) {
+        return StrInit();
+    }
+    return getFunctionLinearDisasm (function_id);
+}
+
+typedef struct SimilarItemsLoader SimilarItemsLoader;
+
+typedef struct SimilarContentFetch {
+    FunctionId             function_id;
+    FunctionContentFetcher fetch;
+    Str                    content;
+    SimilarItemsLoader*    loader;
+} SimilarContentFetch;
+
+// How often diff viewers look for targets loaded in background while waiting for input
+#define DIFF_LOAD_POLL_US (100 * 1000)
+
+struct SimilarItemsLoader {
+    TaskGroup*           group;
+    SimilarContentFetch* fetches;
+    u64                  count;
+    u64                  pending; // Items still loading
+    const char*          what;
+    RzThreadLock*        lock;
+    bool                 cancelled; // Stops waits of running fetches, guarded by `lock`
+};
+
+static bool similarItemsIsCancelled (void* user) {
+    SimilarItemsLoader* loader = user;
+
+    rz_th_lock_enter (loader->lock);
+    bool cancelled = loader->cancelled;
+    rz_th_lock_leave (loader->lock);
+
+    return cancelled;
+}
+
+// Make running fetches return as soon as possible, without content
+static void similarItemsCancel (SimilarItemsLoader* loader) {
+    if (!loader->lock) {
+        return;
+    }
+
+    rz_th_lock_enter (loader->lock);
+    loader->cancelled = true;
+    rz_th_lock_leave (loader->lock);
+}
+
+static void* similarContentFetchTask (void* user) {
+    SimilarContentFetch* f = user;
+    f->content             = f->fetch (f->function_id, similarItemsIsCancelled, f->loader);
+    return f;
+}
+
+// Move fetched content of a similar function into it's list item
+static void similarItemsLoaded (SimilarItemsLoader* loader, DiffListItems* items, u64 idx) {
+    SimilarContentFetch* f    = &loader->fetches[idx];
+    DiffListItem*        item = VecPtrAt (items, idx);
+
+    StrDeinit (&item->target_content);
+    if (f->content.length) {
+        item->target_content = f->content;
+        item->state          = DIFF_ITEM_READY;
+    } else {
+        LOG_ERROR ("Failed to get %s for function ID %llu", loader->what, f->function_id);
+        StrDeinit (&f->content);
+        item->target_content = StrInit();
+        StrPrintf (&item->target_content, "Failed to get %s of this function.", loader->what);
+        item->state = DIFF_ITEM_FAILED;
+    }
+    f->content = StrInit();
+    loader->pending--;
+}
+
+/**
+ * Start fetching content of all similar functions in background, over at most
+ * `GetMaxParallelRequests()` connections. Items are created right away in loading state,
+ * and are updated by `similarItemsCollect` as their content arrives.
+ *
+ * @param loader            : Loader state, to be deinited with `similarItemsLoadDeinit`
+ * @param similar_functions : Functions to fetch content of
+ * @param fetch             : Fetches content of one function, called from worker threads
+ * @param what              : What's being fetched, used in messages
+ * @return DiffListItems : One item per similar function, in same order as `similar_functions`
+ */
+static DiffListItems similarItemsLoadStart (
+    SimilarItemsLoader*    loader,
+    SimilarFunctions*      similar_functions,
+    FunctionContentFetcher fetch,
+    const char*            what
+) {
+    DiffListItems items = VecInit();
+    memset (loader, 0, sizeof (SimilarItemsLoader));
+    loader->what = what;
+
+    u64 count       = similar_functions->length;
+    loader->fetches = calloc (count, sizeof (SimilarContentFetch));
+    loader->lock    = rz_th_lock_new (false);
+    if (!loader->fetches || !loader->lock) {
+        LOG_ERROR ("Failed to allocate memory for %s fetches", what);
+        return items;
+    }
+
+    for (u64 i = 0; i < count; i++) {
+        SimilarFunction* similar_fn = VecPtrAt (similar_functions, i);
+
+        loader->fetches[i].function_id = similar_fn->id;
+        loader->fetches[i].fetch       = fetch;
+        loader->fetches[i].content     = StrInit();
+        loader->fetches[i].loader      = loader;
+
+        // Create display name with similarity percentage
+        DiffListItem item = {.name = StrInit(), .target_content = StrInit(), .state = DIFF_ITEM_LOADING};
+        StrPrintf (
+            &item.name,
+            "%s (%.1f%% - %s)",
+            similar_fn->name.data,
+            (1. - similar_fn->distance) * 100.,
+            similar_fn->binary_name.data
+        );
+        StrPrintf (&item.target_content, "Loading %s of this function...", what);
+        VecPushBack (&items, item);
+    }
+    loader->count   = count;
+    loader->pending = count;
+
+    loader->group = TaskGroupNew (GetMaxParallelRequests());
+    for (u64 i = 0; i < count; i++) {
+        if (!loader->group || !TaskGroupSubmit (loader->group, similarContentFetchTask, &loader->fetches[i])) {
+            similarContentFetchTask (&loader->fetches[i]);
+            similarItemsLoaded (loader, &items, i);
+        }
+    }
+
+    return items;
+}
+
+/**
+ * Update items whose content arrived since last call.
+ *
+ * @param loader           : Loader state
+ * @param items            : Items created by `similarItemsLoadStart`
+ * @param wait             : Block until at least one item is updated, unless none is pending
+ * @param selected_idx     : Index of selected item
+ * @param selected_changed : Set to true if selected item was updated. Can be NULL
+ * @return bool : true if any item was updated
+ */
+static bool similarItemsCollect (
+    SimilarItemsLoader* loader,
+    DiffListItems*      items,
+    bool                wait,
+    int                 selected_idx,
+    bool*               selected_changed
+) {
+    if (!loader->group || !loader->pending) {
+        return false;
+    }
+
+    bool  is_updated = false;
+    u64   task       = 0;
+    void* result     = NULL;
+    while (wait && !is_updated ? TaskGroupWaitNext (loader->group, &task, &result) :
+                                 TaskGroupTryNext (loader->group, &task, &result)) {
+        // Task indices skip fetches that ran serially, fetch itself tells which item it's for
+        u64 idx = (SimilarContentFetch*)result - loader->fetches;
+        similarItemsLoaded (loader, items, idx);
+        is_updated = true;
+        if ((int)idx == selected_idx && selected_changed) {
+            *selected_changed = true;
+        }
+    }
+
+    return is_updated;
+}
+
+/**
+ * Wait until content of one similar function is available, printing progress meanwhile.
+ * Ctrl-C cancels all fetches.
+ *
+ * @return int : Index of first item with content, -1 if none of them could be fetched
+ */
+static int similarItemsWaitFirst (SimilarItemsLoader* loader, DiffListItems* items) {
+    int first = -1;
+
+    rz_cons_break_push (NULL, NULL);
+    while (true) {
+        VecForeachIdx (items, item, idx, {
+            if (first < 0 && item.state == DIFF_ITEM_READY) {
+                first = (int)idx;
+            }
+        });
+        if (first >= 0 || !loader->group || !loader->pending) {
+            break;
+        }
+
+        if (rz_cons_is_breaked()) {
+            similarItemsCancel (loader);
+            break;
+        }
+
+        if (!similarItemsCollect (loader, items, false, -1, NULL)) {
+            rz_sys_usleep (DIFF_LOAD_POLL_US);
+            continue;
+        }
+
+        rz_cons_printf (
+            "\rFetched %s of %llu/%llu similar functions",
+            loader->what,
+            (u64)items->length - loader->pending,
+            (u64)items->length
+        );
+        rz_cons_flush();
+    }
+    rz_cons_break_pop();
+
+    rz_cons_printf ("\n");
+    rz_cons_flush();
+    return first;
+}
+
+// Cancel waits of running fetches, stop starting new ones, and wait for running ones to return
+static void similarItemsLoadDeinit (SimilarItemsLoader* loader) {
+    similarItemsCancel (loader);
+    if (loader->group && loader->pending) {
+        LOG_INFO ("Waiting for %llu running %s fetches to finish", loader->pending, loader->what);
+    }
+    TaskGroupFree (loader->group, NULL);
+
+    // Content of loaded items was moved out, only results that were never collected are left
+    for (u64 i = 0; loader->fetches && i < loader->count; i++) {
+        StrDeinit (&loader->fetches[i].content);
+    }
+    free (loader->fetches);
+    if (loader->lock) {
+        rz_th_lock_free (loader->lock);
+    }
+    memset (loader, 0, sizeof (SimilarItemsLoader));
+}
+
+// Compute diffs of items around selected one in background, so moving up or down shows them at once
+static void prefetchNeighbourDiffs (Str* src, DiffListItems* items, int selected_idx, DiffMode mode) {
+    for (int idx = selected_idx - 1; idx <= selected_idx + 1; idx += 2) {
+        if (idx >= 0 && idx < (int)items->length) {
+            DiffListItem* item = VecPtrAt (items, idx);
+            if (item->state == DIFF_ITEM_READY) {
+                DiffCachePrefetch (src, &item->target_content, mode);
+            }
+        }
+    }
+}
+
 RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, const char** argv) {
     // Parse arguments: function_name and optional similarity_level
     const char* function_name  = NULL;
@@ -1954,7 +2384,7 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
     search.debug_include.system_symbols   = false;
     search.debug_include.external_symbols = false;
 
-    SimilarFunctions similar_functions = GetSimilarFunctions (GetConnection(), &search);
+    SimilarFunctions similar_functions = GetSimilarFunctionsCached (&search);
 
     if (similar_functions.length == 0) {
         DISPLAY_ERROR ("No similar functions found for '%s' with %u%% similarity", function_name, min_similarity);
@@ -1970,57 +2400,54 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
         min_similarity
     );
 
-    // Create list of similar functions with their disassembly
-    DiffListItems items = VecInit();
-
-    VecForeachPtr (&similar_functions, similar_fn, {
-        DiffListItem item = {0};
-
-        // Create display name with similarity percentage
-        item.name = StrInit();
-        StrPrintf (
-            &item.name,
-            "%s (%.1f%% - %s)",
-            similar_fn->name.data,
-            (1. - similar_fn->distance) * 100.,
-            similar_fn->binary_name.data
-        );
-
-        // Get linear disassembly for this similar function
-        item.target_content = getFunctionLinearDisasm (similar_fn->id);
+    // Viewer opens as soon as one similar function has disassembly, others keep loading in background
+    SimilarItemsLoader loader = {0};
+    DiffListItems      items =
+        similarItemsLoadStart (&loader, &similar_functions, fetchFunctionLinearDisasm, "disassembly");
 
-        // Only add if we successfully got disassembly
-        if (item.target_content.length > 0) {
-            VecPushBack (&items, item);
-        } else {
-            LOG_ERROR ("Failed to get disassembly for function ID %llu", similar_fn->id);
-            DiffListItemDeinit (&item);
-        }
-    });
+    // Start with first similar function that's available
+    int selected_idx = similarItemsWaitFirst (&loader, &items);
 
     // Check if we have any valid similar functions with disassembly
-    if (items.length == 0) {
+    if (selected_idx < 0) {
         DISPLAY_ERROR ("No similar functions with valid disassembly found for '%s'", function_name);
+        similarItemsLoadDeinit (&loader);
         StrDeinit (&src);
         VecDeinit (&similar_functions);
         SimilarFunctionsRequestDeinit (&search);
+        VecForeachPtr (&items, item, { DiffListItemDeinit (item); });
         VecDeinit (&items);
         return RZ_CMD_STATUS_OK;
     }
 
-    int selected_idx = 0; // Start with first item selected
+    // Operands are ignored by default, they differ between binaries almost everywhere
+    DiffMode    diff_mode     = DIFF_MODE_ASSEMBLY_NORMALIZED;
+    const char* source_header = "SOURCE (NORMALIZED)";
+    const char* target_header = "TARGET (NORMALIZED)";
 
     // Generate initial diff
     DiffListItem* current_item = VecPtrAt (&items, selected_idx);
-    DiffLines     diff         = GetDiff (&src, &current_item->target_content);
+    DiffLines*    diff         = DiffCacheAcquire (&src, &current_item->target_content, diff_mode);
+    prefetchNeighbourDiffs (&src, &items, selected_idx, diff_mode);
 
     // Create initial canvas
-    RzConsCanvas* c =
-        drawInteractiveDiff (NULL, "SIMILAR FUNCTIONS", "SOURCE", "TARGET", &items, selected_idx, &diff, false);
+    DiffViewport  viewport = {.list_dirty = true, .diff_dirty = true};
+    RzConsCanvas* c        = drawInteractiveDiff (
+        NULL,
+        "SIMILAR FUNCTIONS",
+        source_header,
+        target_header,
+        &items,
+        selected_idx,
+        diff,
+        &viewport,
+        false
+    );
 
     if (!c) {
         DISPLAY_ERROR ("Failed to create interactive diff viewer");
-        VecDeinit (&diff);
+        similarItemsLoadDeinit (&loader);
+        DiffCacheRelease (diff);
         StrDeinit (&src);
         VecDeinit (&similar_functions);
         SimilarFunctionsRequestDeinit (&search);
@@ -2034,30 +2461,64 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
 
     int ch = 0; // Start with no input
     while (true) {
-        // Only process and re-render when we have actual input
-        if (ch != 0) {
-            bool need_redraw   = false;
-            bool need_new_diff = false;
+        bool need_redraw   = false;
+        bool need_new_diff = false;
 
+        // Only process input when we have some
+        if (ch != 0) {
             switch (ch) {
                 case 'q' :
                 case 'Q' :
+                case 3 : // Ctrl-C
                     goto cleanup;
 
                 case 'k' : // Up
                     if (selected_idx > 0) {
                         selected_idx--;
-                        need_redraw   = true;
-                        need_new_diff = true;
+                        viewport.list_dirty = true;
+                        need_redraw         = true;
+                        need_new_diff       = true;
                     }
                     break;
 
                 case 'j' : // Down
                     if (selected_idx < (int)items.length - 1) {
                         selected_idx++;
-                        need_redraw   = true;
-                        need_new_diff = true;
+                        viewport.list_dirty = true;
+                        need_redraw         = true;
+                        need_new_diff       = true;
+                    }
+                    break;
+
+                case 'J' : // Page down, PgDn arrives as 'J'
+                    need_redraw = diffViewportPage (&viewport, diff, true);
+                    break;
+
+                case 'K' : // Page up, PgUp arrives as 'K'
+                    need_redraw = diffViewportPage (&viewport, diff, false);
+                    break;
+
+                case 'n' : // Next change
+                    need_redraw = diffViewportJumpHunk (&viewport, diff, true);
+                    break;
+
+                case 'N' : // Previous change
+                    need_redraw = diffViewportJumpHunk (&viewport, diff, false);
+                    break;
+
+                case 'o' : // Toggle operand normalization
+                case 'O' :
+                    if (diff_mode == DIFF_MODE_ASSEMBLY_NORMALIZED) {
+                        diff_mode     = DIFF_MODE_ASSEMBLY;
+                        source_header = "SOURCE";
+                        target_header = "TARGET";
+                    } else {
+                        diff_mode     = DIFF_MODE_ASSEMBLY_NORMALIZED;
+                        source_header = "SOURCE (NORMALIZED)";
+                        target_header = "TARGET (NORMALIZED)";
                     }
+                    need_redraw   = true;
+                    need_new_diff = true;
                     break;
 
                 case 'h' : // Help
@@ -2071,7 +2532,7 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
 
                         // Calculate center position for help box
                         int box_width  = 60;
-                        int box_height = 16;
+                        int box_height = 21;
                         int box_x      = (help_w - box_width) / 2;
                         int box_y      = (help_h - box_height) / 2;
 
@@ -2099,31 +2560,49 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
                         rz_cons_canvas_write_at (help_canvas, "  j       : Move selection down", box_x + 4, box_y + 6);
                         rz_cons_canvas_write_at (
                             help_canvas,
-                            "  r       : Rename source function",
+                            "  J / K   : Scroll diff page down / up",
+                            box_x + 4,
+                            box_y + 7
+                        );
+                        rz_cons_canvas_write_at (
+                            help_canvas,
+                            "  n / N   : Jump to next / previous change",
+                            box_x + 4,
+                            box_y + 8
+                        );
+                        rz_cons_canvas_write_at (
+                            help_canvas,
+                            "  o       : Toggle operand normalization",
                             box_x + 4,
                             box_y + 9
                         );
-                        rz_cons_canvas_write_at (help_canvas, "  q / ESC : Quit viewer", box_x + 4, box_y + 7);
-                        rz_cons_canvas_write_at (help_canvas, "  h / ?   : Show this help", box_x + 4, box_y + 8);
+                        rz_cons_canvas_write_at (
+                            help_canvas,
+                            "  r       : Rename source function",
+                            box_x + 4,
+                            box_y + 12
+                        );
+                        rz_cons_canvas_write_at (help_canvas, "  q / ESC : Quit viewer", box_x + 4, box_y + 10);
+                        rz_cons_canvas_write_at (help_canvas, "  h / ?   : Show this help", box_x + 4, box_y + 11);
 
-                        rz_cons_canvas_write_at (help_canvas, "Usage:", box_x + 2, box_y + 11);
+                        rz_cons_canvas_write_at (help_canvas, "Usage:", box_x + 2, box_y + 14);
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Left panel shows similar functions",
                             box_x + 4,
-                            box_y + 12
+                            box_y + 15
                         );
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Right panels show function diff",
                             box_x + 4,
-                            box_y + 13
+                            box_y + 16
                         );
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Use k/j to compare similar functions",
                             box_x + 4,
-                            box_y + 14
+                            box_y + 17
                         );
 
                         rz_cons_canvas_write_at (
@@ -2198,10 +2677,13 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
                             Str old_name_str = StrInitFromZstr (function_name);
 
                             if (RenameFunction (GetConnection(), source_fn_id, target_name)) {
+                                InvalidateFunctionInfosCache (GetBinaryId());
+                                BeginRenameSyncSuppression();
                                 rz_analysis_function_rename (
                                     rz_analysis_get_function_byname (core->analysis, function_name),
                                     target_name.data
                                 );
+                                EndRenameSyncSuppression();
                                 rz_cons_printf (
                                     "Successfully renamed function '%s' to '%s'\n",
                                     function_name,
@@ -2228,6 +2710,8 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
 
                     StrDeinit (&target_name);
 
+                    // Dialogs were drawn over diff viewer
+                    diffViewportInvalidate (&viewport);
                     need_redraw = true;
                 } break;
 
@@ -2235,40 +2719,58 @@ RZ_IPI RzCmdStatus rz_function_assembly_diff_handler (RzCore* core, int argc, co
                     // Ignore unknown keys - no action needed
                     break;
             }
+        }
 
-            if (need_new_diff) {
-                // Clean up old diff
-                VecDeinit (&diff);
+        // Show similar functions that finished loading in background
+        bool selected_loaded = false;
+        if (similarItemsCollect (&loader, &items, false, selected_idx, &selected_loaded)) {
+            viewport.list_dirty = true;
+            need_redraw         = true;
+            need_new_diff       = need_new_diff || selected_loaded;
+            prefetchNeighbourDiffs (&src, &items, selected_idx, diff_mode);
+        }
 
-                // Generate new diff with selected item
-                current_item = VecPtrAt (&items, selected_idx);
-                diff         = GetDiff (&src, &current_item->target_content);
-            }
+        if (need_new_diff) {
+            // Release old diff
+            DiffCacheRelease (diff);
 
-            if (need_redraw) {
-                if (!(c = drawInteractiveDiff (
-                          c,
-                          "SIMILAR FUNCTIONS",
-                          "SOURCE",
-                          "TARGET",
-                          &items,
-                          selected_idx,
-                          &diff,
-                          false
-                      ))) {
-                    rz_cons_canvas_free (c);
-                    c = NULL;
-                    break;
-                }
+            // Get diff of selected item, usually already computed in background
+            current_item = VecPtrAt (&items, selected_idx);
+            diff         = DiffCacheAcquire (&src, &current_item->target_content, diff_mode);
+            diffViewportReset (&viewport);
+            prefetchNeighbourDiffs (&src, &items, selected_idx, diff_mode);
+        }
+
+        if (need_redraw) {
+            if (!(c = drawInteractiveDiff (
+                      c,
+                      "SIMILAR FUNCTIONS",
+                      source_header,
+                      target_header,
+                      &items,
+                      selected_idx,
+                      diff,
+                      &viewport,
+                      false
+                  ))) {
+                rz_cons_canvas_free (c);
+                c = NULL;
+                break;
             }
         }
 
-        // Wait for actual user input (blocking)
-        ch = rz_cons_readchar();
+        // Wait for user input, but not for too long while similar functions are still loading
+        ch = loader.pending ? rz_cons_readchar_timeout (DIFF_LOAD_POLL_US) : rz_cons_readchar();
+        if (ch < 0) {
+            ch = 0; // Timed out
+        } else {
+            ch = rz_cons_arrow_to_hjkl (ch); // Arrows select, PgUp/PgDn scroll
+        }
     }
 
 cleanup:
     // Cleanup
+    similarItemsLoadDeinit (&loader);
     if (c) {
         rz_cons_canvas_free (c);
     }
@@ -2279,7 +2781,7 @@ cleanup:
         help_canvas = NULL;
     }
 
-    VecDeinit (&diff);
+    DiffCacheRelease (diff);
     StrDeinit (&src);
 
     // Clean up similar functions data
@@ -2331,7 +2833,9 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
     }
 
     // Get decompilation for source function
-    Str src = getFunctionDecompilation (source_fn_id);
+    rz_cons_break_push (NULL, NULL);
+    Str src = getFunctionDecompilation (source_fn_id, aiDecompilationWaitCancelled, NULL);
+    rz_cons_break_pop();
     if (src.length == 0) {
         DISPLAY_ERROR (
             "Failed to get decompilation for function '%s'. Function may not be decompiled yet.",
@@ -2350,7 +2854,7 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
     search.debug_include.system_symbols   = false;
     search.debug_include.external_symbols = false;
 
-    SimilarFunctions similar_functions = GetSimilarFunctions (GetConnection(), &search);
+    SimilarFunctions similar_functions = GetSimilarFunctionsCached (&search);
 
     if (similar_functions.length == 0) {
         DISPLAY_ERROR ("No similar functions found for '%s' with %u%% similarity", function_name, min_similarity);
@@ -2366,65 +2870,49 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
         min_similarity
     );
 
-    // Create list of similar functions with their decompilation
-    DiffListItems items = VecInit();
-
-    VecForeachPtr (&similar_functions, similar_fn, {
-        DiffListItem item = {0};
+    // Viewer opens as soon as one similar function has decompilation, others keep loading in background
+    SimilarItemsLoader loader = {0};
+    DiffListItems      items =
+        similarItemsLoadStart (&loader, &similar_functions, getFunctionDecompilation, "decompilation");
 
-        // Create display name with similarity percentage
-        item.name = StrInit();
-        StrPrintf (
-            &item.name,
-            "%s (%.1f%% - %s)",
-            similar_fn->name.data,
-            (1. - similar_fn->distance) * 100.,
-            similar_fn->binary_name.data
-        );
-
-        // Get decompilation for this similar function
-        item.target_content = getFunctionDecompilation (similar_fn->id);
-
-        // Only add if we successfully got decompilation
-        if (item.target_content.length > 0) {
-            VecPushBack (&items, item);
-        } else {
-            LOG_ERROR ("Failed to get decompilation for function ID %llu", similar_fn->id);
-            DiffListItemDeinit (&item);
-        }
-    });
+    // Start with first similar function that's available
+    int selected_idx = similarItemsWaitFirst (&loader, &items);
 
     // Check if we have any valid similar functions with decompilation
-    if (items.length == 0) {
+    if (selected_idx < 0) {
         DISPLAY_ERROR ("No similar functions with valid decompilation found for '%s'", function_name);
+        similarItemsLoadDeinit (&loader);
         StrDeinit (&src);
         VecDeinit (&similar_functions);
         SimilarFunctionsRequestDeinit (&search);
+        VecForeachPtr (&items, item, { DiffListItemDeinit (item); });
         VecDeinit (&items);
         return RZ_CMD_STATUS_OK;
     }
 
-    int selected_idx = 0; // Start with first item selected
-
     // Generate initial diff
     DiffListItem* current_item = VecPtrAt (&items, selected_idx);
-    DiffLines     diff         = GetDiff (&src, &current_item->target_content);
+    DiffLines*    diff         = DiffCacheAcquire (&src, &current_item->target_content, DIFF_MODE_DECOMPILATION);
+    prefetchNeighbourDiffs (&src, &items, selected_idx, DIFF_MODE_DECOMPILATION);
 
     // Create initial canvas
-    RzConsCanvas* c = drawInteractiveDiff (
+    DiffViewport  viewport = {.list_dirty = true, .diff_dirty = true};
+    RzConsCanvas* c        = drawInteractiveDiff (
         NULL,
         "SIMILAR FUNCTIONS",
         "SOURCE DECOMPILATION",
         "TARGET DECOMPILATION",
         &items,
         selected_idx,
-        &diff,
+        diff,
+        &viewport,
         false
     );
 
     if (!c) {
         DISPLAY_ERROR ("Failed to create interactive diff viewer");
-        VecDeinit (&diff);
+        similarItemsLoadDeinit (&loader);
+        DiffCacheRelease (diff);
         StrDeinit (&src);
         VecDeinit (&similar_functions);
         SimilarFunctionsRequestDeinit (&search);
@@ -2438,32 +2926,51 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
 
     int ch = 0; // Start with no input
     while (true) {
-        // Only process and re-render when we have actual input
-        if (ch != 0) {
-            bool need_redraw   = false;
-            bool need_new_diff = false;
+        bool need_redraw   = false;
+        bool need_new_diff = false;
 
+        // Only process input when we have some
+        if (ch != 0) {
             switch (ch) {
                 case 'q' :
                 case 'Q' :
+                case 3 : // Ctrl-C
                     goto cleanup;
 
                 case 'k' : // Up
                     if (selected_idx > 0) {
                         selected_idx--;
-                        need_redraw   = true;
-                        need_new_diff = true;
+                        viewport.list_dirty = true;
+                        need_redraw         = true;
+                        need_new_diff       = true;
                     }
                     break;
 
                 case 'j' : // Down
                     if (selected_idx < (int)items.length - 1) {
                         selected_idx++;
-                        need_redraw   = true;
-                        need_new_diff = true;
+                        viewport.list_dirty = true;
+                        need_redraw         = true;
+                        need_new_diff       = true;
                     }
                     break;
 
+                case 'J' : // Page down, PgDn arrives as 'J'
+                    need_redraw = diffViewportPage (&viewport, diff, true);
+                    break;
+
+                case 'K' : // Page up, PgUp arrives as 'K'
+                    need_redraw = diffViewportPage (&viewport, diff, false);
+                    break;
+
+                case 'n' : // Next change
+                    need_redraw = diffViewportJumpHunk (&viewport, diff, true);
+                    break;
+
+                case 'N' : // Previous change
+                    need_redraw = diffViewportJumpHunk (&viewport, diff, false);
+                    break;
+
                 case 'h' : // Help
                 case '?' : {
                     // Get current terminal size
@@ -2475,7 +2982,7 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
 
                         // Calculate center position for help box
                         int box_width  = 60;
-                        int box_height = 16;
+                        int box_height = 20;
                         int box_x      = (help_w - box_width) / 2;
                         int box_y      = (help_h - box_height) / 2;
 
@@ -2501,33 +3008,45 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
                         rz_cons_canvas_write_at (help_canvas, "Navigation Controls:", box_x + 2, box_y + 4);
                         rz_cons_canvas_write_at (help_canvas, "  k       : Move selection up", box_x + 4, box_y + 5);
                         rz_cons_canvas_write_at (help_canvas, "  j       : Move selection down", box_x + 4, box_y + 6);
-                        rz_cons_canvas_write_at (help_canvas, "  q / ESC : Quit viewer", box_x + 4, box_y + 7);
-                        rz_cons_canvas_write_at (help_canvas, "  h / ?   : Show this help", box_x + 4, box_y + 8);
+                        rz_cons_canvas_write_at (
+                            help_canvas,
+                            "  J / K   : Scroll diff page down / up",
+                            box_x + 4,
+                            box_y + 7
+                        );
+                        rz_cons_canvas_write_at (
+                            help_canvas,
+                            "  n / N   : Jump to next / previous change",
+                            box_x + 4,
+                            box_y + 8
+                        );
+                        rz_cons_canvas_write_at (help_canvas, "  q / ESC : Quit viewer", box_x + 4, box_y + 9);
+                        rz_cons_canvas_write_at (help_canvas, "  h / ?   : Show this help", box_x + 4, box_y + 10);
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "  r       : Rename source function",
                             box_x + 4,
-                            box_y + 9
+                            box_y + 11
                         );
 
-                        rz_cons_canvas_write_at (help_canvas, "Usage:", box_x + 2, box_y + 11);
+                        rz_cons_canvas_write_at (help_canvas, "Usage:", box_x + 2, box_y + 13);
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Left panel shows similar functions",
                             box_x + 4,
-                            box_y + 12
+                            box_y + 14
                         );
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Right panels show decompilation diff",
                             box_x + 4,
-                            box_y + 13
+                            box_y + 15
                         );
                         rz_cons_canvas_write_at (
                             help_canvas,
                             "• Use k/j to compare similar functions",
                             box_x + 4,
-                            box_y + 14
+                            box_y + 16
                         );
 
                         rz_cons_canvas_write_at (
@@ -2602,10 +3121,13 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
                             Str old_name_str = StrInitFromZstr (function_name);
 
                             if (RenameFunction (GetConnection(), source_fn_id, target_name)) {
+                                InvalidateFunctionInfosCache (GetBinaryId());
+                                BeginRenameSyncSuppression();
                                 rz_analysis_function_rename (
                                     rz_analysis_get_function_byname (core->analysis, function_name),
                                     target_name.data
                                 );
+                                EndRenameSyncSuppression();
                                 rz_cons_printf (
                                     "Successfully renamed function '%s' to '%s'\n",
                                     function_name,
@@ -2632,6 +3154,8 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
 
                     StrDeinit (&target_name);
 
+                    // Dialogs were drawn over diff viewer
+                    diffViewportInvalidate (&viewport);
                     need_redraw = true;
                 } break;
 
@@ -2639,40 +3163,58 @@ RZ_IPI RzCmdStatus rz_function_decompilation_diff_handler (RzCore* core, int arg
                     // Ignore unknown keys - no action needed
                     break;
             }
+        }
 
-            if (need_new_diff) {
-                // Clean up old diff
-                VecDeinit (&diff);
+        // Show similar functions that finished loading in background
+        bool selected_loaded = false;
+        if (similarItemsCollect (&loader, &items, false, selected_idx, &selected_loaded)) {
+            viewport.list_dirty = true;
+            need_redraw         = true;
+            need_new_diff       = need_new_diff || selected_loaded;
+            prefetchNeighbourDiffs (&src, &items, selected_idx, DIFF_MODE_DECOMPILATION);
+        }
 
-                // Generate new diff with selected item
-                current_item = VecPtrAt (&items, selected_idx);
-                diff         = GetDiff (&src, &current_item->target_content);
-            }
+        if (need_new_diff) {
+            // Release old diff
+            DiffCacheRelease (diff);
 
-            if (need_redraw) {
-                if (!(c = drawInteractiveDiff (
-                          c,
-                          "SIMILAR FUNCTIONS",
-                          "SOURCE DECOMPILATION",
-                          "TARGET DECOMPILATION",
-                          &items,
-                          selected_idx,
-                          &diff,
-                          false
-                      ))) {
-                    rz_cons_canvas_free (c);
-                    c = NULL;
-                    break;
-                }
+            // Get diff of selected item, usually already computed in background
+            current_item = VecPtrAt (&items, selected_idx);
+            diff         = DiffCacheAcquire (&src, &current_item->target_content, DIFF_MODE_DECOMPILATION);
+            diffViewportReset (&viewport);
+            prefetchNeighbourDiffs (&src, &items, selected_idx, DIFF_MODE_DECOMPILATION);
+        }
+
+        if (need_redraw) {
+            if (!(c = drawInteractiveDiff (
+                      c,
+                      "SIMILAR FUNCTIONS",
+                      "SOURCE DECOMPILATION",
+                      "TARGET DECOMPILATION",
+                      &items,
+                      selected_idx,
+                      diff,
+                      &viewport,
+                      false
+                  ))) {
+                rz_cons_canvas_free (c);
+                c = NULL;
+                break;
             }
         }
 
-        // Wait for actual user input (blocking)
-        ch = rz_cons_readchar();
+        // Wait for user input, but not for too long while similar functions are still loading
+        ch = loader.pending ? rz_cons_readchar_timeout (DIFF_LOAD_POLL_US) : rz_cons_readchar();
+        if (ch < 0) {
+            ch = 0; // Timed out
+        } else {
+            ch = rz_cons_arrow_to_hjkl (ch); // Arrows select, PgUp/PgDn scroll
+        }
     }
 
 cleanup:
     // Cleanup
+    similarItemsLoadDeinit (&loader);
     if (c) {
         rz_cons_canvas_free (c);
     }
@@ -2683,7 +3225,7 @@ cleanup:
         help_canvas = NULL;
     }
 
-    VecDeinit (&diff);
+    DiffCacheRelease (diff);
     StrDeinit (&src);
 
     // Clean up similar functions data
@@ -2697,6 +3239,77 @@ cleanup:
     return RZ_CMD_STATUS_OK;
 }
 
+/**
+ * "REdx"
+ * */
+RZ_IPI RzCmdStatus rz_ai_decompilation_export_handler (RzCore* core, int argc, const char** argv) {
+    (void)core;
+    LOG_INFO ("[CMD] AI decompilation export");
+    const char* path = argc > 1 ? argv[1] : NULL;
+    if (!path || !*path) {
+        return RZ_CMD_STATUS_INVALID;
+    }
+
+    if (!rzCanWorkWithAnalysis (GetBinaryId(), true)) {
+        DISPLAY_ERROR ("Failed to export AI decompilations.");
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    ArchiveExportSummary summary = {0};
+    if (!rzExportArchive (path, getFunctionLinearDisasm, &summary)) {
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    DISPLAY_INFO (
+        "Exported %u AI decompilations and %u disassemblies of %u functions, %u similar function searches\n"
+        "with %u of their results, %llu entries in total, to '%s'.",
+        summary.decompilations,
+        summary.disassemblies,
+        summary.functions,
+        summary.searches,
+        summary.targets,
+        summary.entries,
+        path
+    );
+    if (summary.cancelled) {
+        DISPLAY_ERROR ("Stopped fetching, %u functions were left out or exported only from cache.", summary.left_out);
+    } else if (summary.left_out) {
+        DISPLAY_ERROR (
+            "%u functions could not be fetched completely and may be missing from archive. Check logs for IDs.",
+            summary.left_out
+        );
+    }
+
+    return RZ_CMD_STATUS_OK;
+}
+
+/**
+ * "REdi"
+ * */
+RZ_IPI RzCmdStatus rz_ai_decompilation_import_handler (RzCore* core, int argc, const char** argv) {
+    LOG_INFO ("[CMD] AI decompilation import");
+    const char* path = argc > 1 ? argv[1] : NULL;
+    if (!path || !*path) {
+        return RZ_CMD_STATUS_INVALID;
+    }
+
+    char* archive_path = rz_path_home_expand (path);
+    bool  is_mounted   = archive_path && ArchiveMount (archive_path);
+    free (archive_path);
+    if (!is_mounted) {
+        DISPLAY_ERROR ("Failed to load archive '%s'. Was it created by REdx?", path);
+        return RZ_CMD_STATUS_ERROR;
+    }
+
+    u64      entry_count = 0;
+    BinaryId binary_id   = ArchiveGetBinaryId (&entry_count);
+    SetBinaryId (binary_id);
+    SetBinaryIdInCore (core, binary_id);
+
+    DISPLAY_INFO ("Serving binary ID %llu from archive '%s' with %llu entries.", binary_id, path, entry_count);
+    return RZ_CMD_STATUS_OK;
+}
+
 
 // clang-format off
 RZ_IPI RzCmdStatus rz_show_revengai_art_handler (RzCore* core, int argc, const char** argv) {
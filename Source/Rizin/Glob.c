@@ -0,0 +1,42 @@
+/**
+ * @file : Glob.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* revengai */
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Rizin/Glob.h>
+
+bool GlobMatch (const char *glob, const char *s) {
+    if (!glob || !s) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    // On mismatch, last `*` takes one more character and matching resumes after it
+    const char *star  = NULL;
+    const char *retry = NULL;
+
+    while (*s) {
+        if (*glob == '*') {
+            star  = glob++;
+            retry = s;
+        } else if (*glob == '?' || *glob == *s) {
+            glob++;
+            s++;
+        } else if (star) {
+            glob = star + 1;
+            s    = ++retry;
+        } else {
+            return false;
+        }
+    }
+
+    while (*glob == '*') {
+        glob++;
+    }
+    return !*glob;
+}
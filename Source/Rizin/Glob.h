@@ -0,0 +1,33 @@
+/**
+ * @file : Glob.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Shell style wildcard matching of function names, used by function selectors.
+ * */
+
+#ifndef REAI_RIZIN_GLOB
+#define REAI_RIZIN_GLOB
+
+/* revenai */
+#include <Reai/Types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Match whole of `s` against `glob`, where `*` matches any run of characters (even an empty
+    /// one) and `?` matches exactly one character. Every other character matches only itself.
+    ///
+    /// SUCCESS : `true` if `s` matches.
+    /// FAILURE : `false` otherwise.
+    ///
+    bool GlobMatch (const char* glob, const char* s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_RIZIN_GLOB
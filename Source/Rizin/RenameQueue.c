@@ -0,0 +1,278 @@
+/**
+ * @file : RenameQueue.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* rizin */
+#include <rz_th.h>
+#include <rz_util/rz_sys.h>
+
+/* revengai */
+#include <Reai/Api.h>
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Plugin.h>
+#include <Rizin/RenameQueue.h>
+#include <Util.h>
+
+// Time to wait after first queued rename before sending a batch, so that
+// scripted or repeated renames are sent together and coalesced.
+#define RENAME_QUEUE_BATCH_DELAY_US (200 * 1000)
+
+typedef struct PendingRename {
+    BinaryId binary_id;
+    u64      offset;
+    char    *name;
+} PendingRename;
+
+typedef struct RenameQueue {
+    RzThreadLock  *lock;
+    RzThreadCond  *wake; // signalled on push, flush and stop
+    RzThreadCond  *idle; // signalled when queue is drained
+    RzThread      *worker;
+    PendingRename *pending;
+    u64            length;
+    u64            capacity;
+    u64            in_flight;
+    u64            synced;
+    u64            failed;
+    bool           flush_requested;
+    bool           stop_requested;
+} RenameQueue;
+
+static RenameQueue rq = {0};
+
+static void renameQueueSend (PendingRename *batch, u64 length, u64 *synced, u64 *failed) {
+    BinaryId checked_binary_id = 0;
+    bool     can_sync          = false;
+
+    FunctionRenames renames = VecInitWithDeepCopy_T (&renames, NULL, FunctionRenameDeinit);
+    for (u64 i = 0; i < length; i++) {
+        PendingRename *r = &batch[i];
+
+        // Status is cached, this is a network request only for first rename of a binary
+        if (r->binary_id != checked_binary_id) {
+            checked_binary_id = r->binary_id;
+            can_sync          = rzCanWorkWithAnalysis (r->binary_id, false);
+        }
+
+        if (!can_sync) {
+            LOG_INFO ("RevEngAI analysis not ready, skipping function rename sync for '%s'", r->name);
+            (*failed)++;
+            continue;
+        }
+
+        FunctionId fn_id = GetFunctionIdForOffset (r->binary_id, r->offset);
+        if (!fn_id) {
+            LOG_ERROR ("Failed to find RevEngAI function ID for function '%s' at offset 0x%llx", r->name, r->offset);
+            (*failed)++;
+            continue;
+        }
+
+        FunctionRename rename = {.function_id = fn_id, .new_name = StrInitFromZstr (r->name)};
+        VecPushBack (&renames, rename);
+    }
+
+    size batch_synced  = BatchRenameFunctions (&renames);
+    *synced           += batch_synced;
+    *failed           += renames.length - batch_synced;
+
+    // Cached function lists of these binaries now have old names
+    if (batch_synced) {
+        BinaryId invalidated_binary_id = 0;
+        for (u64 i = 0; i < length; i++) {
+            if (batch[i].binary_id != invalidated_binary_id) {
+                invalidated_binary_id = batch[i].binary_id;
+                InvalidateFunctionInfosCache (invalidated_binary_id);
+            }
+        }
+    }
+
+    VecDeinit (&renames);
+}
+
+static void *renameQueueWorker (void *user) {
+    (void)user;
+
+    rz_th_lock_enter (rq.lock);
+    while (true) {
+        while (!rq.length && !rq.stop_requested) {
+            rz_th_cond_wait (rq.wake, rq.lock);
+        }
+
+        if (!rq.length && rq.stop_requested) {
+            break;
+        }
+
+        // Let consecutive renames pile up, unless somebody is already waiting for us
+        if (!rq.flush_requested && !rq.stop_requested) {
+            rz_th_lock_leave (rq.lock);
+            rz_sys_usleep (RENAME_QUEUE_BATCH_DELAY_US);
+            rz_th_lock_enter (rq.lock);
+        }
+
+        // Take whole queue as one batch, new renames keep queueing up meanwhile
+        PendingRename *batch        = rq.pending;
+        u64            batch_length = rq.length;
+        rq.pending                  = NULL;
+        rq.length                   = 0;
+        rq.capacity                 = 0;
+        rq.in_flight                = batch_length;
+        rz_th_lock_leave (rq.lock);
+
+        u64 synced = 0, failed = 0;
+        renameQueueSend (batch, batch_length, &synced, &failed);
+        for (u64 i = 0; i < batch_length; i++) {
+            free (batch[i].name);
+        }
+        free (batch);
+
+        rz_th_lock_enter (rq.lock);
+        rq.in_flight  = 0;
+        rq.synced    += synced;
+        rq.failed    += failed;
+        if (!rq.length) {
+            rq.flush_requested = false;
+            rz_th_cond_signal_all (rq.idle);
+        }
+    }
+
+    rz_th_cond_signal_all (rq.idle);
+    rz_th_lock_leave (rq.lock);
+
+    return NULL;
+}
+
+bool RenameQueueInit() {
+    if (rq.worker) {
+        return true;
+    }
+
+    RzThreadCond **conds[] = {&rq.wake, &rq.idle};
+    if (!ThreadSyncNew (&rq.lock, conds, 2)) {
+        LOG_ERROR ("Failed to create rename queue synchronization primitives");
+        return false;
+    }
+
+    rq.worker = rz_th_new (renameQueueWorker, NULL);
+    if (!rq.worker) {
+        LOG_ERROR ("Failed to start rename queue worker thread");
+        RenameQueueDeinit();
+        return false;
+    }
+
+    return true;
+}
+
+void RenameQueueDeinit() {
+    if (rq.worker) {
+        rz_th_lock_enter (rq.lock);
+        rq.stop_requested = true;
+        rz_th_cond_signal (rq.wake);
+        rz_th_lock_leave (rq.lock);
+
+        rz_th_wait (rq.worker);
+        rz_th_free (rq.worker);
+    }
+
+    for (u64 i = 0; i < rq.length; i++) {
+        free (rq.pending[i].name);
+    }
+    free (rq.pending);
+
+    if (rq.idle) {
+        rz_th_cond_free (rq.idle);
+    }
+    if (rq.wake) {
+        rz_th_cond_free (rq.wake);
+    }
+    if (rq.lock) {
+        rz_th_lock_free (rq.lock);
+    }
+
+    memset (&rq, 0, sizeof (rq));
+}
+
+void RenameQueuePush (BinaryId binary_id, u64 offset, const char *name) {
+    if (!binary_id || !name) {
+        LOG_ERROR ("Invalid arguments");
+        return;
+    }
+
+    if (!rq.worker) {
+        LOG_ERROR ("Rename queue is not running, dropping rename of function to '%s'", name);
+        return;
+    }
+
+    char *name_copy = strdup (name);
+    if (!name_copy) {
+        LOG_ERROR ("Failed to allocate memory for queued function rename");
+        return;
+    }
+
+    rz_th_lock_enter (rq.lock);
+
+    // Coalesce with a rename of same function that's not sent yet
+    for (u64 i = rq.length; i > 0; i--) {
+        PendingRename *r = &rq.pending[i - 1];
+        if (r->binary_id == binary_id && r->offset == offset) {
+            free (r->name);
+            r->name = name_copy;
+            rz_th_lock_leave (rq.lock);
+            return;
+        }
+    }
+
+    if (rq.length == rq.capacity) {
+        u64            capacity = rq.capacity ? rq.capacity * 2 : 16;
+        PendingRename *pending  = realloc (rq.pending, capacity * sizeof (PendingRename));
+        if (!pending) {
+            LOG_ERROR ("Failed to allocate memory for queued function rename");
+            rz_th_lock_leave (rq.lock);
+            free (name_copy);
+            return;
+        }
+        rq.pending  = pending;
+        rq.capacity = capacity;
+    }
+
+    rq.pending[rq.length++] = (PendingRename) {.binary_id = binary_id, .offset = offset, .name = name_copy};
+    rz_th_cond_signal (rq.wake);
+
+    rz_th_lock_leave (rq.lock);
+}
+
+void RenameQueueFlush (u64 *synced, u64 *failed) {
+    if (!rq.worker) {
+        if (synced) {
+            *synced = 0;
+        }
+        if (failed) {
+            *failed = 0;
+        }
+        return;
+    }
+
+    rz_th_lock_enter (rq.lock);
+
+    rq.flush_requested = true;
+    rz_th_cond_signal (rq.wake);
+    while ((rq.length || rq.in_flight) && !rq.stop_requested) {
+        rz_th_cond_wait (rq.idle, rq.lock);
+    }
+    rq.flush_requested = false;
+
+    if (synced) {
+        *synced = rq.synced;
+    }
+    if (failed) {
+        *failed = rq.failed;
+    }
+    rq.synced = 0;
+    rq.failed = 0;
+
+    rz_th_lock_leave (rq.lock);
+}
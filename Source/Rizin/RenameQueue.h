@@ -0,0 +1,57 @@
+/**
+ * @file : RenameQueue.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Background queue for syncing Rizin function renames with RevEngAI.
+ * Rename hook only pushes renames here and returns immediately. A single worker thread
+ * drains the queue in batches, and sends only the latest name for each function.
+ * */
+
+#ifndef REAI_RIZIN_RENAME_QUEUE
+#define REAI_RIZIN_RENAME_QUEUE
+
+/* revenai */
+#include <Reai/Types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// Start background worker. Must be called once from main thread before any push.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages. Pushed renames are dropped in this case.
+    ///
+    bool RenameQueueInit();
+
+    ///
+    /// Send remaining renames, then stop and join background worker.
+    ///
+    void RenameQueueDeinit();
+
+    ///
+    /// Queue a function rename to be synced with RevEngAI.
+    /// If a rename of same function is already waiting in queue, only it's name is updated.
+    ///
+    /// binary_id[in] : Binary ID function belongs to.
+    /// offset[in]    : Function address without binary base address.
+    /// name[in]      : New name of function. Copied internally.
+    ///
+    void RenameQueuePush (BinaryId binary_id, u64 offset, const char* name);
+
+    ///
+    /// Send all queued renames right away and block until the queue is drained.
+    ///
+    /// synced[out] : Number of renames synced since last flush. Can be `NULL`.
+    /// failed[out] : Number of renames that failed since last flush. Can be `NULL`.
+    ///
+    void RenameQueueFlush (u64* synced, u64* failed);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_RIZIN_RENAME_QUEUE
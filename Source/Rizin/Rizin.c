@@ -29,6 +29,7 @@
 
 /* local includes */
 #include <Rizin/CmdGen/Output/CmdDescs.h>
+#include <Rizin/RenameQueue.h>
 #include <Plugin.h>
 #include "../PluginVersion.h"
 
@@ -88,36 +89,25 @@ static int reai_on_fcn_rename (RzAnalysis *analysis, RzCore *core, RzAnalysisFun
 
     LOG_INFO ("Function rename detected: new name '%s' at 0x%llx", fcn->name, fcn->addr);
 
+    // Rename was applied by the plugin itself, RevEngAI already has this name
+    if (IsRenameSyncSuppressed()) {
+        LOG_INFO ("Function rename sync suppressed, skipping function rename sync");
+        return 0;
+    }
+
     // Only sync if we have a valid binary ID (analysis is applied)
     // Use GetBinaryIdFromCore to check both local storage and RzCore config.
     // In Cutter, fetching binary id from local plugin storage won't work,
     // and the IdFromCore will end up fetching from RzCore config only.
-    // Check if we can work with the current analysis
-    if (!rzCanWorkWithAnalysis (GetBinaryIdFromCore (core), false)) {
-        LOG_INFO ("RevEngAI analysis not ready, skipping function rename sync");
-        return 1;
-    }
-
-    // Look up the RevEngAI function ID for this Rizin function
-    FunctionId fn_id = rzLookupFunctionId (core, fcn);
-    if (!fn_id) {
-        LOG_ERROR ("Failed to find RevEngAI function ID for function '%s' at 0x%llx", fcn->name, fcn->addr);
-        return 1;
-    }
-
-    // Create new name string for the API call
-    Str new_name = StrInitFromZstr (fcn->name);
-
-    // Call RevEngAI API to rename the function
-    if (RenameFunction (GetConnection(), fn_id, new_name)) {
-        LOG_INFO ("Successfully synced function rename with RevEngAI: '%s' (ID: %llu)", fcn->name, fn_id);
-        return 0;
-    } else {
-        LOG_ERROR ("Failed to sync function rename with RevEngAI for function '%s' (ID: %llu)", fcn->name, fn_id);
+    BinaryId binary_id = GetBinaryIdFromCore (core);
+    if (!binary_id) {
+        LOG_INFO ("No RevEngAI analysis applied, skipping function rename sync");
         return 1;
     }
 
-    StrDeinit (&new_name);
+    // Network requests happen in background, don't block the shell on every rename.
+    // Analysis status and function ID are resolved by the queue worker.
+    RenameQueuePush (binary_id, fcn->addr - rzGetCurrentBinaryBaseAddr (core), newname);
 
     return 0;
 }
@@ -138,7 +128,7 @@ RZ_IPI bool rz_plugin_init (RzCore *core) {
     }
 
     // Install our hook
-    if (core->analysis) {
+    if (core->analysis && RenameQueueInit()) {
         core->analysis->cb.on_fcn_rename = (RzAnalysisFunctionRenameCallback)reai_on_fcn_rename;
         LOG_INFO ("RevEngAI function rename hook installed");
     } else {
@@ -155,6 +145,13 @@ RZ_IPI bool rz_plugin_fini (RzCore *core) {
         return false;
     }
 
+    // Don't lose renames made just before exit
+    if (core->analysis) {
+        core->analysis->cb.on_fcn_rename = NULL;
+    }
+    RenameQueueDeinit();
+    PluginShutdown();
+
     RzCmd     *rcmd          = core->rcmd;
     RzCmdDesc *reai_cmd_desc = rz_cmd_get_desc (rcmd, "RE");
     return rz_cmd_desc_remove (rcmd, reai_cmd_desc);
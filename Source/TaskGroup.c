@@ -0,0 +1,265 @@
+/**
+ * @file : TaskGroup.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+/* rizin */
+#include <rz_th.h>
+#include <rz_types.h>
+
+/* revengai */
+#include <Reai/Log.h>
+
+/* local includes */
+#include <TaskGroup.h>
+#include <Util.h>
+
+typedef struct Task {
+    TaskFn fn;
+    void  *user;
+    void  *result;
+    bool   collected;
+} Task;
+
+struct TaskGroup {
+    RzThreadLock *lock;
+    RzThreadCond *completed; // signalled every time a task completes
+    RzThreadCond *work;      // signalled on new task, and when group is freed
+    Task         *tasks;
+    u64           count;
+    u64           capacity;
+    u64           next;       // next task to be started by a worker
+    u64          *done;       // task indices in completion order, same capacity as tasks
+    u64           done_count;
+    u64           collected;
+    RzThread    **workers;
+    u32           worker_count;
+    u32           idle_workers; // workers not running a task
+    u32           max_workers;
+    bool          started;
+    bool          stopping;
+};
+
+// Workers live as long as group does, and wait for more tasks once all are started
+static void *taskGroupWorker (void *user) {
+    TaskGroup *g = user;
+
+    rz_th_lock_enter (g->lock);
+    while (true) {
+        if (g->next == g->count) {
+            if (g->stopping) {
+                break;
+            }
+            rz_th_cond_wait (g->work, g->lock);
+            continue;
+        }
+
+        // Tasks array may be reallocated by a submit, take task out while lock is held
+        u64    idx     = g->next++;
+        TaskFn fn      = g->tasks[idx].fn;
+        void  *fn_user = g->tasks[idx].user;
+        g->idle_workers--;
+        rz_th_lock_leave (g->lock);
+
+        void *result = fn (fn_user);
+
+        rz_th_lock_enter (g->lock);
+        g->tasks[idx].result     = result;
+        g->done[g->done_count++] = idx;
+        g->idle_workers++;
+        rz_th_cond_signal_all (g->completed);
+    }
+    rz_th_lock_leave (g->lock);
+
+    return NULL;
+}
+
+// Start more workers while there are more waiting tasks than idle workers. Lock must be held.
+static void taskGroupAddWorkers (TaskGroup *g) {
+    while (g->workers && g->worker_count < g->max_workers && g->count - g->next > g->idle_workers) {
+        RzThread *th = rz_th_new (taskGroupWorker, g);
+        if (!th) {
+            LOG_ERROR ("Failed to create worker thread, continuing with %u threads", g->worker_count);
+            break;
+        }
+        g->workers[g->worker_count++] = th;
+        g->idle_workers++;
+    }
+}
+
+static void taskGroupStart (TaskGroup *g) {
+    g->started = true;
+
+    g->workers = calloc (g->max_workers, sizeof (RzThread *));
+    if (!g->workers) {
+        LOG_ERROR ("Failed to allocate memory for worker threads, running tasks serially");
+        return;
+    }
+
+    rz_th_lock_enter (g->lock);
+    taskGroupAddWorkers (g);
+    rz_th_lock_leave (g->lock);
+}
+
+TaskGroup *TaskGroupNew (u32 max_workers) {
+    TaskGroup *g = calloc (1, sizeof (TaskGroup));
+    if (!g) {
+        LOG_ERROR ("Failed to allocate memory for task group");
+        return NULL;
+    }
+
+    RzThreadCond **conds[] = {&g->completed, &g->work};
+    if (!ThreadSyncNew (&g->lock, conds, 2)) {
+        LOG_ERROR ("Failed to create task group synchronization primitives");
+        TaskGroupFree (g, NULL);
+        return NULL;
+    }
+
+    g->max_workers = max_workers ? max_workers : 1;
+    return g;
+}
+
+bool TaskGroupSubmit (TaskGroup *group, TaskFn fn, void *user) {
+    if (!group || !fn) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    // Workers read tasks and write completion order while running, so grow both under lock
+    rz_th_lock_enter (group->lock);
+    if (group->count == group->capacity) {
+        u64   capacity = group->capacity ? group->capacity * 2 : 16;
+        Task *tasks    = realloc (group->tasks, capacity * sizeof (Task));
+        if (tasks) {
+            group->tasks = tasks;
+        }
+        u64 *done = tasks ? realloc (group->done, capacity * sizeof (u64)) : NULL;
+        if (done) {
+            group->done = done;
+        }
+        if (!tasks || !done) {
+            rz_th_lock_leave (group->lock);
+            LOG_ERROR ("Failed to allocate memory for task");
+            return false;
+        }
+        group->capacity = capacity;
+    }
+
+    group->tasks[group->count++] = (Task) {.fn = fn, .user = user};
+    if (group->started) {
+        taskGroupAddWorkers (group);
+        rz_th_cond_signal (group->work);
+    }
+    rz_th_lock_leave (group->lock);
+
+    return true;
+}
+
+static bool taskGroupNext (TaskGroup *group, u64 *task, void **result, bool wait) {
+    if (!group || !task || !result) {
+        LOG_FATAL ("Invalid arguments");
+    }
+
+    if (!group->started) {
+        taskGroupStart (group);
+    }
+
+    if (group->collected == group->count) {
+        return false;
+    }
+
+    u64 idx = 0;
+    if (!group->worker_count) {
+        // Serial fallback, run next task in submission order right here
+        idx                              = group->next++;
+        group->tasks[idx].result         = group->tasks[idx].fn (group->tasks[idx].user);
+        group->done[group->done_count++] = idx;
+    } else {
+        rz_th_lock_enter (group->lock);
+        while (wait && group->collected == group->done_count) {
+            rz_th_cond_wait (group->completed, group->lock);
+        }
+        bool is_done = group->collected < group->done_count;
+        idx          = is_done ? group->done[group->collected] : 0;
+        rz_th_lock_leave (group->lock);
+
+        if (!is_done) {
+            return false;
+        }
+    }
+
+    group->collected++;
+    group->tasks[idx].collected = true;
+
+    *task   = idx;
+    *result = group->tasks[idx].result;
+    return true;
+}
+
+bool TaskGroupWaitNext (TaskGroup *group, u64 *task, void **result) {
+    return taskGroupNext (group, task, result, true);
+}
+
+bool TaskGroupTryNext (TaskGroup *group, u64 *task, void **result) {
+    return taskGroupNext (group, task, result, false);
+}
+
+u64 TaskGroupTaskCount (TaskGroup *group) {
+    return group ? group->count : 0;
+}
+
+u64 TaskGroupCollectedCount (TaskGroup *group) {
+    return group ? group->collected : 0;
+}
+
+void TaskGroupFree (TaskGroup *group, void (*free_result) (void *result)) {
+    if (!group) {
+        return;
+    }
+
+    if (group->worker_count) {
+        // Tasks not started yet are dropped, running ones are waited for
+        rz_th_lock_enter (group->lock);
+        group->count    = group->next;
+        group->stopping = true;
+        rz_th_cond_signal_all (group->work);
+        rz_th_lock_leave (group->lock);
+
+        for (u32 i = 0; i < group->worker_count; i++) {
+            rz_th_wait (group->workers[i]);
+            rz_th_free (group->workers[i]);
+        }
+    } else {
+        group->count = group->next;
+    }
+
+    if (free_result) {
+        for (u64 i = 0; i < group->count; i++) {
+            if (!group->tasks[i].collected && group->tasks[i].result) {
+                free_result (group->tasks[i].result);
+            }
+        }
+    }
+
+    free (group->workers);
+    free (group->done);
+    free (group->tasks);
+
+    if (group->work) {
+        rz_th_cond_free (group->work);
+    }
+    if (group->completed) {
+        rz_th_cond_free (group->completed);
+    }
+    if (group->lock) {
+        rz_th_lock_free (group->lock);
+    }
+
+    memset (group, 0, sizeof (TaskGroup));
+    free (group);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file : TaskGroup.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Run a group of independent blocking tasks (usually RevEngAI requests) over a
+ * bounded number of worker threads, and collect their results in completion order.
+ * Worker threads live as long as group does, so a long-lived group can be fed
+ * one round of tasks after another without creating new threads each time.
+ * Submitting thread keeps ownership of the group, and is the only thread that
+ * may call any of these functions.
+ * */
+
+#ifndef REAI_PLUGIN_TASK_GROUP
+#define REAI_PLUGIN_TASK_GROUP
+
+/* revenai */
+#include <Reai/Types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// A task run by worker thread. Returned value is handed back to submitter by
+    /// `TaskGroupWaitNext`. Task must not touch Rizin state, only it's own `user` data.
+    ///
+    typedef void* (*TaskFn) (void* user);
+
+    typedef struct TaskGroup TaskGroup;
+
+    ///
+    /// Create an empty task group.
+    ///
+    /// max_workers[in] : Maximum number of tasks running at once. Zero is treated as one.
+    ///
+    /// SUCCESS : New task group, free with `TaskGroupFree`.
+    /// FAILURE : `NULL` with log messages.
+    ///
+    TaskGroup* TaskGroupNew (u32 max_workers);
+
+    ///
+    /// Add a task to group. Tasks can be submitted at any time, also after results of earlier
+    /// ones are collected. Once group is started, an idle worker picks it up right away, and
+    /// a new worker is started if all are busy and `max_workers` isn't reached yet.
+    /// Task index is it's submission order, starting at zero.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false` with log messages, task won't be run.
+    ///
+    bool TaskGroupSubmit (TaskGroup* group, TaskFn fn, void* user);
+
+    ///
+    /// Wait for next task to complete. First call starts worker threads. If no thread can be
+    /// created, tasks are run one by one on calling thread instead.
+    ///
+    /// task[out]   : Index of completed task.
+    /// result[out] : Value returned by completed task.
+    ///
+    /// SUCCESS : `true` when a completed task was returned.
+    /// FAILURE : `false` once results of all tasks submitted so far are collected.
+    ///
+    bool TaskGroupWaitNext (TaskGroup* group, u64* task, void** result);
+
+    ///
+    /// Same as `TaskGroupWaitNext`, but returns right away if no task has completed yet.
+    /// In serial fallback there is nothing running in background, so next task is run here.
+    ///
+    /// SUCCESS : `true` when a completed task was returned.
+    /// FAILURE : `false` if no task has completed since last call, or all results are collected.
+    ///
+    bool TaskGroupTryNext (TaskGroup* group, u64* task, void** result);
+
+    ///
+    /// Number of submitted tasks, and number of tasks whose results are collected.
+    ///
+    u64 TaskGroupTaskCount (TaskGroup* group);
+    u64 TaskGroupCollectedCount (TaskGroup* group);
+
+    ///
+    /// Stop starting new tasks, wait for running ones and free group.
+    /// Results that were never collected are passed to `free_result` (if not `NULL`).
+    ///
+    void TaskGroupFree (TaskGroup* group, void (*free_result) (void* result));
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_TASK_GROUP
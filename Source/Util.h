@@ -0,0 +1,81 @@
+/**
+ * @file : Util.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Small header only helpers, shared by modules that otherwise don't depend on each other.
+ * */
+
+#ifndef REAI_PLUGIN_UTIL
+#define REAI_PLUGIN_UTIL
+
+/* rizin */
+#include <rz_th.h>
+
+/* revenai */
+#include <Reai/Log.h>
+#include <Reai/Types.h>
+
+// Start value of `HashFnv1a`
+#define HASH_FNV1A_SEED  0xcbf29ce484222325ULL
+#define HASH_FNV1A_PRIME 0x100000001b3ULL
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    ///
+    /// FNV-1a hash of `length` bytes, continuing from `hash`. Start with `HASH_FNV1A_SEED`.
+    ///
+    static inline u64 HashFnv1a (u64 hash, const void* data, u64 length) {
+        const u8* p = (const u8*)data;
+        for (u64 i = 0; i < length; i++) {
+            hash ^= p[i];
+            hash *= HASH_FNV1A_PRIME;
+        }
+        return hash;
+    }
+
+    ///
+    /// Create a lock together with condition variables used with it. Either all of them are
+    /// created, or none is.
+    ///
+    /// lock[out]  : New lock.
+    /// conds[out] : Where to store new condition variables.
+    /// count[in]  : Number of entries in `conds`.
+    ///
+    /// SUCCESS : `true`
+    /// FAILURE : `false`, and `lock` and every condition variable are set to `NULL`.
+    ///
+    static inline bool ThreadSyncNew (RzThreadLock** lock, RzThreadCond** conds[], u32 count) {
+        if (!lock || (count && !conds)) {
+            LOG_FATAL ("Invalid arguments");
+        }
+
+        bool ok = !!(*lock = rz_th_lock_new (false));
+        for (u32 i = 0; i < count; i++) {
+            ok = !!(*conds[i] = rz_th_cond_new()) && ok;
+        }
+        if (ok) {
+            return true;
+        }
+
+        if (*lock) {
+            rz_th_lock_free (*lock);
+            *lock = NULL;
+        }
+        for (u32 i = 0; i < count; i++) {
+            if (*conds[i]) {
+                rz_th_cond_free (*conds[i]);
+                *conds[i] = NULL;
+            }
+        }
+        return false;
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // REAI_PLUGIN_UTIL
@@ -0,0 +1,279 @@
+/**
+ * @file : ArchiveTest.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Archive round trip, and bounds checks of header and index against corrupted archives.
+ * Archives are created in working directory, and removed once test is done.
+ * */
+
+/* libc */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* revengai */
+#include <Reai/Log.h>
+
+/* local includes */
+#include <Archive.h>
+#include <Cache.h>
+#include "Check.h"
+
+#define ARCHIVE_PATH   "ArchiveTest.archive"
+#define CORRUPT_PATH   "ArchiveTest.corrupt.archive"
+#define TEST_BINARY_ID 7
+#define TEST_FN_ID     100
+
+// Same layout as in Archive.c
+#define HEADER_SIZE      (6 * sizeof (u64))
+#define INDEX_ENTRY_SIZE (6 * sizeof (u64))
+#define HEADER_MAGIC     0
+#define HEADER_VERSION   8
+#define HEADER_COUNT     24
+#define HEADER_INDEX     32
+#define ENTRY_OFFSET     24
+#define ENTRY_PACKED     32
+#define ENTRY_LENGTH     40
+
+static bool addStr (ArchiveWriter *w, CacheKind kind, u64 id, const char *params, const char *text) {
+    Str         s   = StrInitFromZstr (text);
+    CacheBuffer buf = {0};
+    CacheBufferWriteStr (&buf, &s);
+    bool ok = ArchiveWriterAdd (w, kind, id, params, &buf);
+    CacheBufferDeinit (&buf);
+    StrDeinit (&s);
+    return ok;
+}
+
+// Long repetitive decompilation, so that it's stored compressed
+static char *largeText (void) {
+    const char *line = "    result = result * 31 + data[i];\n";
+    size        n    = strlen (line);
+    char       *text = malloc (n * 200 + 1);
+    for (size i = 0; text && i < 200; i++) {
+        memcpy (text + i * n, line, n);
+    }
+    if (text) {
+        text[n * 200] = 0;
+    }
+    return text;
+}
+
+static bool writeArchive (void) {
+    char          *large = largeText();
+    ArchiveWriter *w     = ArchiveWriterOpen (ARCHIVE_PATH, TEST_BINARY_ID);
+    if (!large || !w) {
+        free (large);
+        return false;
+    }
+
+    bool ok = addStr (w, CACHE_KIND_DECOMPILATION, TEST_FN_ID, NULL, large);
+    ok      = ok && addStr (w, CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, NULL, "push rbp\nret\n");
+    ok      = ok && addStr (w, CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, "compact", "ret\n");
+    CHECK (ArchiveWriterCount (w) == 3);
+
+    // Same key again makes archive uncommittable, so it's tried on a throwaway writer
+    ArchiveWriter *dup = ArchiveWriterOpen (CORRUPT_PATH, TEST_BINARY_ID);
+    if (dup) {
+        addStr (dup, CACHE_KIND_DECOMPILATION, TEST_FN_ID, NULL, "a");
+        addStr (dup, CACHE_KIND_DECOMPILATION, TEST_FN_ID, NULL, "b");
+        CHECK (!ArchiveWriterClose (dup, true));
+    }
+
+    free (large);
+    return ArchiveWriterClose (w, ok) && ok;
+}
+
+static u8 *readFile (const char *path, u64 *length) {
+    FILE *f = fopen (path, "rb");
+    if (!f) {
+        return NULL;
+    }
+    fseek (f, 0, SEEK_END);
+    long end = ftell (f);
+    fseek (f, 0, SEEK_SET);
+
+    u8 *data = end > 0 ? malloc (end) : NULL;
+    if (data && fread (data, 1, end, f) != (size_t)end) {
+        free (data);
+        data = NULL;
+    }
+    fclose (f);
+    *length = data ? (u64)end : 0;
+    return data;
+}
+
+static bool writeFile (const char *path, const u8 *data, u64 length) {
+    FILE *f = fopen (path, "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = fwrite (data, 1, length, f) == length;
+    return !fclose (f) && ok;
+}
+
+static u64 getU64 (const u8 *data, u64 offset) {
+    u64 value = 0;
+    memcpy (&value, data + offset, sizeof (value));
+    return value;
+}
+
+static void setU64 (u8 *data, u64 offset, u64 value) {
+    memcpy (data + offset, &value, sizeof (value));
+}
+
+static bool getStr (CacheKind kind, u64 id, const char *params, const char *expected) {
+    CacheBuffer buf = {0};
+    if (!ArchiveGet (kind, id, params, &buf)) {
+        return false;
+    }
+
+    Str  s  = CacheBufferReadStr (&buf);
+    bool ok = !buf.failed && s.length == strlen (expected) && !memcmp (s.data, expected, s.length);
+    StrDeinit (&s);
+    CacheBufferDeinit (&buf);
+    return ok;
+}
+
+static void testRoundTrip (void) {
+    char *large = largeText();
+    CHECK (ArchiveMount (ARCHIVE_PATH));
+
+    u64 count = 0;
+    CHECK (ArchiveGetBinaryId (&count) == TEST_BINARY_ID);
+    CHECK (count == 3);
+
+    CHECK (large && getStr (CACHE_KIND_DECOMPILATION, TEST_FN_ID, NULL, large));
+    CHECK (getStr (CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, NULL, "push rbp\nret\n"));
+    CHECK (getStr (CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, "compact", "ret\n"));
+
+    // Misses
+    CacheBuffer buf = {0};
+    CHECK (!ArchiveGet (CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, "other", &buf));
+    CHECK (!ArchiveGet (CACHE_KIND_DECOMPILATION, TEST_FN_ID + 1, NULL, &buf));
+    CHECK (!ArchiveGet (CACHE_KIND_ANNOTATED_DECOMPILATION, TEST_FN_ID, NULL, &buf));
+
+    ArchiveUnmount();
+    CHECK (!ArchiveGetBinaryId (NULL));
+    free (large);
+}
+
+// Mount a copy of archive, cut to `new_length` and with u64 at `offset` set to `value`, and check it's refused
+static void checkHeaderRejected (const u8 *data, u64 length, u64 offset, u64 value, u64 new_length) {
+    u8 *copy = malloc (length);
+    if (!copy) {
+        CHECK (false);
+        return;
+    }
+    memcpy (copy, data, length);
+    if (offset + sizeof (u64) <= new_length) {
+        setU64 (copy, offset, value);
+    }
+
+    CHECK (writeFile (CORRUPT_PATH, copy, new_length));
+    CHECK (!ArchiveMount (CORRUPT_PATH));
+
+    // Archive mounted before stays mounted
+    CHECK (ArchiveGetBinaryId (NULL) == TEST_BINARY_ID);
+    free (copy);
+}
+
+static void testHeaderBounds (void) {
+    u64 length = 0;
+    u8 *data   = readFile (ARCHIVE_PATH, &length);
+    CHECK (data && length > HEADER_SIZE);
+    if (!data) {
+        return;
+    }
+
+    CHECK (ArchiveMount (ARCHIVE_PATH));
+    u64 index_offset = getU64 (data, HEADER_INDEX);
+    u64 count        = getU64 (data, HEADER_COUNT);
+    u64 max_count    = (length - index_offset) / INDEX_ENTRY_SIZE;
+    CHECK (count == 3 && max_count == count);
+
+    checkHeaderRejected (data, length, HEADER_MAGIC, 0, length);
+    checkHeaderRejected (data, length, HEADER_VERSION, 0, length);
+    checkHeaderRejected (data, length, HEADER_INDEX, 0, length);
+    checkHeaderRejected (data, length, HEADER_INDEX, HEADER_SIZE - 1, length);
+    checkHeaderRejected (data, length, HEADER_INDEX, length + 1, length);
+    checkHeaderRejected (data, length, HEADER_INDEX, UINT64_MAX, length);
+    checkHeaderRejected (data, length, HEADER_COUNT, max_count + 1, length);
+    checkHeaderRejected (data, length, HEADER_COUNT, UINT64_MAX, length);
+    checkHeaderRejected (data, length, HEADER_COUNT, UINT64_MAX / INDEX_ENTRY_SIZE + 1, length);
+
+    // Truncated in index, and shorter than header
+    checkHeaderRejected (data, length, 0, getU64 (data, 0), length - 1);
+    checkHeaderRejected (data, length, 0, getU64 (data, 0), HEADER_SIZE - 1);
+
+    ArchiveUnmount();
+    free (data);
+}
+
+// Mount a copy of archive with one field of every index entry changed, and check no entry is served
+static void checkEntriesRejected (const u8 *data, u64 length, u64 field, u64 value) {
+    u8 *copy = malloc (length);
+    if (!copy) {
+        CHECK (false);
+        return;
+    }
+    memcpy (copy, data, length);
+
+    u64 index_offset = getU64 (copy, HEADER_INDEX);
+    u64 count        = getU64 (copy, HEADER_COUNT);
+    for (u64 i = 0; i < count; i++) {
+        setU64 (copy, index_offset + i * INDEX_ENTRY_SIZE + field, value);
+    }
+
+    CHECK (writeFile (CORRUPT_PATH, copy, length));
+    CHECK (ArchiveMount (CORRUPT_PATH));
+
+    CacheBuffer buf = {0};
+    CHECK (!ArchiveGet (CACHE_KIND_DECOMPILATION, TEST_FN_ID, NULL, &buf));
+    CHECK (!ArchiveGet (CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, NULL, &buf));
+    CHECK (!ArchiveGet (CACHE_KIND_LINEAR_DISASM, TEST_FN_ID, "compact", &buf));
+
+    ArchiveUnmount();
+    free (copy);
+}
+
+static void testEntryBounds (void) {
+    u64 length = 0;
+    u8 *data   = readFile (ARCHIVE_PATH, &length);
+    CHECK (data != NULL);
+    if (!data) {
+        return;
+    }
+
+    u64 index_offset = getU64 (data, HEADER_INDEX);
+
+    // Entry data must lie between header and index
+    checkEntriesRejected (data, length, ENTRY_OFFSET, index_offset + 1);
+    checkEntriesRejected (data, length, ENTRY_OFFSET, UINT64_MAX);
+    checkEntriesRejected (data, length, ENTRY_PACKED, index_offset);
+    checkEntriesRejected (data, length, ENTRY_PACKED, UINT64_MAX);
+
+    // Sizes that don't fit in an int are refused before decompression
+    checkEntriesRejected (data, length, ENTRY_LENGTH, (u64)INT32_MAX + 1);
+    checkEntriesRejected (data, length, ENTRY_LENGTH, UINT64_MAX);
+
+    free (data);
+}
+
+int main (void) {
+    LogInit (false);
+    ArchiveInit();
+
+    CHECK (writeArchive());
+    testRoundTrip();
+    testHeaderBounds();
+    testEntryBounds();
+
+    ArchiveUnmount();
+    remove (ARCHIVE_PATH);
+    remove (CORRUPT_PATH);
+    return CHECK_RESULT();
+}
@@ -0,0 +1,258 @@
+/**
+ * @file : AsmDiffTest.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <stdlib.h>
+#include <string.h>
+
+// Included to reach static functions
+#include <AsmDiff.c>
+
+#include "Check.h"
+
+#define LCS_TEST_MAX 64
+
+// Longest common subsequence length by plain dynamic programming, to check against
+static i64 referenceLcs (const u32 *a, i64 n, const u32 *b, i64 m) {
+    static i64 table[LCS_TEST_MAX + 1][LCS_TEST_MAX + 1];
+    for (i64 i = 0; i <= n; i++) {
+        for (i64 j = 0; j <= m; j++) {
+            if (!i || !j) {
+                table[i][j] = 0;
+            } else if (a[i - 1] == b[j - 1]) {
+                table[i][j] = table[i - 1][j - 1] + 1;
+            } else {
+                table[i][j] = table[i - 1][j] > table[i][j - 1] ? table[i - 1][j] : table[i][j - 1];
+            }
+        }
+    }
+    return table[n][m];
+}
+
+// Run `lcsMark` and check that marked lines form a common subsequence of longest length
+static void checkLcs (const u32 *a, i64 n, const u32 *b, i64 m) {
+    bool keep_a[LCS_TEST_MAX + 1] = {0};
+    bool keep_b[LCS_TEST_MAX + 1] = {0};
+    i64  v[2 * LCS_TEST_MAX + 2];
+    i64  w[2 * LCS_TEST_MAX + 2];
+
+    LcsContext ctx = {.a = a, .b = b, .keep_a = keep_a, .keep_b = keep_b, .v1 = v, .v2 = w};
+    lcsMark (&ctx, 0, n, 0, m);
+
+    i64  i = 0, j = 0, kept = 0;
+    bool is_common = true;
+    while (true) {
+        while (i < n && !keep_a[i]) {
+            i++;
+        }
+        while (j < m && !keep_b[j]) {
+            j++;
+        }
+        if (i == n || j == m) {
+            break;
+        }
+        is_common = is_common && a[i] == b[j];
+        kept++;
+        i++;
+        j++;
+    }
+
+    // Both sides must run out of marked lines together
+    while (i < n) {
+        is_common = is_common && !keep_a[i++];
+    }
+    while (j < m) {
+        is_common = is_common && !keep_b[j++];
+    }
+
+    CHECK (is_common);
+    CHECK (kept == referenceLcs (a, n, b, m));
+}
+
+static void checkBisectSplit (const u32 *a, i64 n, const u32 *b, i64 m) {
+    i64 v[2 * LCS_TEST_MAX + 2];
+    i64 w[2 * LCS_TEST_MAX + 2];
+
+    LcsContext ctx = {.a = a, .b = b, .v1 = v, .v2 = w};
+    i64        x = -1, y = -1;
+    if (lcsBisect (&ctx, a, n, b, m, &x, &y)) {
+        CHECK (x >= 0 && x <= n);
+        CHECK (y >= 0 && y <= m);
+    }
+}
+
+#define ARRAY_LEN(a) ((i64)(sizeof (a) / sizeof ((a)[0])))
+
+static void testLcsEmptySide (void) {
+    u32 a[] = {1, 2, 3};
+    checkLcs (a, 0, a, 0);
+    checkLcs (a, ARRAY_LEN (a), a, 0);
+    checkLcs (a, 0, a, ARRAY_LEN (a));
+}
+
+static void testLcsDisjoint (void) {
+    u32 a[] = {1, 2, 3, 4};
+    u32 b[] = {5, 6, 7};
+    checkLcs (a, ARRAY_LEN (a), b, ARRAY_LEN (b));
+    checkLcs (b, ARRAY_LEN (b), a, ARRAY_LEN (a));
+    checkBisectSplit (a, ARRAY_LEN (a), b, ARRAY_LEN (b));
+}
+
+static void testLcsPrefixSuffixOnly (void) {
+    u32 prefix_a[] = {1, 2, 3, 4};
+    u32 prefix_b[] = {1, 2, 7, 8, 9};
+    checkLcs (prefix_a, ARRAY_LEN (prefix_a), prefix_b, ARRAY_LEN (prefix_b));
+
+    u32 suffix_a[] = {5, 6, 3, 4};
+    u32 suffix_b[] = {7, 3, 4};
+    checkLcs (suffix_a, ARRAY_LEN (suffix_a), suffix_b, ARRAY_LEN (suffix_b));
+
+    u32 both_a[] = {1, 2, 5, 6, 3};
+    u32 both_b[] = {1, 2, 7, 3};
+    checkLcs (both_a, ARRAY_LEN (both_a), both_b, ARRAY_LEN (both_b));
+}
+
+static void testLcsDeltaParity (void) {
+    // Forward and reverse paths meet in forward pass on odd delta, in reverse pass on even one
+    u32 odd_a[] = {1, 2, 3, 4, 5};
+    u32 odd_b[] = {2, 4, 6, 1};
+    checkLcs (odd_a, ARRAY_LEN (odd_a), odd_b, ARRAY_LEN (odd_b));
+    checkBisectSplit (odd_a, ARRAY_LEN (odd_a), odd_b, ARRAY_LEN (odd_b));
+
+    u32 even_a[] = {1, 2, 3, 4, 5, 6};
+    u32 even_b[] = {6, 1, 3, 5};
+    checkLcs (even_a, ARRAY_LEN (even_a), even_b, ARRAY_LEN (even_b));
+    checkBisectSplit (even_a, ARRAY_LEN (even_a), even_b, ARRAY_LEN (even_b));
+
+    u32 same_a[] = {1, 2, 3, 4};
+    u32 same_b[] = {4, 3, 2, 1};
+    checkLcs (same_a, ARRAY_LEN (same_a), same_b, ARRAY_LEN (same_b));
+}
+
+static void testLcsRandom (void) {
+    // Small alphabet makes many partial matches, sizes cover both delta parities
+    u32 seed = 12345;
+    u32 a[LCS_TEST_MAX], b[LCS_TEST_MAX];
+    for (u32 round = 0; round < 2000; round++) {
+        i64 n = 0, m = 0;
+        seed  = seed * 1103515245 + 12345;
+        n     = (seed >> 16) % (LCS_TEST_MAX + 1);
+        seed  = seed * 1103515245 + 12345;
+        m     = (seed >> 16) % (LCS_TEST_MAX + 1);
+        for (i64 i = 0; i < n; i++) {
+            seed = seed * 1103515245 + 12345;
+            a[i] = (seed >> 16) % 4;
+        }
+        for (i64 j = 0; j < m; j++) {
+            seed = seed * 1103515245 + 12345;
+            b[j] = (seed >> 16) % 4;
+        }
+        checkLcs (a, n, b, m);
+    }
+}
+
+static void checkNormalized (const char *line, const char *expected) {
+    char out[256] = {0};
+    u32  length   = normalizeLine (line, (u32)strlen (line), out);
+    bool is_equal = length == strlen (expected) && !memcmp (out, expected, length);
+    if (!is_equal) {
+        fprintf (stderr, "normalized '%s' to '%.*s', expected '%s'\n", line, (int)length, out, expected);
+    }
+    CHECK (is_equal);
+}
+
+static void testNormalizeOperands (void) {
+    checkNormalized ("mov eax, 0x10", "mov eax, #");
+    checkNormalized ("  sub   rsp,\t0x20  ", "sub rsp, #");
+    checkNormalized ("mov dword [rbp - 0x14], edi", "mov dword [rbp - #], edi");
+    checkNormalized ("call fcn.00401000", "call fcn.#");
+    checkNormalized ("push rbp", "push rbp");
+    checkNormalized ("", "");
+}
+
+static void testNormalizeLabels (void) {
+    checkNormalized ("jmp loc_401020", "jmp loc_#");
+    checkNormalized ("mov eax, dword [var_10h]", "mov eax, dword [var_#]");
+    checkNormalized ("; Destinations: Block_3(jump)", "; Destinations: Block_#(jump)");
+
+    // Underscored names without a number stay as they are
+    checkNormalized ("call my_func", "call my_func");
+    checkNormalized ("call sub_abc", "call sub_abc");
+    checkNormalized ("call _start", "call _start");
+}
+
+static void testNormalizeBlockHeaders (void) {
+    checkNormalized ("; Block 1 (0x1000-0x1010): entry", "; Block ");
+    checkNormalized ("; Function Overview: does things", "; Function Overview");
+}
+
+static void testSplitCrlf (void) {
+    Str      s     = StrInitFromZstr ("push rbp\r\nret\r\n");
+    AsmLines lines = {0};
+    CHECK (splitLines (&s, &lines));
+    CHECK (lines.count == 2);
+    if (lines.count == 2) {
+        CHECK (lines.lines[0].length == 8 && !memcmp (lines.lines[0].text, "push rbp", 8));
+        CHECK (lines.lines[1].length == 3 && !memcmp (lines.lines[1].text, "ret", 3));
+    }
+    free (lines.lines);
+    StrDeinit (&s);
+}
+
+// Count diff lines of each type
+static void countDiff (const Str *source, const Str *target, u64 counts[DIFF_TYPE_MOV + 1]) {
+    memset (counts, 0, sizeof (u64) * (DIFF_TYPE_MOV + 1));
+    DiffLines diff = AsmDiffCompute (source, target);
+    for (u64 i = 0; i < diff.length; i++) {
+        counts[VecPtrAt (&diff, i)->type]++;
+    }
+    VecDeinit (&diff);
+}
+
+static void testDiff (void) {
+    u64 counts[DIFF_TYPE_MOV + 1];
+
+    // Line endings alone are not a difference
+    Str unix_text = StrInitFromZstr ("push rbp\nmov rbp, rsp\nret\n");
+    Str dos_text  = StrInitFromZstr ("push rbp\r\nmov rbp, rsp\r\nret\r\n");
+    countDiff (&unix_text, &dos_text, counts);
+    CHECK (counts[DIFF_TYPE_SAM] == 3 && counts[DIFF_TYPE_MOD] == 0);
+    CHECK (counts[DIFF_TYPE_ADD] == 0 && counts[DIFF_TYPE_REM] == 0);
+
+    // Empty side
+    Str empty = StrInit();
+    countDiff (&empty, &unix_text, counts);
+    CHECK (counts[DIFF_TYPE_ADD] == 3 && counts[DIFF_TYPE_SAM] == 0 && counts[DIFF_TYPE_REM] == 0);
+    countDiff (&unix_text, &empty, counts);
+    CHECK (counts[DIFF_TYPE_REM] == 3 && counts[DIFF_TYPE_SAM] == 0 && counts[DIFF_TYPE_ADD] == 0);
+
+    // Only operands and labels differ
+    Str source = StrInitFromZstr ("sub rsp, 0x20\njmp loc_401020\nmov eax, dword [var_10h]\nret\n");
+    Str target = StrInitFromZstr ("sub rsp, 0x30\njmp loc_502020\nmov eax, dword [var_18h]\nret\n");
+    countDiff (&source, &target, counts);
+    CHECK (counts[DIFF_TYPE_MOD] == 3 && counts[DIFF_TYPE_SAM] == 1);
+    CHECK (counts[DIFF_TYPE_ADD] == 0 && counts[DIFF_TYPE_REM] == 0);
+
+    StrDeinit (&unix_text);
+    StrDeinit (&dos_text);
+    StrDeinit (&source);
+    StrDeinit (&target);
+}
+
+int main (void) {
+    testLcsEmptySide();
+    testLcsDisjoint();
+    testLcsPrefixSuffixOnly();
+    testLcsDeltaParity();
+    testLcsRandom();
+    testNormalizeOperands();
+    testNormalizeLabels();
+    testNormalizeBlockHeaders();
+    testSplitCrlf();
+    testDiff();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,29 @@
+/**
+ * @file : Check.h
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ *
+ * @b Minimal checks for unit tests. A failed check is reported and counted, and test
+ * goes on, so one run shows every failure. Each test's `main` returns `CHECK_RESULT()`.
+ * */
+
+#ifndef REAI_TESTS_CHECK
+#define REAI_TESTS_CHECK
+
+/* libc */
+#include <stdio.h>
+
+static int check_failures = 0;
+
+#define CHECK(cond)                                                                                                    \
+    do {                                                                                                               \
+        if (!(cond)) {                                                                                                 \
+            fprintf (stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);                                  \
+            check_failures++;                                                                                          \
+        }                                                                                                              \
+    } while (0)
+
+#define CHECK_RESULT() (check_failures ? (fprintf (stderr, "%d checks failed\n", check_failures), 1) : 0)
+
+#endif // REAI_TESTS_CHECK
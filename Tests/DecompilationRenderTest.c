@@ -0,0 +1,113 @@
+/**
+ * @file : DecompilationRenderTest.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* libc */
+#include <string.h>
+
+// Included to reach static functions
+#include <DecompilationRender.c>
+
+#include "Check.h"
+
+// Parse placeholder at start of `text`, with all of `text` available
+static bool parse (const char *text, PlaceholderKind *kind, u64 *index, u64 *length) {
+    *kind   = PLACEHOLDER_KIND_MAX;
+    *index  = 0;
+    *length = 0;
+    return parsePlaceholder (text, strlen (text), kind, index, length);
+}
+
+static void checkParsed (const char *text, PlaceholderKind kind, u64 index, u64 length) {
+    PlaceholderKind k = 0;
+    u64             i = 0, l = 0;
+    bool            ok = parse (text, &k, &i, &l);
+    if (!ok || k != kind || i != index || l != length) {
+        fprintf (stderr, "'%s' parsed as %d (kind %d, index %llu, length %llu)\n", text, ok, k, i, l);
+    }
+    CHECK (ok && k == kind && i == index && l == length);
+}
+
+static void checkRejected (const char *text) {
+    PlaceholderKind k = 0;
+    u64             i = 0, l = 0;
+    if (parse (text, &k, &i, &l)) {
+        fprintf (stderr, "'%s' should not be a placeholder\n", text);
+        CHECK (false);
+    }
+}
+
+static void testEveryKind (void) {
+    checkParsed ("<DISASM_FUNCTION_0>", PLACEHOLDER_DISASM_FUNCTION, 0, 19);
+    checkParsed ("<DISASM_STRING_12>", PLACEHOLDER_DISASM_STRING, 12, 18);
+    checkParsed ("<UNMATCHED_FUNCTION_3>", PLACEHOLDER_UNMATCHED_FUNCTION, 3, 22);
+    checkParsed ("<UNMATCHED_STRING_7>", PLACEHOLDER_UNMATCHED_STRING, 7, 20);
+    checkParsed ("<VAR_42>", PLACEHOLDER_VAR, 42, 8);
+    checkParsed ("<EXTERNAL_VARIABLE_5>", PLACEHOLDER_EXTERNAL_VARIABLE, 5, 21);
+    checkParsed ("<CUSTOM_TYPE_1>", PLACEHOLDER_CUSTOM_TYPE, 1, 15);
+}
+
+static void testTrailingText (void) {
+    // Only placeholder itself is consumed
+    checkParsed ("<VAR_1> = <VAR_2>;", PLACEHOLDER_VAR, 1, 7);
+    checkParsed ("<DISASM_FUNCTION_10>(x);", PLACEHOLDER_DISASM_FUNCTION, 10, 20);
+}
+
+static void testRejected (void) {
+    checkRejected ("<VAR_>");
+    checkRejected ("<VAR1>");
+    checkRejected ("<VAR>");
+    checkRejected ("<_1>");
+    checkRejected ("<FOO_1>");
+    checkRejected ("<var_1>");
+    checkRejected ("<VAR_1a>");
+    checkRejected ("<VAR_1");
+    checkRejected ("< b && c > d");
+    checkRejected ("<<VAR_1>");
+    checkRejected ("<>");
+    checkRejected ("<");
+
+    // Index wider than 18 digits could overflow
+    checkRejected ("<VAR_1234567890123456789>");
+    checkParsed ("<VAR_123456789012345678>", PLACEHOLDER_VAR, 123456789012345678ULL, 24);
+}
+
+static void testAvailableBytes (void) {
+    PlaceholderKind k = 0;
+    u64             i = 0, l = 0;
+
+    // Closing bracket past end of template is not looked at
+    const char *text = "<VAR_1>";
+    CHECK (!parsePlaceholder (text, 6, &k, &i, &l));
+    CHECK (parsePlaceholder (text, 7, &k, &i, &l) && l == 7);
+    CHECK (!parsePlaceholder (text, 1, &k, &i, &l));
+}
+
+static void testRenderOutOfRange (void) {
+    // No symbols, so every placeholder is out of range and is left as it is
+    const char     *tmpl    = "int <DISASM_FUNCTION_0>(int <VAR_1>) {\n    return a < b && c > d;\n}\n";
+    AiDecompilation aidec   = {0};
+    aidec.raw_decompilation = StrInitFromZstr (tmpl);
+
+    Substitutions subs = VecInit();
+    Str           code = RenderAiDecompilation (&aidec, false, &subs);
+    CHECK (code.length == aidec.raw_decompilation.length);
+    CHECK (code.data && !strcmp (code.data, aidec.raw_decompilation.data));
+    CHECK (subs.length == 0);
+
+    StrDeinit (&code);
+    VecDeinit (&subs);
+    StrDeinit (&aidec.raw_decompilation);
+}
+
+int main (void) {
+    testEveryKind();
+    testTrailingText();
+    testRejected();
+    testAvailableBytes();
+    testRenderOutOfRange();
+    return CHECK_RESULT();
+}
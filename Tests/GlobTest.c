@@ -0,0 +1,54 @@
+/**
+ * @file : GlobTest.c
+ * @date : 16th October 2026
+ * @author : agent (agent@local)
+ * @copyright: Copyright (c) 2024 RevEngAI. All Rights Reserved.
+ * */
+
+/* local includes */
+#include <Rizin/Glob.h>
+#include "Check.h"
+
+static void testLiteral (void) {
+    CHECK (GlobMatch ("main", "main"));
+    CHECK (!GlobMatch ("main", "mai"));
+    CHECK (!GlobMatch ("main", "main2"));
+    CHECK (GlobMatch ("", ""));
+    CHECK (!GlobMatch ("", "a"));
+}
+
+static void testQuestionMark (void) {
+    CHECK (GlobMatch ("fcn.0040100?", "fcn.00401000"));
+    CHECK (!GlobMatch ("fcn.0040100?", "fcn.0040100"));
+    CHECK (GlobMatch ("???", "abc"));
+    CHECK (!GlobMatch ("?", ""));
+}
+
+static void testStar (void) {
+    CHECK (GlobMatch ("*", ""));
+    CHECK (GlobMatch ("*", "anything"));
+    CHECK (GlobMatch ("sym.imp.*", "sym.imp.printf"));
+    CHECK (!GlobMatch ("sym.imp.*", "sym.main"));
+    CHECK (GlobMatch ("*_init", "module_init"));
+    CHECK (!GlobMatch ("*_init", "module_init_late"));
+    CHECK (GlobMatch ("**a**", "a"));
+    CHECK (GlobMatch ("a*b*c", "aXbYbZc"));
+    CHECK (!GlobMatch ("a*b*c", "aXcYb"));
+}
+
+static void testBacktracking (void) {
+    // First `*` must give characters back when later parts of glob fail to match
+    CHECK (GlobMatch ("*ab", "aab"));
+    CHECK (GlobMatch ("*aab", "aaab"));
+    CHECK (GlobMatch ("*a?c*", "xabxabcx"));
+    CHECK (!GlobMatch ("*a?c", "xabxabcx"));
+    CHECK (GlobMatch ("fcn.*.part.?", "fcn.main.part.0"));
+}
+
+int main (void) {
+    testLiteral();
+    testQuestionMark();
+    testStar();
+    testBacktracking();
+    return CHECK_RESULT();
+}